@@ -16,19 +16,23 @@ DEFINES += QT_DEPRECATED_WARNINGS
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+# 编译期日志级别（见 src/Log.h）：0关闭 1警告 2信息 3调试 4跟踪，默认Debug为3、Release为1
+#DEFINES += QWEIGHT_LOG_LEVEL=4
+
+# 引擎部分（网格模型、搜索引擎、结果类型）只依赖QtCore
+include(src/engine.pri)
+include(src/data.pri)
+
 SOURCES += \
     src/ArrowGraphicsItem.cpp \
     src/ArrowRenderer.cpp \
     src/AsyncPathCalculator.cpp \
     src/Common.cpp \
-    src/DataManager.cpp \
     src/GridGraphicsView.cpp \
-    src/GridPoint.cpp \
     src/HistoryManager.cpp \
     src/LayoutTestWindow.cpp \
     src/MainWindow.cpp \
     src/PathCalculator.cpp \
-    src/PathResult.cpp \
     src/PathVisualWidget.cpp \
     src/ResultListWidget.cpp \
     src/ControlPanel.cpp \
@@ -39,14 +43,11 @@ HEADERS += \
     src/ArrowRenderer.h \
     src/AsyncPathCalculator.h \
     src/Common.h \
-    src/DataManager.h \
     src/GridGraphicsView.h \
-    src/GridPoint.h \
     src/HistoryManager.h \
     src/LayoutTestWindow.h \
     src/MainWindow.h \
     src/PathCalculator.h \
-    src/PathResult.h \
     src/PathVisualWidget.h \
     src/ResultListWidget.h \
     src/ControlPanel.h
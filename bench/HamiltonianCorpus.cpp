@@ -0,0 +1,409 @@
+#include "HamiltonianCorpus.h"
+#include "HamiltonianMeetInTheMiddle.h"
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QSet>
+#include <cstdio>
+
+namespace {
+// 枚举模式逐条去重的路径数上限，超过时只校验计数模式
+const quint64 MAX_ENUMERATED = 200000;
+// 不剪枝的模式在6x6以上的网格要跑数小时，只校验可通行格子不超过此数的条目
+const int MAX_UNPRUNED_CELLS = 36;
+// 流式连接模式的连接表上限，7x7的条目会分成十来批
+const qint64 STREAMING_MEMORY_LIMIT = 256 * 1024;
+// 随机展开顺序的种子，固定以便复现
+const quint32 RANDOM_ORDER_SEED = 20240601;
+
+HamiltonianCorpus::Entry makeEntry(const QString& name, int width, int height,
+                                   const QPoint& start, const QPoint& end,
+                                   const QVector<QPoint>& obstacles,
+                                   quint64 expected, const QString& source, bool slow = false) {
+    HamiltonianCorpus::Entry entry;
+    entry.name = name;
+    entry.width = width;
+    entry.height = height;
+    entry.start = start;
+    entry.end = end;
+    entry.obstacles = obstacles;
+    entry.endpoints = EndpointMode::Fixed;
+    entry.expected = expected;
+    entry.source = source;
+    entry.slow = slow;
+    return entry;
+}
+
+// 端点自由的条目；FreeBoth时start不参与搜索
+HamiltonianCorpus::Entry makeFreeEntry(const QString& name, int width, int height, EndpointMode endpoints,
+                                       const QPoint& start, const QVector<QPoint>& obstacles,
+                                       quint64 expected, const QString& source) {
+    HamiltonianCorpus::Entry entry = makeEntry(name, width, height, start, QPoint(), obstacles, expected, source);
+    entry.endpoints = endpoints;
+    return entry;
+}
+
+HamiltonianCorpus::Mode makeMode(const QString& name, int pruning, int threads, bool counting,
+                                 bool smallGridKernel = true) {
+    HamiltonianCorpus::Mode mode;
+    mode.name = name;
+    mode.pruning = pruning;
+    mode.threads = threads;
+    mode.counting = counting;
+    mode.smallGridKernel = smallGridKernel;
+    mode.moveOrder = MoveOrder::Natural;
+    mode.pageSize = 0;
+    mode.checkpointStops = false;
+    mode.byEnd = false;
+    mode.meetInTheMiddle = false;
+    mode.memoryLimit = 0;
+    return mode;
+}
+
+HamiltonianCorpus::Mode makeOrderMode(MoveOrder order) {
+    HamiltonianCorpus::Mode mode = makeMode("order-" + moveOrderToString(order),
+                                            HamiltonianPathEngine::PruneAll, 1, false);
+    mode.moveOrder = order;
+    return mode;
+}
+
+HamiltonianCorpus::Mode makePagedMode(const QString& name, int pageSize, bool checkpointStops) {
+    HamiltonianCorpus::Mode mode = makeMode(name, HamiltonianPathEngine::PruneAll, 1, false);
+    mode.pageSize = pageSize;
+    mode.checkpointStops = checkpointStops;
+    return mode;
+}
+
+HamiltonianCorpus::Mode makeByEndMode(const QString& name, int threads) {
+    HamiltonianCorpus::Mode mode = makeMode(name, HamiltonianPathEngine::PruneAll, threads, true);
+    mode.byEnd = true;
+    return mode;
+}
+
+HamiltonianCorpus::Mode makeMeetInTheMiddleMode(const QString& name, bool counting, qint64 memoryLimit) {
+    HamiltonianCorpus::Mode mode = makeMode(name, HamiltonianPathEngine::PruneAll, 1, counting);
+    mode.meetInTheMiddle = true;
+    mode.memoryLimit = memoryLimit;
+    return mode;
+}
+
+QByteArray pathKey(const QVector<QPoint>& path) {
+    return QByteArray(reinterpret_cast<const char*>(path.constData()),
+                      static_cast<int>(path.size() * sizeof(QPoint)));
+}
+
+// 检查一条路径：起终点符合端点约束、相邻格四连通、经过全部可通行格子各一次
+// 起终点都自由时同一条路径只按起点下标小于终点下标的方向产出
+bool validPath(const HamiltonianCorpus::Entry& entry, const GridModel& grid,
+               int walkable, const QVector<QPoint>& path) {
+    if (path.size() != walkable) {
+        return false;
+    }
+    switch (entry.endpoints) {
+        case EndpointMode::Fixed:
+            if (path.first() != entry.start || path.last() != entry.end) {
+                return false;
+            }
+            break;
+        case EndpointMode::FreeEnd:
+            if (path.first() != entry.start) {
+                return false;
+            }
+            break;
+        case EndpointMode::FreeBoth:
+            if (path.size() > 1 && grid.index(path.first()) >= grid.index(path.last())) {
+                return false;
+            }
+            break;
+    }
+    QVector<bool> seen(entry.width * entry.height, false);
+    for (int i = 0; i < path.size(); ++i) {
+        const QPoint& p = path[i];
+        if (!grid.isWalkable(p) || seen[grid.index(p)]) {
+            return false;
+        }
+        seen[grid.index(p)] = true;
+        if (i > 0 && (path[i] - path[i - 1]).manhattanLength() != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+bool HamiltonianCorpus::runsInMode(const Entry& entry, const Mode& mode) {
+    const int walkable = entry.width * entry.height - entry.obstacles.size();
+    if (mode.pruning == HamiltonianPathEngine::PruneNone && walkable > MAX_UNPRUNED_CELLS) {
+        return false;
+    }
+    // 按终点计数从起点搜遍所有终点，端点固定的大条目终点自由时路径过多
+    if (mode.byEnd && (entry.endpoints == EndpointMode::FreeBoth || walkable > MAX_UNPRUNED_CELLS)) {
+        return false;
+    }
+    if (mode.meetInTheMiddle && (entry.endpoints != EndpointMode::Fixed ||
+                                 walkable > HamiltonianMeetInTheMiddle::MAX_CELLS)) {
+        return false;
+    }
+    return mode.counting || entry.expected <= MAX_ENUMERATED;
+}
+
+GridModel HamiltonianCorpus::Entry::buildGrid() const {
+    GridModel grid(width, height);
+    for (const QPoint& p : obstacles) {
+        grid.setType(p.x(), p.y(), PointType::Obstacle);
+    }
+    return grid;
+}
+
+QVector<HamiltonianCorpus::Entry> HamiltonianCorpus::entries(bool includeSlow) {
+    typedef QVector<QPoint> Points;
+    QVector<Entry> all;
+
+    // OEIS A000532：n×n网格从左上角到左下角的哈密顿路径数
+    const quint64 a000532[] = {1, 1, 2, 8, 86, 1770, 88418, 8934966};
+    for (int n = 1; n <= 8; ++n) {
+        all.append(makeEntry(QString("nw-sw-%1x%1").arg(n), n, n, QPoint(0, 0), QPoint(0, n - 1),
+                             Points(), a000532[n - 1], "OEIS A000532", n == 8));
+    }
+
+    // n×n网格对角之间的哈密顿路径数；偶数边长按奇偶性无解
+    all.append(makeEntry("diag-3x3", 3, 3, QPoint(0, 0), QPoint(2, 2), Points(), 2, "OEIS A120443"));
+    all.append(makeEntry("diag-4x4", 4, 4, QPoint(0, 0), QPoint(3, 3), Points(), 0, "奇偶性"));
+    all.append(makeEntry("diag-5x5", 5, 5, QPoint(0, 0), QPoint(4, 4), Points(), 104, "OEIS A120443"));
+    all.append(makeEntry("diag-6x6", 6, 6, QPoint(0, 0), QPoint(5, 5), Points(), 0, "奇偶性"));
+    all.append(makeEntry("diag-7x7", 7, 7, QPoint(0, 0), QPoint(6, 6), Points(), 111712, "OEIS A120443"));
+
+    // 矩形和中心起点，暴力搜索
+    all.append(makeEntry("rect-3x4", 3, 4, QPoint(0, 0), QPoint(2, 3), Points(), 4, "暴力搜索"));
+    all.append(makeEntry("rect-4x5", 4, 5, QPoint(0, 0), QPoint(3, 4), Points(), 20, "暴力搜索"));
+    all.append(makeEntry("rect-5x6", 5, 6, QPoint(0, 0), QPoint(4, 5), Points(), 378, "暴力搜索"));
+    all.append(makeEntry("rect-4x6-side", 4, 6, QPoint(0, 0), QPoint(3, 0), Points(), 55, "暴力搜索"));
+    all.append(makeEntry("rect-5x4-side", 5, 4, QPoint(0, 0), QPoint(4, 0), Points(), 0, "奇偶性"));
+    all.append(makeEntry("center-5x5", 5, 5, QPoint(2, 2), QPoint(0, 0), Points(), 48, "暴力搜索"));
+    all.append(makeEntry("center-7x7", 7, 7, QPoint(3, 3), QPoint(0, 0), Points(), 64324, "引擎(与暴力搜索交叉验证)"));
+
+    // 带障碍
+    all.append(makeEntry("obs-5x5", 5, 5, QPoint(0, 0), QPoint(1, 3),
+                         Points() << QPoint(1, 1) << QPoint(1, 0), 6, "暴力搜索"));
+    all.append(makeEntry("obs-6x5", 6, 5, QPoint(0, 0), QPoint(2, 2),
+                         Points() << QPoint(3, 3) << QPoint(4, 3) << QPoint(2, 1), 16, "暴力搜索"));
+    all.append(makeEntry("obs-6x6-a", 6, 6, QPoint(0, 0), QPoint(1, 3),
+                         Points() << QPoint(3, 1) << QPoint(2, 1) << QPoint(2, 5), 17, "暴力搜索"));
+    all.append(makeEntry("obs-6x6-b", 6, 6, QPoint(0, 0), QPoint(1, 0),
+                         Points() << QPoint(5, 4) << QPoint(0, 2) << QPoint(2, 1) << QPoint(5, 5), 12, "暴力搜索"));
+    all.append(makeEntry("obs-7x5", 7, 5, QPoint(0, 0), QPoint(6, 1),
+                         Points() << QPoint(3, 2) << QPoint(5, 3) << QPoint(1, 3), 6, "暴力搜索"));
+    all.append(makeEntry("obs-7x6", 7, 6, QPoint(0, 0), QPoint(1, 2),
+                         Points() << QPoint(4, 4) << QPoint(3, 4) << QPoint(6, 1) << QPoint(6, 0), 102, "暴力搜索"));
+    all.append(makeEntry("wall-5x5", 5, 5, QPoint(0, 0), QPoint(4, 4),
+                         Points() << QPoint(2, 0) << QPoint(2, 1) << QPoint(2, 2) << QPoint(2, 3) << QPoint(2, 4),
+                         0, "不连通"));
+
+    // 端点自由，暴力搜索；起终点都自由的方形网格为OEIS A096969（无向路径数）
+    const EndpointMode freeEnd = EndpointMode::FreeEnd;
+    const EndpointMode freeBoth = EndpointMode::FreeBoth;
+    all.append(makeFreeEntry("freeend-4x4", 4, 4, freeEnd, QPoint(0, 0), Points(), 52, "暴力搜索"));
+    all.append(makeFreeEntry("freeend-5x5", 5, 5, freeEnd, QPoint(0, 0), Points(), 824, "暴力搜索"));
+    all.append(makeFreeEntry("freeend-5x5-center", 5, 5, freeEnd, QPoint(2, 2), Points(), 456, "暴力搜索"));
+    all.append(makeFreeEntry("freeend-5x5-odd", 5, 5, freeEnd, QPoint(1, 0), Points(), 0, "奇偶性"));
+    all.append(makeFreeEntry("freeend-6x6", 6, 6, freeEnd, QPoint(0, 0), Points(), 22144, "暴力搜索"));
+    all.append(makeFreeEntry("freeend-6x6-inner", 6, 6, freeEnd, QPoint(2, 2), Points(), 12088, "暴力搜索"));
+    all.append(makeFreeEntry("freeend-obs-6x5", 6, 5, freeEnd, QPoint(0, 0),
+                             Points() << QPoint(3, 3) << QPoint(4, 3) << QPoint(2, 1), 144, "暴力搜索"));
+    all.append(makeFreeEntry("freeend-obs-7x5", 7, 5, freeEnd, QPoint(0, 0),
+                             Points() << QPoint(3, 2) << QPoint(5, 3) << QPoint(1, 3), 307, "暴力搜索"));
+    all.append(makeFreeEntry("freeboth-3x3", 3, 3, freeBoth, QPoint(), Points(), 20, "OEIS A096969"));
+    all.append(makeFreeEntry("freeboth-4x4", 4, 4, freeBoth, QPoint(), Points(), 276, "OEIS A096969"));
+    all.append(makeFreeEntry("freeboth-4x5", 4, 5, freeBoth, QPoint(), Points(), 1006, "暴力搜索"));
+    all.append(makeFreeEntry("freeboth-5x5", 5, 5, freeBoth, QPoint(), Points(), 4324, "OEIS A096969"));
+    all.append(makeFreeEntry("freeboth-6x6", 6, 6, freeBoth, QPoint(), Points(), 229348, "OEIS A096969"));
+    all.append(makeFreeEntry("freeboth-obs-5x4", 5, 4, freeBoth, QPoint(),
+                             Points() << QPoint(2, 2), 94, "暴力搜索"));
+    all.append(makeFreeEntry("freeboth-obs-5x5", 5, 5, freeBoth, QPoint(),
+                             Points() << QPoint(1, 1) << QPoint(1, 0), 119, "暴力搜索"));
+    all.append(makeFreeEntry("freeboth-obs-6x5", 6, 5, freeBoth, QPoint(),
+                             Points() << QPoint(3, 3) << QPoint(4, 3) << QPoint(2, 1), 439, "暴力搜索"));
+
+    if (!includeSlow) {
+        QVector<Entry> fast;
+        for (const Entry& entry : all) {
+            if (!entry.slow) {
+                fast.append(entry);
+            }
+        }
+        return fast;
+    }
+    return all;
+}
+
+QVector<HamiltonianCorpus::Mode> HamiltonianCorpus::modes(int threads) {
+    const int all = HamiltonianPathEngine::PruneAll;
+    QVector<Mode> result;
+    result.append(makeMode("plain", HamiltonianPathEngine::PruneNone, 1, false));
+    result.append(makeMode("pruned", all, 1, false));
+    result.append(makeMode("parallel", HamiltonianPathEngine::PruneNone, threads, false));
+    result.append(makeMode("pruned-parallel", all, threads, false));
+    result.append(makeMode("counting", all, 1, true));
+    result.append(makeMode("counting-parallel", all, threads, true));
+    // 通用内核，与上面默认启用的小网格内核对照
+    result.append(makeMode("pruned-generic", all, 1, false, false));
+    result.append(makeMode("counting-generic", all, 1, true, false));
+    // 非自然的展开顺序逐条枚举，校验路径集合与顺序无关
+    result.append(makeOrderMode(MoveOrder::Warnsdorff));
+    result.append(makeOrderMode(MoveOrder::WallHugging));
+    result.append(makeOrderMode(MoveOrder::DistanceToEnd));
+    result.append(makeOrderMode(MoveOrder::Random));
+    // 生成器按页续取：逐条、不整除路径数的页、界面的页大小，以及检查点频繁中止
+    result.append(makePagedMode("paged-1", 1, false));
+    result.append(makePagedMode("paged-7", 7, false));
+    result.append(makePagedMode(QString("paged-%1").arg(Constants::PATH_PAGE_SIZE), Constants::PATH_PAGE_SIZE, false));
+    result.append(makePagedMode("paged-7-stops", 7, true));
+    // 一次搜索按终点分桶计数，各桶由并行的worker共同累加
+    result.append(makeByEndMode("by-end", 1));
+    result.append(makeByEndMode("by-end-parallel", threads));
+    // 折半搜索，连接表一次建完与按内存上限分批两种
+    result.append(makeMeetInTheMiddleMode("mitm", false, 0));
+    result.append(makeMeetInTheMiddleMode("mitm-counting", true, 0));
+    result.append(makeMeetInTheMiddleMode("mitm-streaming", true, STREAMING_MEMORY_LIMIT));
+    return result;
+}
+
+void HamiltonianCorpus::configure(HamiltonianPathEngine& engine, const Mode& mode) {
+    engine.setPruning(mode.pruning);
+    engine.setThreadCount(mode.threads);
+    engine.setSmallGridKernel(mode.smallGridKernel);
+    engine.setMoveOrder(mode.moveOrder, RANDOM_ORDER_SEED);
+}
+
+quint64 HamiltonianCorpus::run(const Entry& entry, const GridModel& grid, const Mode& mode, int maxPaths,
+                               const HamiltonianPathEngine::PathCallback& onPath, quint64& nodes,
+                               QVector<quint64>* endCounts) {
+    quint64 paths = 0;
+    if (mode.meetInTheMiddle) {
+        HamiltonianMeetInTheMiddle search(grid);
+        search.setMemoryLimit(mode.memoryLimit);
+        paths = mode.counting ? search.countPaths(entry.start, entry.end)
+                              : static_cast<quint64>(search.findPaths(entry.start, entry.end, maxPaths, onPath));
+        nodes = search.expandedNodes();
+        return paths;
+    }
+    HamiltonianPathEngine engine(grid);
+    configure(engine, mode);
+    engine.setEndpointMode(entry.endpoints);
+    if (mode.pageSize > 0) {
+        // 检查点中止和页满一样只是暂停，生成器留在原处，下一页接着取
+        int checkpoints = 0;
+        if (mode.checkpointStops) {
+            engine.setCheckpoint([&checkpoints]() { return ++checkpoints % 2 == 0; });
+        }
+        int delivered = 0;
+        bool keepGoing = engine.beginPaths(entry.start, entry.end);
+        while (keepGoing && delivered < maxPaths && !engine.pathsExhausted()) {
+            delivered += engine.nextPaths(qMin(mode.pageSize, maxPaths - delivered),
+                                          [&](const QVector<QPoint>& path) {
+                keepGoing = onPath(path);
+                return keepGoing;
+            });
+        }
+        nodes = engine.expandedNodes();
+        return static_cast<quint64>(delivered);
+    }
+    if (mode.byEnd) {
+        QVector<quint64> counts;
+        paths = engine.countPathsByEnd(entry.start, counts);
+        nodes = engine.expandedNodes();
+        if (endCounts) {
+            *endCounts = counts;
+        }
+        return paths;
+    }
+    paths = mode.counting ? engine.countPaths(entry.start, entry.end)
+                          : static_cast<quint64>(engine.findPaths(entry.start, entry.end, maxPaths, onPath));
+    nodes = engine.expandedNodes();
+    return paths;
+}
+
+int HamiltonianCorpus::verify(bool includeSlow, int threads) {
+    int failures = 0;
+    for (const Entry& entry : entries(includeSlow)) {
+        const GridModel grid = entry.buildGrid();
+        // 分页模式的参照：单线程findPaths()的路径序列和扩展节点数，第一次用到时生成
+        const Mode reference = makeMode("reference", HamiltonianPathEngine::PruneAll, 1, false, false);
+        QVector<QByteArray> referencePaths;
+        quint64 referenceNodes = 0;
+        bool haveReference = false;
+        for (const Mode& mode : modes(threads)) {
+            if (!runsInMode(entry, mode)) {
+                continue;
+            }
+            if (mode.pageSize > 0 && !haveReference) {
+                run(entry, grid, reference, static_cast<int>(MAX_ENUMERATED) + 1,
+                    [&referencePaths](const QVector<QPoint>& path) {
+                    referencePaths.append(pathKey(path));
+                    return true;
+                }, referenceNodes);
+                haveReference = true;
+            }
+
+            QElapsedTimer timer;
+            timer.start();
+
+            const int walkable = grid.walkableCount();
+            bool pathsValid = true;
+            QSet<QByteArray> unique;
+            quint64 nodes = 0;
+            QVector<quint64> endCounts;
+            bool sameSequence = true;
+            int emitted = 0;
+            quint64 found = run(entry, grid, mode, static_cast<int>(MAX_ENUMERATED) + 1,
+                                [&](const QVector<QPoint>& path) {
+                if (!validPath(entry, grid, walkable, path)) {
+                    pathsValid = false;
+                }
+                const QByteArray key = pathKey(path);
+                if (mode.pageSize > 0 && (emitted >= referencePaths.size() || referencePaths[emitted] != key)) {
+                    sameSequence = false;
+                }
+                ++emitted;
+                unique.insert(key);
+                return true;
+            }, nodes, &endCounts);
+            if (mode.pageSize > 0 && (found != static_cast<quint64>(referencePaths.size()) ||
+                                      nodes != referenceNodes)) {
+                sameSequence = false;
+            }
+            // 枚举模式按去重后的条数计，产出数多于去重数说明有重复路径
+            bool duplicates = false;
+            if (!mode.counting) {
+                duplicates = found != static_cast<quint64>(unique.size());
+                found = static_cast<quint64>(unique.size());
+            }
+            // 按终点计数时各终点之和应等于总数；端点固定的条目取终点的计数
+            bool bucketsMatch = true;
+            if (mode.byEnd) {
+                quint64 sum = 0;
+                for (quint64 count : endCounts) {
+                    sum += count;
+                }
+                bucketsMatch = sum == found;
+                if (entry.endpoints == EndpointMode::Fixed) {
+                    found = endCounts.value(grid.index(entry.end));
+                }
+            }
+
+            const bool ok = pathsValid && !duplicates && sameSequence && bucketsMatch && found == entry.expected;
+            if (!ok) {
+                ++failures;
+            }
+            printf("%-4s %-18s %-20s expected %10llu got %10llu %s %8lld ms\n",
+                   ok ? "ok" : "FAIL", qPrintable(entry.name), qPrintable(mode.name),
+                   static_cast<unsigned long long>(entry.expected),
+                   static_cast<unsigned long long>(found),
+                   !pathsValid ? "(非法路径)" : duplicates ? "(重复路径)" : !sameSequence ? "(序列不符)"
+                   : !bucketsMatch ? "(分桶不符)" : "          ",
+                   static_cast<long long>(timer.elapsed()));
+            fflush(stdout);
+        }
+    }
+    printf("%s: %d 项失败\n", failures == 0 ? "通过" : "失败", failures);
+    return failures;
+}
@@ -0,0 +1,62 @@
+#ifndef HAMILTONIANCORPUS_H
+#define HAMILTONIANCORPUS_H
+
+#include "GridModel.h"
+#include "HamiltonianPathEngine.h"
+#include <QPoint>
+#include <QString>
+#include <QVector>
+
+// 哈密顿路径数量已知的参考语料
+// 数值来自OEIS数列或独立的暴力搜索，用于校验各引擎模式不丢路径、不重复，也作为基准测试输入
+namespace HamiltonianCorpus {
+    struct Entry {
+        QString name;
+        int width;
+        int height;
+        QPoint start;
+        QPoint end;
+        QVector<QPoint> obstacles;
+        EndpointMode endpoints;     // 端点自由时expected为该约束下的路径数，FreeBoth时忽略start
+        quint64 expected;
+        QString source;
+        bool slow;              // 剪枝后仍需数分钟，默认不运行
+
+        GridModel buildGrid() const;
+    };
+
+    // 引擎运行模式：剪枝、并行、计数、小网格内核、展开顺序的组合，或折半搜索
+    struct Mode {
+        QString name;
+        int pruning;
+        int threads;
+        bool counting;
+        bool smallGridKernel;
+        MoveOrder moveOrder;    // 展开顺序只改变产出顺序，路径集合应与自然顺序相同
+        int pageSize;           // >0时用beginPaths()/nextPaths()按页续取，与单线程findPaths()逐条比较
+        bool checkpointStops;   // 分页时检查点每隔一次要求停止，校验中止后从原处续取
+        bool byEnd;             // 用countPathsByEnd()从起点一次数出各终点的路径数，只跑端点固定和终点自由的小条目
+        bool meetInTheMiddle;   // 用折半搜索代替DFS引擎，只跑可通行格子不超过64的条目
+        qint64 memoryLimit;     // 折半搜索连接表的内存上限，0为不限
+    };
+
+    QVector<Entry> entries(bool includeSlow);
+    QVector<Mode> modes(int threads);
+    void configure(HamiltonianPathEngine& engine, const Mode& mode);
+    // 不剪枝的模式只跑小网格，枚举模式只跑路径数不多的条目，折半搜索只跑端点固定的条目
+    bool runsInMode(const Entry& entry, const Mode& mode);
+    // 按模式跑一次：计数模式返回路径数；枚举模式把最多maxPaths条路径逐条交给onPath，返回产出数
+    // 按终点计数模式返回终点任意时的总数，endCounts非空时取回各终点的计数
+    // nodes为扩展的节点数
+    quint64 run(const Entry& entry, const GridModel& grid, const Mode& mode, int maxPaths,
+                const HamiltonianPathEngine::PathCallback& onPath, quint64& nodes,
+                QVector<quint64>* endCounts = nullptr);
+
+    // 在全部语料上校验全部模式，逐行打印结果，返回失败数
+    // 枚举模式还会逐条检查路径合法且不重复（路径数过多的条目只校验计数模式）；
+    // 分页模式检查路径序列和扩展节点数与单线程findPaths()完全相同；
+    // 按终点计数模式检查各终点之和等于总数，端点固定的条目取终点的计数比较，终点自由的取总数比较
+    int verify(bool includeSlow, int threads);
+}
+
+#endif // HAMILTONIANCORPUS_H
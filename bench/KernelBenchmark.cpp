@@ -0,0 +1,233 @@
+#include "KernelBenchmark.h"
+#include "HamiltonianPathEngine.h"
+#include "KShortestPathEngine.h"
+#include "PeakMemory.h"
+#include "ShortestPathDag.h"
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <algorithm>
+
+QString BenchmarkCase::label() const {
+    QString text = QString("%1 %2x%3 d=%4 %5")
+                   .arg(algorithmTypeToString(algorithm))
+                   .arg(width).arg(height)
+                   .arg(obstacleDensity, 0, 'f', 2)
+                   .arg(placement);
+    if (algorithm == AlgorithmType::DFS && moveOrder != MoveOrder::Natural) {
+        text += " " + moveOrderToString(moveOrder);
+    }
+    return text;
+}
+
+QJsonObject BenchmarkResult::toJson() const {
+    QJsonObject object;
+    object.insert("algorithm", algorithmTypeToString(benchCase.algorithm));
+    object.insert("width", benchCase.width);
+    object.insert("height", benchCase.height);
+    object.insert("obstacleDensity", benchCase.obstacleDensity);
+    object.insert("placement", benchCase.placement);
+    object.insert("seed", static_cast<double>(benchCase.seed));
+    if (benchCase.algorithm == AlgorithmType::DFS) {
+        object.insert("moveOrder", moveOrderToString(benchCase.moveOrder));
+    }
+    if (!skipped.isEmpty()) {
+        object.insert("skipped", skipped);
+        return object;
+    }
+    object.insert("start", QString("%1,%2").arg(start.x()).arg(start.y()));
+    object.insert("end", QString("%1,%2").arg(end.x()).arg(end.y()));
+    object.insert("walkableCells", walkableCells);
+    object.insert("paths", paths);
+    object.insert("nodes", static_cast<double>(nodes));
+    object.insert("nodesPerSec", nodesPerSec);
+    object.insert("firstResultMs", firstResultMs);
+    object.insert("totalMs", totalMs);
+    object.insert("peakKb", static_cast<double>(peakKb));
+    object.insert("completed", completed);
+    return object;
+}
+
+KernelBenchmark::Options::Options()
+    : maxPaths(1000)
+    , timeLimitMs(2000)
+    , repeat(3)
+    , seed(20240601)
+{
+    sizes << 4 << 5 << 6 << 7 << 8 << 10 << 16 << 32 << 50 << 100;
+    densities << 0.0 << 0.1 << 0.2 << 0.3;
+    placements << "corners" << "side" << "random";
+    algorithms << AlgorithmType::DFS << AlgorithmType::AStar
+               << AlgorithmType::Dijkstra << AlgorithmType::BFS;
+    moveOrders << MoveOrder::Natural;
+}
+
+QVector<BenchmarkCase> KernelBenchmark::buildMatrix(const Options& options) {
+    QVector<BenchmarkCase> cases;
+    for (AlgorithmType algorithm : options.algorithms) {
+        for (int size : options.sizes) {
+            for (double density : options.densities) {
+                for (const QString& placement : options.placements) {
+                    BenchmarkCase benchCase;
+                    benchCase.algorithm = algorithm;
+                    benchCase.width = size;
+                    benchCase.height = size;
+                    benchCase.obstacleDensity = density;
+                    benchCase.placement = placement;
+                    // 同一尺寸和密度下各算法使用相同的网格，便于横向比较
+                    benchCase.seed = options.seed + static_cast<quint32>(size * 1000 + qRound(density * 100));
+                    if (algorithm != AlgorithmType::DFS) {
+                        cases.append(benchCase);
+                        continue;
+                    }
+                    for (MoveOrder order : options.moveOrders) {
+                        benchCase.moveOrder = order;
+                        cases.append(benchCase);
+                    }
+                }
+            }
+        }
+    }
+    return cases;
+}
+
+bool KernelBenchmark::buildScenario(const BenchmarkCase& benchCase, GridModel& grid,
+                                    QPoint& start, QPoint& end) {
+    const int width = benchCase.width;
+    const int height = benchCase.height;
+    QRandomGenerator random(benchCase.seed);
+
+    grid = GridModel(width, height);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (random.generateDouble() < benchCase.obstacleDensity) {
+                grid.setType(x, y, PointType::Obstacle);
+            }
+        }
+    }
+
+    if (benchCase.placement == "corners") {
+        start = QPoint(0, 0);
+        end = QPoint(width - 1, height - 1);
+    } else if (benchCase.placement == "side") {
+        start = QPoint(0, 0);
+        end = QPoint(0, height - 1);
+    } else if (benchCase.placement == "random") {
+        QVector<QPoint> walkable;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (grid.isWalkable(x, y)) {
+                    walkable.append(QPoint(x, y));
+                }
+            }
+        }
+        if (walkable.size() < 2) {
+            return false;
+        }
+        start = walkable[random.bounded(walkable.size())];
+        do {
+            end = walkable[random.bounded(walkable.size())];
+        } while (end == start);
+    } else {
+        return false;
+    }
+
+    grid.setType(start.x(), start.y(), PointType::Start);
+    grid.setType(end.x(), end.y(), PointType::End);
+    return true;
+}
+
+BenchmarkResult KernelBenchmark::runOnce(const BenchmarkCase& benchCase, const GridModel& grid,
+                                         const QPoint& start, const QPoint& end,
+                                         int maxPaths, qint64 timeLimitMs) {
+    BenchmarkResult result;
+    result.benchCase = benchCase;
+    result.start = start;
+    result.end = end;
+    result.walkableCells = grid.walkableCount();
+
+    PeakMemory::reset();
+    QElapsedTimer timer;
+    timer.start();
+    bool timedOut = false;
+    auto withinLimit = [&]() {
+        if (timeLimitMs > 0 && timer.elapsed() >= timeLimitMs) {
+            timedOut = true;
+        }
+        return !timedOut;
+    };
+    auto onPath = [&](const QVector<QPoint>&) {
+        if (result.paths == 0) {
+            result.firstResultMs = timer.nsecsElapsed() / 1.0e6;
+        }
+        ++result.paths;
+        return withinLimit();
+    };
+
+    switch (benchCase.algorithm) {
+        case AlgorithmType::DFS: {
+            // 与界面的配置一致：全部剪枝，偶数边长对角等按奇偶性无解的场景立即结束
+            HamiltonianPathEngine engine(grid);
+            engine.setPruning(HamiltonianPathEngine::PruneAll);
+            engine.setCheckpoint(withinLimit);
+            engine.setMoveOrder(benchCase.moveOrder, benchCase.seed);
+            engine.findPaths(start, end, maxPaths, onPath);
+            result.nodes = engine.expandedNodes();
+            break;
+        }
+        case AlgorithmType::BFS: {
+            ShortestPathDag dag(grid);
+            if (dag.build(start, end)) {
+                dag.enumerate(maxPaths, onPath);
+            }
+            result.nodes = dag.expandedNodes();
+            break;
+        }
+        case AlgorithmType::AStar:
+        case AlgorithmType::Dijkstra: {
+            KShortestPathEngine engine(grid);
+            engine.setSpurSearch(benchCase.algorithm == AlgorithmType::AStar
+                                 ? KShortestPathEngine::SpurSearch::AStar
+                                 : KShortestPathEngine::SpurSearch::Dijkstra);
+            engine.setCheckpoint(withinLimit);
+            engine.findPaths(start, end, maxPaths, [&onPath](const QVector<QPoint>& path, double) {
+                return onPath(path);
+            });
+            result.nodes = engine.expandedNodes();
+            break;
+        }
+    }
+
+    result.totalMs = timer.nsecsElapsed() / 1.0e6;
+    result.peakKb = PeakMemory::peakKb();
+    result.completed = !timedOut && result.paths < maxPaths;
+    result.nodesPerSec = result.totalMs > 0.0 ? result.nodes / (result.totalMs / 1000.0) : 0.0;
+    return result;
+}
+
+BenchmarkResult KernelBenchmark::runCase(const BenchmarkCase& benchCase, int maxPaths,
+                                         qint64 timeLimitMs, int repeat) {
+    GridModel grid;
+    QPoint start;
+    QPoint end;
+    if (!buildScenario(benchCase, grid, start, end)) {
+        BenchmarkResult result;
+        result.benchCase = benchCase;
+        result.skipped = "无法放置起点和终点";
+        return result;
+    }
+
+    QVector<BenchmarkResult> runs;
+    for (int i = 0; i < qMax(1, repeat); ++i) {
+        runs.append(runOnce(benchCase, grid, start, end, maxPaths, timeLimitMs));
+    }
+
+    // 取总用时的中位数那一次，峰值内存取各次最大值
+    std::sort(runs.begin(), runs.end(), [](const BenchmarkResult& a, const BenchmarkResult& b) {
+        return a.totalMs < b.totalMs;
+    });
+    BenchmarkResult median = runs[runs.size() / 2];
+    for (const BenchmarkResult& run : runs) {
+        median.peakKb = qMax(median.peakKb, run.peakKb);
+    }
+    return median;
+}
@@ -0,0 +1,79 @@
+#ifndef KERNELBENCHMARK_H
+#define KERNELBENCHMARK_H
+
+#include "GridModel.h"
+#include "GridTypes.h"
+#include <QJsonObject>
+#include <QPoint>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// 一个基准场景：算法 × 网格尺寸 × 障碍密度 × 起终点位置
+struct BenchmarkCase {
+    AlgorithmType algorithm;
+    int width;
+    int height;
+    double obstacleDensity;
+    QString placement;      // corners: 对角；side: 同侧两角；random: 随机可通行格子
+    quint32 seed;
+    MoveOrder moveOrder;    // 只对DFS有效
+
+    BenchmarkCase() : algorithm(AlgorithmType::DFS), width(0), height(0), obstacleDensity(0.0),
+                      seed(0), moveOrder(MoveOrder::Natural) {}
+
+    QString label() const;
+};
+
+struct BenchmarkResult {
+    BenchmarkCase benchCase;
+    QPoint start;
+    QPoint end;
+    int walkableCells;
+    int paths;
+    quint64 nodes;          // 引擎扩展的节点数，含义见各引擎的expandedNodes()
+    double nodesPerSec;
+    double firstResultMs;   // -1表示没有结果
+    double totalMs;
+    qint64 peakKb;          // -1表示无法获取
+    bool completed;         // 搜索自然结束，而不是触及时限或路径上限
+    QString skipped;        // 非空表示场景无法运行（如起终点无法放置）
+
+    BenchmarkResult()
+        : walkableCells(0), paths(0), nodes(0), nodesPerSec(0.0)
+        , firstResultMs(-1.0), totalMs(0.0), peakKb(-1), completed(false) {}
+
+    QJsonObject toJson() const;
+};
+
+class KernelBenchmark {
+public:
+    struct Options {
+        QVector<int> sizes;
+        QVector<double> densities;
+        QStringList placements;
+        QVector<AlgorithmType> algorithms;
+        QVector<MoveOrder> moveOrders;  // DFS场景按每种展开顺序各跑一次，比较首条路径用时
+        int maxPaths;
+        qint64 timeLimitMs;
+        int repeat;             // 每个场景重复次数，取总用时的中位数
+        quint32 seed;
+
+        Options();
+    };
+
+    static QVector<BenchmarkCase> buildMatrix(const Options& options);
+
+    // 生成网格和起终点，无法放置起终点时返回false
+    static bool buildScenario(const BenchmarkCase& benchCase, GridModel& grid,
+                              QPoint& start, QPoint& end);
+
+    static BenchmarkResult runCase(const BenchmarkCase& benchCase, int maxPaths,
+                                   qint64 timeLimitMs, int repeat);
+
+private:
+    static BenchmarkResult runOnce(const BenchmarkCase& benchCase, const GridModel& grid,
+                                   const QPoint& start, const QPoint& end, int maxPaths, qint64 timeLimitMs);
+};
+
+#endif // KERNELBENCHMARK_H
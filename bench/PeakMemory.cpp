@@ -0,0 +1,53 @@
+#include "PeakMemory.h"
+#include <QFile>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+bool PeakMemory::reset() {
+#if defined(Q_OS_LINUX)
+    // 写入5会把VmHWM重置为当前RSS（Linux 4.0+）
+    QFile file("/proc/self/clear_refs");
+    if (file.open(QIODevice::WriteOnly)) {
+        return file.write("5") == 1;
+    }
+#endif
+    return false;
+}
+
+qint64 PeakMemory::peakKb() {
+#if defined(Q_OS_LINUX)
+    QFile file("/proc/self/status");
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        while (!file.atEnd()) {
+            const QByteArray line = file.readLine();
+            if (line.startsWith("VmHWM:")) {
+                return line.mid(6).trimmed().split(' ').first().toLongLong();
+            }
+        }
+    }
+    return -1;
+#elif defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<qint64>(counters.PeakWorkingSetSize / 1024);
+    }
+    return -1;
+#elif defined(Q_OS_UNIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(Q_OS_MACOS)
+        return usage.ru_maxrss / 1024;     // macOS单位为字节
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+    return -1;
+#else
+    return -1;
+#endif
+}
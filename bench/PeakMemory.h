@@ -0,0 +1,16 @@
+#ifndef PEAKMEMORY_H
+#define PEAKMEMORY_H
+
+#include <QtGlobal>
+
+// 进程峰值内存（常驻集）
+namespace PeakMemory {
+    // 尽可能把峰值重置为当前值，使下一次读数只反映之后的运行
+    // Linux上通过 /proc/self/clear_refs 实现；其他平台不支持时返回false，读数为进程启动以来的峰值
+    bool reset();
+
+    // 峰值常驻内存，单位KB；无法获取时返回-1
+    qint64 peakKb();
+}
+
+#endif // PEAKMEMORY_H
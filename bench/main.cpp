@@ -0,0 +1,225 @@
+#include "HamiltonianCorpus.h"
+#include "KernelBenchmark.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSysInfo>
+#include <QThread>
+#include <cstdio>
+
+namespace {
+bool parseIntList(const QString& text, QVector<int>& values) {
+    values.clear();
+    for (const QString& part : text.split(',', Qt::SkipEmptyParts)) {
+        bool ok = false;
+        const int value = part.trimmed().toInt(&ok);
+        if (!ok || value < 1 || value > Constants::MAX_GRID_SIZE) {
+            return false;
+        }
+        values.append(value);
+    }
+    return !values.isEmpty();
+}
+
+bool parseDoubleList(const QString& text, QVector<double>& values) {
+    values.clear();
+    for (const QString& part : text.split(',', Qt::SkipEmptyParts)) {
+        bool ok = false;
+        const double value = part.trimmed().toDouble(&ok);
+        if (!ok || value < 0.0 || value >= 1.0) {
+            return false;
+        }
+        values.append(value);
+    }
+    return !values.isEmpty();
+}
+
+bool parseAlgorithms(const QString& text, QVector<AlgorithmType>& values) {
+    values.clear();
+    for (const QString& part : text.split(',', Qt::SkipEmptyParts)) {
+        const QString name = part.trimmed();
+        if (name.compare("DFS", Qt::CaseInsensitive) == 0) values.append(AlgorithmType::DFS);
+        else if (name.compare("BFS", Qt::CaseInsensitive) == 0) values.append(AlgorithmType::BFS);
+        else if (name.compare("Dijkstra", Qt::CaseInsensitive) == 0) values.append(AlgorithmType::Dijkstra);
+        else if (name == "A*" || name.compare("AStar", Qt::CaseInsensitive) == 0) values.append(AlgorithmType::AStar);
+        else return false;
+    }
+    return !values.isEmpty();
+}
+
+bool parseMoveOrders(const QString& text, QVector<MoveOrder>& values) {
+    values.clear();
+    for (const QString& part : text.split(',', Qt::SkipEmptyParts)) {
+        bool ok = false;
+        values.append(stringToMoveOrder(part.trimmed(), &ok));
+        if (!ok) {
+            return false;
+        }
+    }
+    return !values.isEmpty();
+}
+
+// 语料基准：每个语料条目在每种引擎模式下计时一次
+QJsonArray runCorpus(bool includeSlow, int threads) {
+    printf("%-18s %-20s %12s %14s %12s\n", "entry", "mode", "paths", "nodes", "total(ms)");
+    QJsonArray results;
+    for (const HamiltonianCorpus::Entry& entry : HamiltonianCorpus::entries(includeSlow)) {
+        const GridModel grid = entry.buildGrid();
+        for (const HamiltonianCorpus::Mode& mode : HamiltonianCorpus::modes(threads)) {
+            if (!HamiltonianCorpus::runsInMode(entry, mode)) {
+                continue;
+            }
+            QElapsedTimer timer;
+            timer.start();
+            quint64 nodes = 0;
+            const quint64 paths = HamiltonianCorpus::run(entry, grid, mode, Constants::MAX_PATHS_LIMIT,
+                                                         [](const QVector<QPoint>&) { return true; }, nodes);
+            const double totalMs = timer.nsecsElapsed() / 1e6;
+
+            QJsonObject json;
+            json.insert("entry", entry.name);
+            json.insert("mode", mode.name);
+            json.insert("threads", mode.threads);
+            json.insert("paths", static_cast<double>(paths));
+            json.insert("expected", static_cast<double>(entry.expected));
+            json.insert("nodes", static_cast<double>(nodes));
+            json.insert("totalMs", totalMs);
+            results.append(json);
+
+            printf("%-18s %-20s %12llu %14llu %12.3f\n", qPrintable(entry.name), qPrintable(mode.name),
+                   static_cast<unsigned long long>(paths),
+                   static_cast<unsigned long long>(nodes), totalMs);
+            fflush(stdout);
+        }
+    }
+    return results;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("qweight-bench");
+    app.setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("QWeight 搜索内核基准测试：按 算法×尺寸×障碍密度×起终点位置 矩阵计时");
+    parser.addHelpOption();
+    QCommandLineOption sizesOption("sizes", "网格边长列表，默认 4,5,6,7,8,10,16,32,50,100", "list");
+    QCommandLineOption densitiesOption("densities", "障碍密度列表，默认 0,0.1,0.2,0.3", "list");
+    QCommandLineOption placementsOption("placements", "起终点位置 corners,side,random", "list");
+    QCommandLineOption algorithmsOption("algorithms", "算法列表 DFS,A*,Dijkstra,BFS", "list");
+    QCommandLineOption maxPathsOption("max-paths", "每个场景最多产出的路径数，默认1000", "n");
+    QCommandLineOption timeLimitOption("time-limit", "每个场景的时间上限(ms)，默认2000", "ms");
+    QCommandLineOption repeatOption("repeat", "每个场景重复次数，取中位数，默认3", "n");
+    QCommandLineOption ordersOption("orders", "DFS展开顺序列表 natural,warnsdorff,wallHugging,distanceToEnd,random，"
+                                              "每种顺序单独成一个场景，默认natural", "list");
+    QCommandLineOption seedOption("seed", "随机障碍种子", "n");
+    QCommandLineOption quickOption("quick", "快速模式：只跑4~8的小网格，每个场景一次");
+    QCommandLineOption outputOption(QStringList() << "o" << "output", "结果写入JSON文件", "file");
+    QCommandLineOption verifyOption("verify", "用已知路径数的语料校验哈密顿引擎的全部模式，失败时返回1");
+    QCommandLineOption corpusOption("corpus", "以语料为输入，对哈密顿引擎的各模式计时");
+    QCommandLineOption slowOption("slow", "语料包含慢速条目（如8x8）");
+    QCommandLineOption threadsOption("threads", "并行模式的线程数，默认为CPU线程数", "n");
+    parser.addOptions({sizesOption, densitiesOption, placementsOption, algorithmsOption, ordersOption,
+                       maxPathsOption, timeLimitOption, repeatOption, seedOption,
+                       quickOption, outputOption, verifyOption, corpusOption, slowOption, threadsOption});
+    parser.process(app);
+
+    const int threads = parser.isSet(threadsOption)
+        ? qMax(2, parser.value(threadsOption).toInt())
+        : qMax(2, QThread::idealThreadCount());
+    if (parser.isSet(verifyOption)) {
+        return HamiltonianCorpus::verify(parser.isSet(slowOption), threads) == 0 ? 0 : 1;
+    }
+
+    KernelBenchmark::Options options;
+    if (parser.isSet(quickOption)) {
+        options.sizes = {4, 5, 6, 7, 8};
+        options.repeat = 1;
+    }
+    if (parser.isSet(sizesOption) && !parseIntList(parser.value(sizesOption), options.sizes)) {
+        fprintf(stderr, "--sizes 无效\n");
+        return 2;
+    }
+    if (parser.isSet(densitiesOption) && !parseDoubleList(parser.value(densitiesOption), options.densities)) {
+        fprintf(stderr, "--densities 无效\n");
+        return 2;
+    }
+    if (parser.isSet(placementsOption)) {
+        options.placements = parser.value(placementsOption).split(',', Qt::SkipEmptyParts);
+    }
+    if (parser.isSet(algorithmsOption) && !parseAlgorithms(parser.value(algorithmsOption), options.algorithms)) {
+        fprintf(stderr, "--algorithms 无效\n");
+        return 2;
+    }
+    if (parser.isSet(ordersOption) && !parseMoveOrders(parser.value(ordersOption), options.moveOrders)) {
+        fprintf(stderr, "--orders 无效\n");
+        return 2;
+    }
+    if (parser.isSet(maxPathsOption)) options.maxPaths = qMax(1, parser.value(maxPathsOption).toInt());
+    if (parser.isSet(timeLimitOption)) options.timeLimitMs = qMax<qint64>(0, parser.value(timeLimitOption).toLongLong());
+    if (parser.isSet(repeatOption)) options.repeat = qMax(1, parser.value(repeatOption).toInt());
+    if (parser.isSet(seedOption)) options.seed = parser.value(seedOption).toUInt();
+
+    QJsonArray resultArray;
+    if (parser.isSet(corpusOption)) {
+        resultArray = runCorpus(parser.isSet(slowOption), threads);
+    } else {
+        const QVector<BenchmarkCase> cases = KernelBenchmark::buildMatrix(options);
+        printf("%-36s %8s %12s %14s %12s %12s %10s %s\n",
+               "case", "paths", "nodes", "nodes/sec", "first(ms)", "total(ms)", "peak(KB)", "done");
+
+        for (const BenchmarkCase& benchCase : cases) {
+            const BenchmarkResult result = KernelBenchmark::runCase(benchCase, options.maxPaths,
+                                                                    options.timeLimitMs, options.repeat);
+            resultArray.append(result.toJson());
+            if (!result.skipped.isEmpty()) {
+                printf("%-36s skipped: %s\n", qPrintable(benchCase.label()), qPrintable(result.skipped));
+            } else {
+                printf("%-36s %8d %12llu %14.0f %12.3f %12.3f %10lld %s\n",
+                       qPrintable(benchCase.label()), result.paths,
+                       static_cast<unsigned long long>(result.nodes), result.nodesPerSec,
+                       result.firstResultMs, result.totalMs,
+                       static_cast<long long>(result.peakKb), result.completed ? "yes" : "limit");
+            }
+            fflush(stdout);
+        }
+    }
+
+    if (parser.isSet(outputOption)) {
+        QJsonObject settings;
+        settings.insert("maxPaths", options.maxPaths);
+        settings.insert("timeLimitMs", static_cast<double>(options.timeLimitMs));
+        settings.insert("repeat", options.repeat);
+        settings.insert("seed", static_cast<double>(options.seed));
+
+        QJsonObject machine;
+        machine.insert("cpu", QSysInfo::currentCpuArchitecture());
+        machine.insert("os", QSysInfo::prettyProductName());
+        machine.insert("threads", QThread::idealThreadCount());
+        machine.insert("qt", QString(qVersion()));
+#ifdef QT_NO_DEBUG
+        machine.insert("build", "release");
+#else
+        machine.insert("build", "debug");
+#endif
+
+        QJsonObject root;
+        root.insert("timestamp", QDateTime::currentDateTime().toString(Qt::ISODate));
+        root.insert("settings", settings);
+        root.insert("machine", machine);
+        root.insert("results", resultArray);
+
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly) || file.write(QJsonDocument(root).toJson()) < 0) {
+            fprintf(stderr, "无法写入 %s\n", qPrintable(parser.value(outputOption)));
+            return 3;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,25 @@
+QT += core
+QT -= gui
+
+CONFIG += c++14 console
+CONFIG -= app_bundle
+
+TARGET = qweight-bench
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+include(../src/engine.pri)
+
+win32: LIBS += -lpsapi
+
+SOURCES += \
+    HamiltonianCorpus.cpp \
+    KernelBenchmark.cpp \
+    PeakMemory.cpp \
+    main.cpp
+
+HEADERS += \
+    HamiltonianCorpus.h \
+    KernelBenchmark.h \
+    PeakMemory.h
@@ -0,0 +1,253 @@
+#include "BatchJob.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QRandomGenerator>
+#include <QRect>
+#include <cmath>
+
+namespace {
+bool readPoint(const QJsonValue& value, QPoint& point) {
+    // 点写作 [x, y]
+    const QJsonArray array = value.toArray();
+    if (array.size() != 2 || !array[0].isDouble() || !array[1].isDouble()) {
+        return false;
+    }
+    point = QPoint(array[0].toInt(), array[1].toInt());
+    return true;
+}
+
+bool readAlgorithm(const QString& text, AlgorithmType& algorithm) {
+    // stringToAlgorithmType对未知名称返回A*，批处理中需要明确报错
+    const QString normalized = text.trimmed();
+    if (normalized.compare("DFS", Qt::CaseInsensitive) == 0) {
+        algorithm = AlgorithmType::DFS;
+    } else if (normalized.compare("BFS", Qt::CaseInsensitive) == 0) {
+        algorithm = AlgorithmType::BFS;
+    } else if (normalized.compare("Dijkstra", Qt::CaseInsensitive) == 0) {
+        algorithm = AlgorithmType::Dijkstra;
+    } else if (normalized == "A*" || normalized.compare("AStar", Qt::CaseInsensitive) == 0) {
+        algorithm = AlgorithmType::AStar;
+    } else {
+        return false;
+    }
+    return true;
+}
+}
+
+GridModel BatchJob::buildGrid() const {
+    GridModel grid(width, height);
+    for (const QPoint& point : obstacles) {
+        grid.setType(point.x(), point.y(), PointType::Obstacle);
+    }
+
+    if (obstacleDensity > 0.0) {
+        QRandomGenerator random(seed);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (random.generateDouble() < obstacleDensity) {
+                    grid.setType(x, y, PointType::Obstacle);
+                }
+            }
+        }
+    }
+
+    // 用到的起点终点始终可通行
+    if (usesStart()) {
+        grid.setType(start.x(), start.y(), PointType::Start);
+    }
+    if (usesEnd()) {
+        grid.setType(end.x(), end.y(), PointType::End);
+    }
+
+    for (int i = 0; i < weightCells.size(); ++i) {
+        grid.setWeight(grid.index(weightCells[i]), weightValues[i]);
+    }
+    return grid;
+}
+
+bool BatchJob::usesStart() const {
+    return algorithm != AlgorithmType::DFS || endpoints != EndpointMode::FreeBoth ||
+           objective == PathObjective::EndCounts;
+}
+
+bool BatchJob::usesEnd() const {
+    return algorithm != AlgorithmType::DFS ||
+           (endpoints == EndpointMode::Fixed && objective != PathObjective::EndCounts);
+}
+
+BatchJob BatchJobFile::parseJob(const QJsonObject& object, int index) {
+    BatchJob job;
+    job.name = object.value("name").toString(QString("job_%1").arg(index + 1));
+    job.width = object.value("width").toInt(job.width);
+    job.height = object.value("height").toInt(job.height);
+    job.obstacleDensity = object.value("obstacleDensity").toDouble(0.0);
+    job.seed = static_cast<quint32>(object.value("seed").toDouble(index));
+    job.maxPaths = object.value("maxPaths").toInt(job.maxPaths);
+    const double timeLimitMs = object.value("timeLimitMs").toDouble(0);
+    const double maxNodes = object.value("maxNodes").toDouble(0);
+    const double memoryLimitMb = object.value("memoryLimitMb").toDouble(0);
+
+    if (job.width < 1 || job.height < 1 ||
+        job.width > Constants::MAX_GRID_SIZE || job.height > Constants::MAX_GRID_SIZE) {
+        job.error = QString("网格尺寸必须在1到%1之间").arg(Constants::MAX_GRID_SIZE);
+        return job;
+    }
+    if (job.maxPaths < 1 || job.maxPaths > Constants::MAX_PATHS_LIMIT) {
+        job.error = QString("maxPaths必须在1到%1之间").arg(Constants::MAX_PATHS_LIMIT);
+        return job;
+    }
+    if (job.obstacleDensity < 0.0 || job.obstacleDensity >= 1.0) {
+        job.error = "obstacleDensity必须在[0,1)之间";
+        return job;
+    }
+    if (timeLimitMs < 0 || maxNodes < 0 || memoryLimitMb < 0) {
+        job.error = "timeLimitMs、maxNodes、memoryLimitMb不能为负数";
+        return job;
+    }
+    job.budget.maxMillis = static_cast<qint64>(timeLimitMs);
+    job.budget.maxNodes = static_cast<quint64>(maxNodes);
+    job.budget.maxMemoryBytes = static_cast<qint64>(memoryLimitMb * 1024 * 1024);
+
+    const QString algorithmText = object.value("algorithm").toString("DFS");
+    if (!readAlgorithm(algorithmText, job.algorithm)) {
+        job.error = QString("未知算法: %1").arg(algorithmText);
+        return job;
+    }
+
+    const QString endpointsText = object.value("endpoints").toString("fixed");
+    bool knownEndpoints = false;
+    job.endpoints = stringToEndpointMode(endpointsText, &knownEndpoints);
+    if (!knownEndpoints) {
+        job.error = QString("未知端点模式: %1").arg(endpointsText);
+        return job;
+    }
+    if (job.endpoints != EndpointMode::Fixed && job.algorithm != AlgorithmType::DFS) {
+        job.error = "endpoints只对DFS有效";
+        return job;
+    }
+
+    const QString objectiveText = object.value("objective").toString("enumerate");
+    if (objectiveText == "enumerate") {
+        job.objective = PathObjective::Enumerate;
+    } else if (objectiveText == "minWeight") {
+        job.objective = PathObjective::MinWeight;
+    } else if (objectiveText == "minTurns") {
+        job.objective = PathObjective::MinTurns;
+    } else if (objectiveText == "construct") {
+        job.objective = PathObjective::Construct;
+    } else if (objectiveText == "portfolio") {
+        job.objective = PathObjective::Portfolio;
+    } else if (objectiveText == "endCounts") {
+        job.objective = PathObjective::EndCounts;
+    } else if (objectiveText == "meetInTheMiddle") {
+        job.objective = PathObjective::MeetInTheMiddle;
+    } else {
+        job.error = QString("未知目标: %1").arg(objectiveText);
+        return job;
+    }
+
+    // 端点自由或按终点统计时对应的start/end可以省略
+    const QRect bounds(0, 0, job.width, job.height);
+    if (job.usesStart() &&
+        (!readPoint(object.value("start"), job.start) || !bounds.contains(job.start))) {
+        job.error = "start缺失或超出网格";
+        return job;
+    }
+    if (job.usesEnd() &&
+        (!readPoint(object.value("end"), job.end) || !bounds.contains(job.end))) {
+        job.error = "end缺失或超出网格";
+        return job;
+    }
+
+    const QString neighborhoodText = object.value("neighborhood").toString("four");
+    bool knownNeighborhood = false;
+    job.neighborhood = stringToNeighborhoodType(neighborhoodText, &knownNeighborhood);
+    if (!knownNeighborhood) {
+        job.error = QString("未知邻域: %1").arg(neighborhoodText);
+        return job;
+    }
+
+    const QString moveOrderText = object.value("moveOrder").toString("natural");
+    bool knownMoveOrder = false;
+    job.moveOrder = stringToMoveOrder(moveOrderText, &knownMoveOrder);
+    if (!knownMoveOrder) {
+        job.error = QString("未知展开顺序: %1").arg(moveOrderText);
+        return job;
+    }
+
+    // 权重写作 [x, y, w]；w须为有限的非负数，最短路径和最小代价搜索都假定代价非负
+    const QJsonArray weightArray = object.value("weights").toArray();
+    for (const QJsonValue& value : weightArray) {
+        const QJsonArray entry = value.toArray();
+        QPoint point;
+        if (entry.size() != 3 || !entry[2].isDouble() ||
+            !readPoint(QJsonArray() << entry[0] << entry[1], point) || !bounds.contains(point)) {
+            job.error = "weights中存在无效的项";
+            return job;
+        }
+        const double weight = entry[2].toDouble();
+        if (!(weight >= 0.0) || !std::isfinite(weight)) {
+            job.error = QString("weights中存在无效的权重: %1（须为有限的非负数）").arg(weight);
+            return job;
+        }
+        job.weightCells.append(point);
+        job.weightValues.append(weight);
+    }
+
+    const QJsonArray obstacleArray = object.value("obstacles").toArray();
+    for (const QJsonValue& value : obstacleArray) {
+        QPoint point;
+        if (!readPoint(value, point) || !bounds.contains(point)) {
+            job.error = "obstacles中存在无效的点";
+            return job;
+        }
+        if ((job.usesStart() && point == job.start) || (job.usesEnd() && point == job.end)) {
+            job.error = "障碍点不能与起点或终点重合";
+            return job;
+        }
+        job.obstacles.append(point);
+    }
+
+    return job;
+}
+
+bool BatchJobFile::load(const QString& filename, QVector<BatchJob>& jobs, QString& error) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = QString("无法打开任务文件: %1").arg(file.errorString());
+        return false;
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        error = QString("任务文件格式错误: %1 (偏移 %2)")
+                .arg(parseError.errorString()).arg(parseError.offset);
+        return false;
+    }
+
+    // 顶层可以直接是任务数组
+    QJsonObject defaults;
+    QJsonArray jobArray;
+    if (document.isArray()) {
+        jobArray = document.array();
+    } else {
+        defaults = document.object().value("defaults").toObject();
+        jobArray = document.object().value("jobs").toArray();
+    }
+
+    jobs.clear();
+    jobs.reserve(jobArray.size());
+    for (int i = 0; i < jobArray.size(); ++i) {
+        QJsonObject object = jobArray[i].toObject();
+        for (auto it = defaults.constBegin(); it != defaults.constEnd(); ++it) {
+            if (!object.contains(it.key())) {
+                object.insert(it.key(), it.value());
+            }
+        }
+        jobs.append(parseJob(object, i));
+    }
+    return true;
+}
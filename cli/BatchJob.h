@@ -0,0 +1,63 @@
+#ifndef BATCHJOB_H
+#define BATCHJOB_H
+
+#include "GridTypes.h"
+#include "GridModel.h"
+#include "SearchBudget.h"
+#include <QJsonObject>
+#include <QPoint>
+#include <QString>
+#include <QVector>
+
+// 批处理任务：一个网格场景加一次路径搜索
+struct BatchJob {
+    QString name;
+    int width;
+    int height;
+    QVector<QPoint> obstacles;      // 显式指定的障碍点
+    QVector<QPoint> weightCells;    // 显式指定权重的格子，与weightValues一一对应
+    QVector<double> weightValues;
+    double obstacleDensity;         // 随机障碍比例 [0,1)，0表示不生成
+    quint32 seed;                   // 随机障碍的种子，保证可复现
+    QPoint start;
+    QPoint end;
+    AlgorithmType algorithm;
+    PathObjective objective;        // 只对DFS有效
+    NeighborhoodType neighborhood;
+    MoveOrder moveOrder;            // 只对DFS枚举有效，随机顺序使用seed
+    EndpointMode endpoints;         // 只对DFS有效；端点自由时总是枚举，忽略objective
+    int maxPaths;
+    SearchBudget budget;            // timeLimitMs / maxNodes / memoryLimitMb，0表示不限
+    QString error;                  // 解析失败的原因，非空时任务无效
+
+    BatchJob()
+        : width(Constants::DEFAULT_GRID_WIDTH)
+        , height(Constants::DEFAULT_GRID_HEIGHT)
+        , obstacleDensity(0.0)
+        , seed(0)
+        , algorithm(AlgorithmType::DFS)
+        , objective(PathObjective::Enumerate)
+        , neighborhood(NeighborhoodType::Four)
+        , moveOrder(MoveOrder::Natural)
+        , endpoints(EndpointMode::Fixed)
+        , maxPaths(Constants::DEFAULT_MAX_PATHS) {}
+
+    bool isValid() const { return error.isEmpty(); }
+    // 端点自由或按终点统计时对应的start/end不参与搜索，可以省略
+    bool usesStart() const;
+    bool usesEnd() const;
+
+    // 按任务描述生成网格，与GridGraphicsView::getGrid()一致
+    GridModel buildGrid() const;
+};
+
+// 任务文件读取
+// 格式：{ "defaults": {...}, "jobs": [ {...}, ... ] }，任务中未给出的字段取defaults
+class BatchJobFile {
+public:
+    // 文件无法读取或不是合法JSON时返回false；单个任务的错误记录在BatchJob::error中
+    static bool load(const QString& filename, QVector<BatchJob>& jobs, QString& error);
+    static BatchJob parseJob(const QJsonObject& object, int index);
+};
+
+#endif // BATCHJOB_H
@@ -0,0 +1,250 @@
+#include "BatchRunner.h"
+#include "ConstructiveHamiltonianPath.h"
+#include "HamiltonianPathEngine.h"
+#include "HamiltonianMeetInTheMiddle.h"
+#include "HamiltonianPortfolio.h"
+#include "KShortestPathEngine.h"
+#include "Neighborhood.h"
+#include "ShortestPathDag.h"
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QThreadPool>
+#include <type_traits>
+
+QString BatchJobResult::statusToString(Status status) {
+    switch (status) {
+        case Ok: return "ok";
+        case NoPath: return "no_path";
+        case BudgetExhausted: return "budget_exhausted";
+        case Invalid: return "invalid";
+        default: return "unknown";
+    }
+}
+
+QJsonObject BatchJobResult::toJson() const {
+    QJsonObject object;
+    object.insert("index", index);
+    object.insert("name", name);
+    object.insert("algorithm", algorithmTypeToString(algorithm));
+    object.insert("status", statusToString(status));
+    object.insert("paths", pathCount);
+    if (!totalCount.isEmpty()) {
+        // 可能超出double精度，按字符串输出
+        object.insert("totalPaths", totalCount);
+    }
+    if (bestCost >= 0.0) {
+        object.insert("bestCost", bestCost);
+    }
+    if (bestTurns >= 0) {
+        object.insert("bestTurns", bestTurns);
+    }
+    if (!winner.isEmpty()) {
+        object.insert("winner", winner);
+    }
+    if (!endCells.isEmpty()) {
+        // 写作 [x, y, 路径数]；计数逐条累加得来，实际不会超出double精度
+        QJsonArray cells;
+        for (int i = 0; i < endCells.size(); ++i) {
+            cells.append(QJsonArray() << endCells[i].x() << endCells[i].y()
+                                      << static_cast<double>(endCounts[i]));
+        }
+        object.insert("endCounts", cells);
+    }
+    object.insert("firstPathMs", static_cast<double>(firstPathMs));
+    object.insert("elapsedMs", static_cast<double>(elapsedMs));
+    object.insert("nodes", static_cast<double>(nodes));
+    if (coverage >= 0.0) {
+        object.insert("coverage", coverage);
+    }
+    if (!exhausted.isEmpty()) {
+        object.insert("exhausted", exhausted);
+    }
+    if (!error.isEmpty()) {
+        object.insert("error", error);
+    }
+    return object;
+}
+
+BatchRunner::BatchRunner()
+    : m_threadCount(0)
+    , m_keepPaths(false)
+{
+}
+
+BatchJobResult BatchRunner::runJob(const BatchJob& job, int index, bool keepPaths) {
+    BatchJobResult result;
+    result.index = index;
+    result.name = job.name;
+    result.algorithm = job.algorithm;
+    if (!job.isValid()) {
+        result.status = BatchJobResult::Invalid;
+        result.error = job.error;
+        return result;
+    }
+
+    const GridModel grid = job.buildGrid();
+    QElapsedTimer timer;
+    timer.start();
+    BudgetMeter meter(job.budget);
+    meter.start();
+
+    // 所有引擎共用的检查点：任一项预算用完则停止
+    // 节点数由各分支指向所用引擎；内存只计入保留下来写文件的路径
+    std::function<quint64()> expandedSoFar = []() { return quint64(0); };
+    auto withinLimit = [&]() {
+        return meter.withinBudget(expandedSoFar());
+    };
+    auto onPath = [&](const QVector<QPoint>& path) {
+        if (result.pathCount == 0) {
+            result.firstPathMs = timer.elapsed();
+        }
+        ++result.pathCount;
+        if (keepPaths) {
+            // 以路径首尾为端点，端点自由时各条路径的端点不同
+            result.paths.append(PathResult(QString("%1_%2").arg(job.name).arg(result.pathCount),
+                                           path.first(), path.last(), path, job.algorithm, timer.elapsed()));
+            meter.addPath(path);
+        }
+        return withinLimit();
+    };
+
+    // 按任务的邻域分派一次，各引擎都是该邻域的特化版本
+    visitNeighborhood(job.neighborhood, [&](auto policy) {
+        typedef decltype(policy) Neighborhood;
+        switch (job.algorithm) {
+            case AlgorithmType::DFS: {
+                // 与界面和worker一致，各目标都启用全部剪枝
+                BasicHamiltonianPathEngine<Neighborhood> engine(grid);
+                engine.setPruning(HamiltonianPathEngine::PruneAll);
+                expandedSoFar = [&engine]() { return engine.expandedSoFar(); };
+                engine.setCheckpoint(withinLimit);
+                engine.setMoveOrder(job.moveOrder, job.seed);
+                engine.setEndpointMode(job.endpoints);
+                if (job.objective == PathObjective::EndCounts) {
+                    // 一次搜索按终点分桶计数，前maxPaths条路径照常产出
+                    QVector<quint64> counts;
+                    result.totalCount = QString::number(engine.countPathsByEnd(job.start, counts,
+                                                                               job.maxPaths, onPath));
+                    for (int i = 0; i < counts.size(); ++i) {
+                        if (counts[i] > 0) {
+                            result.endCells.append(grid.toPoint(i));
+                            result.endCounts.append(counts[i]);
+                        }
+                    }
+                } else if (job.endpoints != EndpointMode::Fixed) {
+                    // 所有端点在一棵搜索树中枚举
+                    engine.findPaths(job.start, job.end, job.maxPaths, onPath);
+                } else if (job.objective == PathObjective::MinWeight) {
+                    // 每次改进算作一条路径，超时时bestCost为已知最优
+                    result.bestCost = engine.findMinimumCost(job.start, job.end,
+                                                             HamiltonianPathEngine::gradientCost(grid),
+                                                             [&onPath](const QVector<QPoint>& path, double) {
+                        return onPath(path);
+                    });
+                } else if (job.objective == PathObjective::MinTurns) {
+                    result.bestTurns = engine.findMinimumTurns(job.start, job.end,
+                                                               [&onPath](const QVector<QPoint>& path, int) {
+                        return onPath(path);
+                    });
+                } else if (job.objective == PathObjective::Construct) {
+                    // 四邻域先按规则构造；判定无解即结束，形状不支持时搜索第一条
+                    ConstructiveHamiltonianPath::Outcome outcome = ConstructiveHamiltonianPath::Unsupported;
+                    if (std::is_same<Neighborhood, Neighborhoods::Four>::value) {
+                        QVector<QPoint> path;
+                        outcome = ConstructiveHamiltonianPath(grid).construct(job.start, job.end, path);
+                        if (outcome == ConstructiveHamiltonianPath::Constructed) {
+                            onPath(path);
+                        }
+                    }
+                    if (outcome != ConstructiveHamiltonianPath::Unsupported) {
+                        break;  // 没有经过搜索，没有节点数和覆盖估计
+                    }
+                    engine.findPaths(job.start, job.end, 1, onPath);
+                } else if (job.objective == PathObjective::Portfolio) {
+                    BasicHamiltonianPortfolio<Neighborhood> portfolio(grid);
+                    expandedSoFar = [&portfolio]() { return portfolio.expandedSoFar(); };
+                    portfolio.setCheckpoint(withinLimit);
+                    const typename BasicHamiltonianPortfolio<Neighborhood>::Result raced =
+                        portfolio.run(job.start, job.end);
+                    result.nodes = raced.expandedNodes;
+                    if (raced.decided) {
+                        result.winner = portfolioStrategyToString(raced.winner);
+                        if (!raced.path.isEmpty()) {
+                            onPath(raced.path);
+                        }
+                    }
+                    break;
+                } else if (job.objective == PathObjective::MeetInTheMiddle &&
+                           grid.walkableCount() <= BasicHamiltonianMeetInTheMiddle<Neighborhood>::MAX_CELLS) {
+                    // 内存预算同时约束连接表；格子超过上限时走下面的DFS
+                    BasicHamiltonianMeetInTheMiddle<Neighborhood> search(grid);
+                    expandedSoFar = [&search]() { return search.expandedSoFar(); };
+                    search.setCheckpoint(withinLimit);
+                    search.setMemoryLimit(job.budget.maxMemoryBytes);
+                    search.findPaths(job.start, job.end, job.maxPaths, onPath);
+                    result.nodes = search.expandedNodes();
+                    break;
+                } else {
+                    engine.findPaths(job.start, job.end, job.maxPaths, onPath);
+                }
+                result.nodes = engine.expandedNodes();
+                result.coverage = engine.coverage();
+                break;
+            }
+            case AlgorithmType::BFS: {
+                BasicShortestPathDag<Neighborhood> dag(grid);
+                if (dag.build(job.start, job.end)) {
+                    result.totalCount = dag.pathCount().toString();
+                    expandedSoFar = [&dag]() { return dag.expandedNodes(); };
+                    dag.enumerate(job.maxPaths, onPath);
+                }
+                result.nodes = dag.expandedNodes();
+                break;
+            }
+            case AlgorithmType::AStar:
+            case AlgorithmType::Dijkstra: {
+                typedef BasicKShortestPathEngine<Neighborhood> Engine;
+                Engine engine(grid);
+                engine.setSpurSearch(job.algorithm == AlgorithmType::AStar
+                                     ? Engine::SpurSearch::AStar
+                                     : Engine::SpurSearch::Dijkstra);
+                expandedSoFar = [&engine]() { return engine.expandedNodes(); };
+                engine.setCheckpoint(withinLimit);
+                engine.findPaths(job.start, job.end, job.maxPaths,
+                                 [&onPath](const QVector<QPoint>& path, double) {
+                    return onPath(path);
+                });
+                result.nodes = engine.expandedNodes();
+                break;
+            }
+        }
+    });
+
+    result.elapsedMs = timer.elapsed();
+    if (meter.isExhausted()) {
+        result.status = BatchJobResult::BudgetExhausted;
+        result.exhausted = BudgetMeter::resourceToString(meter.exhausted());
+    } else if (result.pathCount == 0) {
+        result.status = BatchJobResult::NoPath;
+    } else {
+        result.status = BatchJobResult::Ok;
+    }
+    return result;
+}
+
+void BatchRunner::run(const QVector<BatchJob>& jobs, const ResultCallback& onResult) {
+    QThreadPool pool;
+    if (m_threadCount > 0) {
+        pool.setMaxThreadCount(m_threadCount);
+    }
+
+    for (int i = 0; i < jobs.size(); ++i) {
+        const bool keepPaths = m_keepPaths;
+        pool.start([this, &jobs, &onResult, i, keepPaths]() {
+            BatchJobResult result = runJob(jobs[i], i, keepPaths);
+            QMutexLocker locker(&m_callbackMutex);
+            onResult(result);
+        });
+    }
+    pool.waitForDone();
+}
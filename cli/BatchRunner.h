@@ -0,0 +1,71 @@
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include "BatchJob.h"
+#include "PathResult.h"
+#include <QJsonObject>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+// 单个任务的执行结果
+struct BatchJobResult {
+    enum Status {
+        Ok,             // 正常完成（包括达到maxPaths上限）
+        NoPath,         // 搜索完成但没有路径
+        BudgetExhausted,    // 时间、节点或内存预算用完，结果不完整
+        Invalid         // 任务描述有误，未执行
+    };
+
+    int index;
+    QString name;
+    AlgorithmType algorithm;
+    Status status;
+    int pathCount;
+    QString totalCount;         // BFS给出的最短路径精确总数，按终点统计时为哈密顿路径总数，其他为空
+    double bestCost;            // 最小代价搜索的最优代价，-1表示没有
+    int bestTurns;              // 最少转弯搜索的最少转弯数，-1表示没有
+    QString winner;             // 多策略竞速中给出答案的策略，其他任务为空
+    qint64 firstPathMs;         // 找到第一条路径的用时，-1表示没有
+    qint64 elapsedMs;
+    quint64 nodes;              // 扩展的节点数
+    double coverage;            // 哈密顿路径搜索估计覆盖的搜索树比例，-1表示没有估计
+    QString exhausted;          // 最先用完的预算（"time"/"nodes"/"memory"），未用完时为空
+    QVector<QPoint> endCells;   // 按终点统计：有路径的终点格子
+    QVector<quint64> endCounts; // 与endCells一一对应的路径数
+    QString error;
+    QVector<PathResult> paths;  // 仅在需要写入文件时保留
+
+    BatchJobResult()
+        : index(-1), algorithm(AlgorithmType::DFS), status(Invalid)
+        , pathCount(0), bestCost(-1.0), bestTurns(-1), firstPathMs(-1), elapsedMs(0)
+        , nodes(0), coverage(-1.0) {}
+
+    static QString statusToString(Status status);
+    QJsonObject toJson() const;
+};
+
+// 批处理执行器：在线程池上并行执行任务，每完成一个回调一次
+class BatchRunner {
+public:
+    using ResultCallback = std::function<void(const BatchJobResult& result)>;
+
+    BatchRunner();
+
+    void setThreadCount(int threads) { m_threadCount = threads; }
+    void setKeepPaths(bool keep) { m_keepPaths = keep; }
+
+    // 阻塞直到所有任务完成；回调在工作线程中调用，但彼此串行
+    void run(const QVector<BatchJob>& jobs, const ResultCallback& onResult);
+
+    // 执行单个任务，可在任意线程调用
+    static BatchJobResult runJob(const BatchJob& job, int index, bool keepPaths);
+
+private:
+    int m_threadCount;      // 0表示使用全部核心
+    bool m_keepPaths;
+    QMutex m_callbackMutex;
+};
+
+#endif // BATCHRUNNER_H
@@ -0,0 +1,137 @@
+#include "BatchJob.h"
+#include "BatchRunner.h"
+#include "DataManager.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QThread>
+#include <cstdio>
+
+// 退出码，供调度脚本判断
+enum ExitCode {
+    ExitOk = 0,             // 全部任务正常完成（包括无路径）
+    ExitJobErrors = 1,      // 存在无效任务
+    ExitUsage = 2,          // 参数错误或任务文件无法读取
+    ExitOutputError = 3,    // 结果文件写入失败
+    ExitBudgetExhausted = 4 // 存在预算用尽的任务（且没有无效任务）
+};
+
+namespace {
+void writeJsonLine(FILE* stream, const QJsonObject& object) {
+    const QByteArray line = QJsonDocument(object).toJson(QJsonDocument::Compact);
+    fwrite(line.constData(), 1, static_cast<size_t>(line.size()), stream);
+    fputc('\n', stream);
+    fflush(stream);
+}
+
+void writeError(const QString& message) {
+    QJsonObject object;
+    object.insert("error", message);
+    writeJsonLine(stderr, object);
+}
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("qweight-cli");
+    app.setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("QWeight 批处理路径计算：读取JSON任务文件，并行执行，每个任务输出一行JSON");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("jobfile", "JSON任务文件");
+    QCommandLineOption threadsOption(QStringList() << "j" << "threads",
+                                     "并行线程数，默认使用全部核心", "n");
+    QCommandLineOption outputOption(QStringList() << "o" << "output",
+                                    "把所有路径写入文件，按扩展名选择 .xml / .db / .csv", "file");
+    parser.addOption(threadsOption);
+    parser.addOption(outputOption);
+    parser.process(app);
+
+    const QStringList positional = parser.positionalArguments();
+    if (positional.size() != 1) {
+        writeError("需要且只需要一个任务文件参数");
+        return ExitUsage;
+    }
+
+    int threads = QThread::idealThreadCount();
+    if (parser.isSet(threadsOption)) {
+        bool ok = false;
+        threads = parser.value(threadsOption).toInt(&ok);
+        if (!ok || threads < 1) {
+            writeError("--threads 必须是正整数");
+            return ExitUsage;
+        }
+    }
+
+    DataManager dataManager;
+    const QString outputFile = parser.value(outputOption);
+    const bool writeOutput = !outputFile.isEmpty();
+    if (writeOutput && dataManager.detectFileType(outputFile) == DataManager::Unknown) {
+        writeError(QString("无法识别的输出文件类型: %1").arg(outputFile));
+        return ExitUsage;
+    }
+
+    QVector<BatchJob> jobs;
+    QString loadError;
+    if (!BatchJobFile::load(positional.first(), jobs, loadError)) {
+        writeError(loadError);
+        return ExitUsage;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    int counts[BatchJobResult::Invalid + 1] = {0, 0, 0, 0};
+    QVector<PathResult> allPaths;
+
+    BatchRunner runner;
+    runner.setThreadCount(threads);
+    runner.setKeepPaths(writeOutput);
+    runner.run(jobs, [&](const BatchJobResult& result) {
+        counts[result.status]++;
+        writeJsonLine(stdout, result.toJson());
+        if (writeOutput) {
+            allPaths += result.paths;
+        }
+    });
+
+    int exitCode = ExitOk;
+    if (counts[BatchJobResult::Invalid] > 0) {
+        exitCode = ExitJobErrors;
+    } else if (counts[BatchJobResult::BudgetExhausted] > 0) {
+        exitCode = ExitBudgetExhausted;
+    }
+
+    if (writeOutput) {
+        bool saved = false;
+        switch (dataManager.detectFileType(outputFile)) {
+            case DataManager::Xml: saved = dataManager.saveToXml(outputFile, allPaths); break;
+            case DataManager::Sqlite: saved = dataManager.saveToSqlite(outputFile, allPaths); break;
+            case DataManager::Csv: saved = dataManager.saveToCsv(outputFile, allPaths); break;
+            default: break;
+        }
+        if (!saved) {
+            writeError(QString("写入结果文件失败: %1").arg(outputFile));
+            exitCode = ExitOutputError;
+        }
+    }
+
+    // 最后一行为汇总
+    QJsonObject summary;
+    summary.insert("summary", true);
+    summary.insert("jobs", jobs.size());
+    summary.insert("ok", counts[BatchJobResult::Ok]);
+    summary.insert("noPath", counts[BatchJobResult::NoPath]);
+    summary.insert("budgetExhausted", counts[BatchJobResult::BudgetExhausted]);
+    summary.insert("invalid", counts[BatchJobResult::Invalid]);
+    summary.insert("threads", threads);
+    summary.insert("elapsedMs", static_cast<double>(timer.elapsed()));
+    summary.insert("exitCode", exitCode);
+    writeJsonLine(stdout, summary);
+
+    return exitCode;
+}
@@ -0,0 +1,22 @@
+QT += core
+QT -= gui
+
+CONFIG += c++14 console
+CONFIG -= app_bundle
+
+TARGET = qweight-cli
+TEMPLATE = app
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+include(../src/engine.pri)
+include(../src/data.pri)
+
+SOURCES += \
+    BatchJob.cpp \
+    BatchRunner.cpp \
+    main.cpp
+
+HEADERS += \
+    BatchJob.h \
+    BatchRunner.h
@@ -1,9 +1,18 @@
 #include "AsyncPathCalculator.h"
-#include <QDebug>
+#include "ConstructiveHamiltonianPath.h"
+#include "HamiltonianPathEngine.h"
+#include "HamiltonianMeetInTheMiddle.h"
+#include "HamiltonianPortfolio.h"
+#include "KShortestPathEngine.h"
+#include "Log.h"
+#include "Neighborhood.h"
+#include "ShortestPathDag.h"
 #include <QApplication>
+#include <QSet>
 #include <QThread>
 #include <QtMath>
 #include <algorithm>
+#include <type_traits>
 
 // PathCalculatorWorker 实现
 
@@ -12,6 +21,12 @@ PathCalculatorWorker::PathCalculatorWorker(QObject* parent)
     , m_isPaused(false)
     , m_isStopped(false)
     , m_isRunning(false)
+    , m_coverage(-1.0)
+    , m_progress(static_cast<quint64>(static_cast<quint32>(-1)) << 32)
+    , m_endCountsTask(-1)
+    , m_endCountsPending(false)
+    , m_pagerTaskId(-1)
+    , m_morePaths(false)
 {
 }
 
@@ -19,11 +34,6 @@ PathCalculatorWorker::~PathCalculatorWorker() {
     stopAllTasks();
 }
 
-void PathCalculatorWorker::setGrid(const QVector<QVector<GridPoint>>& grid) {
-    QMutexLocker locker(&m_taskMutex);
-    m_grid = grid;
-}
-
 void PathCalculatorWorker::addTask(const CalculationTask& task) {
     QMutexLocker locker(&m_taskMutex);
     m_taskQueue.enqueue(task);
@@ -65,12 +75,42 @@ void PathCalculatorWorker::stopAllTasks() {
 bool PathCalculatorWorker::getNextResult(CalculationResult& result) {
     QMutexLocker locker(&m_resultMutex);
     if (!m_resultQueue.isEmpty()) {
-        result = m_resultQueue.dequeue();
+        result = std::move(m_resultQueue.head());
+        m_resultQueue.removeFirst();
         return true;
     }
     return false;
 }
 
+void PathCalculatorWorker::setProgress(int taskId, int percentage) {
+    m_progress.store((static_cast<quint64>(static_cast<quint32>(taskId)) << 32) |
+                     static_cast<quint32>(percentage), std::memory_order_relaxed);
+}
+
+int PathCalculatorWorker::currentProgress(int& taskId) const {
+    const quint64 packed = m_progress.load(std::memory_order_relaxed);
+    taskId = static_cast<int>(static_cast<quint32>(packed >> 32));
+    return static_cast<int>(static_cast<quint32>(packed));
+}
+
+void PathCalculatorWorker::publishEndCounts(int taskId, const QVector<quint64>& counts) {
+    QMutexLocker locker(&m_endCountsMutex);
+    m_endCounts = counts;
+    m_endCountsTask = taskId;
+    m_endCountsPending = true;
+}
+
+bool PathCalculatorWorker::takeEndCounts(int& taskId, QVector<quint64>& counts) {
+    QMutexLocker locker(&m_endCountsMutex);
+    if (!m_endCountsPending) {
+        return false;
+    }
+    taskId = m_endCountsTask;
+    counts = m_endCounts;
+    m_endCountsPending = false;
+    return true;
+}
+
 int PathCalculatorWorker::getResultQueueSize() {
     QMutexLocker locker(&m_resultMutex);
     return m_resultQueue.size();
@@ -97,6 +137,15 @@ void PathCalculatorWorker::processNextTask() {
             task = m_taskQueue.dequeue();
         }
         
+        // 续取下一页沿用生成器所属任务的参数和网格快照，只换任务ID和预算
+        if (task.nextPage && m_pager) {
+            CalculationTask page = m_pager->task;
+            page.taskId = task.taskId;
+            page.budget = task.budget;
+            page.nextPage = true;
+            task = page;
+        }
+        
         // 处理任务
         if (!m_isStopped) {
             QMetaObject::invokeMethod(this, [this, task]() {
@@ -116,180 +165,593 @@ void PathCalculatorWorker::calculatePathAsync(const CalculationTask& task) {
     QElapsedTimer timer;
     timer.start();
     
-    QMetaObject::invokeMethod(this, [this, task]() {
-        emit taskProgress(task.taskId, 0);
-    }, Qt::QueuedConnection);
+    setProgress(task.taskId, 0);
     
     QVector<QPoint> path;
+    QString summary;
+    
+    m_snapshot = task.grid;
+    if (!m_snapshot) {
+        m_snapshot = GridSnapshot::create(GridModel());
+    }
+    m_stats.reset(m_snapshot->walkableCount());
+    m_budget = BudgetMeter(task.budget);
+    m_budget.start();
+    m_coverage = -1.0;
+    m_morePaths = false;
     
     try {
-        // 固定使用DFS算法
-        path = calculateDFS(task.start, task.end, task.taskId);
+        if (task.nextPage) {
+            // 生成器已按邻域特化，直接续取；生成器已释放时没有结果
+            if (m_pager) {
+                path = fetchPage(task, summary);
+            }
+        } else {
+            // 新任务开始时丢弃上一次枚举留下的生成器
+            m_pager.reset();
+            // 邻域只在这里分派一次，之后的搜索循环都是该邻域的特化版本
+            visitNeighborhood(task.neighborhood, [&](auto policy) {
+                typedef decltype(policy) Neighborhood;
+                switch (task.algorithm) {
+                    case AlgorithmType::AStar:
+                    case AlgorithmType::Dijkstra:
+                        // 按代价从小到大产出K条无环路径
+                        path = calculateKShortestPaths<Neighborhood>(task);
+                        break;
+                    case AlgorithmType::BFS:
+                        // 精确统计并枚举全部最短路径
+                        path = calculateAllShortestPaths<Neighborhood>(task, summary);
+                        break;
+                    case AlgorithmType::DFS:
+                    default:
+                        if (task.objective == PathObjective::EndCounts) {
+                            // 终点本来就是任意的，不受端点约束影响
+                            path = calculateEndCounts<Neighborhood>(task, summary);
+                        } else if (task.endpointMode != EndpointMode::Fixed) {
+                            // 端点自由时所有端点在一棵搜索树中枚举
+                            path = calculatePagedDFS<Neighborhood>(task, summary);
+                        } else if (task.objective == PathObjective::MinWeight) {
+                            path = calculateMinWeight<Neighborhood>(task, summary);
+                        } else if (task.objective == PathObjective::MinTurns) {
+                            path = calculateMinTurns<Neighborhood>(task, summary);
+                        } else if (task.objective == PathObjective::Construct) {
+                            path = calculateConstruct<Neighborhood>(task, summary);
+                        } else if (task.objective == PathObjective::Portfolio) {
+                            path = calculatePortfolio<Neighborhood>(task, summary);
+                        } else if (task.objective == PathObjective::MeetInTheMiddle) {
+                            path = calculateMeetInTheMiddle<Neighborhood>(task, summary);
+                        } else {
+                            // 按页产出，滚动到底时再续取下一页
+                            path = calculatePagedDFS<Neighborhood>(task, summary);
+                        }
+                        break;
+                }
+            });
+        }
     } catch (...) {
         // 处理异常
-        qDebug() << "计算过程中发生异常，任务ID:" << task.taskId;
+        QW_WARN(lcWorker) << "计算过程中发生异常，任务ID:" << task.taskId;
     }
     
     qint64 elapsed = timer.elapsed();
+    m_stats.finish();
+    
+    if (m_budget.isExhausted()) {
+        // 预算用完也是正常结束，报告放在摘要最前面
+        const QString report = budgetReport();
+        summary = summary.isEmpty() ? report : QString("%1；%2").arg(report, summary);
+        QW_INFO(lcWorker) << "任务" << task.taskId << report;
+    }
     
     if (!m_isStopped) {
-        // 添加最终结果
-        addFinalResult(task, path, elapsed);
-        QMetaObject::invokeMethod(this, [this, task, elapsed]() {
-            emit taskProgress(task.taskId, 100);
+        // 先写进度再放最终结果，界面取到最终结果时进度已是100
+        setProgress(task.taskId, 100);
+        addFinalResult(task, path, elapsed, summary);
+        QMetaObject::invokeMethod(this, [this, task]() {
             emit taskCompleted(task.taskId);
         }, Qt::QueuedConnection);
     }
 }
 
-QVector<QPoint> PathCalculatorWorker::calculateDFS(const QPoint& start, const QPoint& end, int taskId) {
-    // 前置检查：起点终点有效性
-    if (m_grid.isEmpty() || !isValidPoint(start) || !isValidPoint(end)) {
-        qDebug() << "前置检查失败: grid空=" << m_grid.isEmpty() 
-                 << "start有效=" << isValidPoint(start) 
-                 << "end有效=" << isValidPoint(end);
+template<class Neighborhood>
+QVector<QPoint> PathCalculatorWorker::calculateDFS(const CalculationTask& task, int maxPaths, QString& summary) {
+    const QPoint& start = task.start;
+    const QPoint& end = task.end;
+    const int taskId = task.taskId;
+    // 前置检查：起点终点有效性，端点自由时对应的点不参与
+    const bool needStart = task.endpointMode != EndpointMode::FreeBoth;
+    const bool needEnd = task.endpointMode == EndpointMode::Fixed;
+    if (m_snapshot->isEmpty() || (needStart && !isValidPoint(start)) || (needEnd && !isValidPoint(end))) {
+        QW_DEBUG(lcWorker) << "前置检查失败: grid空=" << m_snapshot->isEmpty()
+                           << "start有效=" << isValidPoint(start)
+                           << "end有效=" << isValidPoint(end);
         return QVector<QPoint>();
     }
     
-    // 计算总的可通行点数量
-    int totalPassableCells = 0;
-    for (int i = 0; i < m_grid.size(); i++) {
-        for (int j = 0; j < m_grid[0].size(); j++) {
-            if (m_grid[i][j].isWalkable()) {
-                totalPassableCells++;
-            }
+    BasicHamiltonianPathEngine<Neighborhood> engine(grid());
+    engine.setPruning(HamiltonianPathEngine::PruneAll);
+    engine.setMoveOrder(task.moveOrder, static_cast<quint32>(taskId));
+    engine.setEndpointMode(task.endpointMode);
+    engine.setStats(&m_stats);
+    const int totalPassableCells = engine.walkableCount();
+    
+    QW_INFO(lcWorker) << "开始查找哈密顿路径 - 起点:" << start << "终点:" << end
+                      << "展开顺序:" << moveOrderToString(task.moveOrder)
+                      << "端点:" << endpointModeToString(task.endpointMode);
+    QW_DEBUG(lcWorker) << "网格大小:" << m_snapshot->height() << "x" << m_snapshot->width()
+                       << "版本:" << m_snapshot->version() << "可通行点数量:" << totalPassableCells;
+    
+    // 检查点：响应暂停/停止和预算，并按搜索深度估算进度
+    engine.setCheckpoint([this, &engine, taskId, totalPassableCells]() {
+        setProgress(taskId, (engine.depth() * 80) / totalPassableCells);
+        return keepRunning(engine.expandedSoFar());
+    });
+    
+    QElapsedTimer timer;
+    timer.start();
+    qint64 firstPathMs = -1;
+    QVector<QPoint> firstPath;
+    int found = 0;
+    QSet<QPair<int, int>> endpointPairs;   // 端点自由时统计出现过的端点组合
+    engine.findPaths(start, end, maxPaths, [&](const QVector<QPoint>& path) {
+        if (firstPath.isEmpty()) {
+            firstPath = path;
+            firstPathMs = timer.elapsed();
+        }
+        endpointPairs.insert(qMakePair(grid().index(path.first()), grid().index(path.last())));
+        // 立即将这条路径放入结果队列，供主线程取出并显示；结果的端点取路径首尾
+        addPartialPathResult(path.first(), path.last(), path, ++found, -1, taskId); // -1表示总数未知，正在计算中
+        m_budget.addPath(path);
+        return !m_isStopped && m_budget.withinBudget(engine.expandedSoFar());
+    });
+    m_coverage = engine.coverage();
+    
+    QW_INFO(lcWorker) << "找到哈密顿路径数量:" << found << "首条路径用时:" << firstPathMs << "ms";
+    if (firstPath.isEmpty()) {
+        QW_DEBUG(lcWorker) << "未找到哈密顿路径";
+    } else {
+        summary = QString("首条路径 %1 ms（%2）").arg(firstPathMs).arg(moveOrderToString(task.moveOrder));
+        if (task.endpointMode != EndpointMode::Fixed) {
+            summary += QString("，%1 组不同端点").arg(endpointPairs.size());
         }
     }
+    return firstPath;
+}
+
+template<class Neighborhood>
+QVector<QPoint> PathCalculatorWorker::calculatePagedDFS(const CalculationTask& task, QString& summary) {
+    // 前置检查与calculateDFS相同
+    const bool needStart = task.endpointMode != EndpointMode::FreeBoth;
+    const bool needEnd = task.endpointMode == EndpointMode::Fixed;
+    if (m_snapshot->isEmpty() || (needStart && !isValidPoint(task.start)) || (needEnd && !isValidPoint(task.end))) {
+        return QVector<QPoint>();
+    }
     
-    qDebug() << "开始查找哈密顿路径 - 起点:" << start << "终点:" << end;
-    qDebug() << "网格大小:" << m_grid.size() << "x" << m_grid[0].size() << "可通行点数量:" << totalPassableCells;
+    typedef BasicHamiltonianPathEngine<Neighborhood> Engine;
+    std::shared_ptr<Engine> engine = std::make_shared<Engine>(grid());
+    engine->setPruning(HamiltonianPathEngine::PruneAll);
+    engine->setMoveOrder(task.moveOrder, static_cast<quint32>(task.taskId));
+    engine->setEndpointMode(task.endpointMode);
+    engine->setStats(&m_stats);
+    // 续取时也会调用，进度和预算按当前一页计；闭包只持有裸指针，避免引擎引用自身
+    Engine* raw = engine.get();
+    const int totalPassableCells = engine->walkableCount();
+    engine->setCheckpoint([this, raw, totalPassableCells]() {
+        setProgress(m_pagerTaskId, (raw->depth() * 80) / totalPassableCells);
+        return keepRunning(raw->expandedSoFar() - m_pager->pageStartNodes);
+    });
     
-    // 使用您提供的哈密顿路径算法查找所有路径
-    QVector<QVector<QPoint>> allPaths;
-    QVector<QPoint> currentPath;
-    QVector<QVector<bool>> visited(m_grid.size(), QVector<bool>(m_grid[0].size(), false));
+    QW_INFO(lcWorker) << "开始分页枚举哈密顿路径 - 起点:" << task.start << "终点:" << task.end
+                      << "展开顺序:" << moveOrderToString(task.moveOrder)
+                      << "端点:" << endpointModeToString(task.endpointMode);
+    if (!engine->beginPaths(task.start, task.end)) {
+        m_coverage = engine->coverage();
+        QW_DEBUG(lcWorker) << "未找到哈密顿路径";
+        return QVector<QPoint>();
+    }
     
-    // 开始哈密顿DFS搜索
-    findHamiltonianPathsDFS(start.y(), start.x(), end.y(), end.x(), totalPassableCells,
-                           currentPath, allPaths, visited, taskId);
+    m_pager.reset(new PathPager);
+    m_pager->task = task;
+    m_pager->delivered = 0;
+    m_pager->pageStartNodes = 0;
+    m_pager->next = [engine](int count, const std::function<bool(const QVector<QPoint>&)>& onPath) {
+        return engine->nextPaths(count, onPath);
+    };
+    m_pager->exhausted = [engine]() { return engine->pathsExhausted(); };
+    m_pager->expandedSoFar = [engine]() { return engine->expandedSoFar(); };
+    m_pager->coverage = [engine]() { return engine->coverage(); };
+    return fetchPage(task, summary);
+}
+
+QVector<QPoint> PathCalculatorWorker::fetchPage(const CalculationTask& task, QString& summary) {
+    PathPager& pager = *m_pager;
+    m_pagerTaskId = task.taskId;
+    pager.pageStartNodes = pager.expandedSoFar();
+    const int count = qMin(Constants::PATH_PAGE_SIZE, pager.task.maxPaths - pager.delivered);
     
-    qDebug() << "找到哈密顿路径数量:" << allPaths.size();
+    QElapsedTimer timer;
+    timer.start();
+    qint64 firstPathMs = -1;
+    QVector<QPoint> firstPath;
+    const int before = pager.delivered;
+    pager.next(count, [&](const QVector<QPoint>& path) {
+        if (firstPath.isEmpty()) {
+            firstPath = path;
+            firstPathMs = timer.elapsed();
+        }
+        pager.endpointPairs.insert(qMakePair(grid().index(path.first()), grid().index(path.last())));
+        // 结果的端点取路径首尾；编号接着上一页
+        addPartialPathResult(path.first(), path.last(), path, ++pager.delivered, -1, task.taskId);
+        m_budget.addPath(path);
+        return !m_isStopped && m_budget.withinBudget(pager.expandedSoFar() - pager.pageStartNodes);
+    });
+    m_coverage = pager.coverage();
+    m_morePaths = !m_isStopped && !pager.exhausted() && pager.delivered < pager.task.maxPaths;
     
-    // 返回第一条路径（如果有的话）
-    // 注意：所有路径已经在计算过程中通过 addPartialPathResult 放入队列了
-    if (!allPaths.isEmpty()) {
-        return allPaths.first();
+    QW_INFO(lcWorker) << "本页产出路径:" << pager.delivered - before << "累计:" << pager.delivered
+                      << "首条路径用时:" << firstPathMs << "ms" << "还有下一页:" << m_morePaths;
+    if (!firstPath.isEmpty()) {
+        summary = QString("首条路径 %1 ms（%2），累计 %3 条").arg(firstPathMs)
+                  .arg(moveOrderToString(pager.task.moveOrder)).arg(pager.delivered);
+        if (pager.task.endpointMode != EndpointMode::Fixed) {
+            summary += QString("，%1 组不同端点").arg(pager.endpointPairs.size());
+        }
+    }
+    if (m_morePaths) {
+        summary += summary.isEmpty() ? "滚动到底部或点击“加载更多”继续" : "，滚动到底部或点击“加载更多”继续";
+    } else {
+        // 取完或到达路径上限，释放生成器
+        m_pager.reset();
     }
+    return firstPath;
+}
+
+template<class Neighborhood>
+QVector<QPoint> PathCalculatorWorker::calculateMinWeight(const CalculationTask& task, QString& summary) {
+    if (m_snapshot->isEmpty() || !isValidPoint(task.start) || !isValidPoint(task.end)) {
+        return QVector<QPoint>();
+    }
+    
+    BasicHamiltonianPathEngine<Neighborhood> engine(grid());
+    engine.setPruning(HamiltonianPathEngine::PruneAll);
+    engine.setStats(&m_stats);
+    const int totalPassableCells = engine.walkableCount();
+    engine.setCheckpoint([this, &engine, &task, totalPassableCells]() {
+        setProgress(task.taskId, (engine.depth() * 80) / totalPassableCells);
+        return keepRunning(engine.expandedSoFar());
+    });
     
-    qDebug() << "未找到哈密顿路径";
-    return QVector<QPoint>();
+    QW_INFO(lcWorker) << "开始最小代价哈密顿路径搜索 - 起点:" << task.start << "终点:" << task.end;
+    
+    // 每次改进都作为部分结果送出，停止时界面上已有当前最优
+    QVector<QPoint> bestPath;
+    int improvements = 0;
+    const double bestCost = engine.findMinimumCost(task.start, task.end,
+                                                   HamiltonianPathEngine::gradientCost(grid()),
+                                                   [&](const QVector<QPoint>& path, double cost) {
+        bestPath = path;
+        ++improvements;
+        PathResult result(QString("当前最优_%1 (代价 %2)").arg(improvements).arg(cost),
+                          task.start, task.end, path, task.algorithm, 0);
+        {
+            QMutexLocker locker(&m_resultMutex);
+            m_resultQueue.enqueue(CalculationResult(std::move(result), task.taskId, false, true));
+        }
+        m_budget.addPath(path);
+        return !m_isStopped && m_budget.withinBudget(engine.expandedSoFar());
+    });
+    m_coverage = engine.coverage();
+    
+    if (bestCost >= 0.0) {
+        summary = QString("最小代价 %1（改进 %2 次）").arg(bestCost).arg(improvements);
+    }
+    QW_INFO(lcWorker) << "最小代价搜索结束，代价:" << bestCost << "改进次数:" << improvements;
+    return bestPath;
 }
 
+template<class Neighborhood>
+QVector<QPoint> PathCalculatorWorker::calculateMinTurns(const CalculationTask& task, QString& summary) {
+    if (m_snapshot->isEmpty() || !isValidPoint(task.start) || !isValidPoint(task.end)) {
+        return QVector<QPoint>();
+    }
+    
+    BasicHamiltonianPathEngine<Neighborhood> engine(grid());
+    engine.setPruning(HamiltonianPathEngine::PruneAll);
+    engine.setStats(&m_stats);
+    const int totalPassableCells = engine.walkableCount();
+    engine.setCheckpoint([this, &engine, &task, totalPassableCells]() {
+        setProgress(task.taskId, (engine.depth() * 80) / totalPassableCells);
+        return keepRunning(engine.expandedSoFar());
+    });
+    
+    QW_INFO(lcWorker) << "开始最少转弯哈密顿路径搜索 - 起点:" << task.start << "终点:" << task.end;
+    
+    QVector<QPoint> bestPath;
+    int improvements = 0;
+    const int bestTurns = engine.findMinimumTurns(task.start, task.end,
+                                                  [&](const QVector<QPoint>& path, int turns) {
+        bestPath = path;
+        ++improvements;
+        PathResult result(QString("当前最优_%1 (转弯 %2)").arg(improvements).arg(turns),
+                          task.start, task.end, path, task.algorithm, 0);
+        {
+            QMutexLocker locker(&m_resultMutex);
+            m_resultQueue.enqueue(CalculationResult(std::move(result), task.taskId, false, true));
+        }
+        m_budget.addPath(path);
+        return !m_isStopped && m_budget.withinBudget(engine.expandedSoFar());
+    });
+    m_coverage = engine.coverage();
+    
+    if (bestTurns >= 0) {
+        summary = QString("最少转弯 %1（改进 %2 次）").arg(bestTurns).arg(improvements);
+    }
+    QW_INFO(lcWorker) << "最少转弯搜索结束，转弯:" << bestTurns << "改进次数:" << improvements;
+    return bestPath;
+}
 
+template<class Neighborhood>
+QVector<QPoint> PathCalculatorWorker::calculateConstruct(const CalculationTask& task, QString& summary) {
+    if (m_snapshot->isEmpty() || !isValidPoint(task.start) || !isValidPoint(task.end)) {
+        return QVector<QPoint>();
+    }
+    
+    // 构造规则只适用于四邻域，其他邻域直接搜索第一条
+    if (std::is_same<Neighborhood, Neighborhoods::Four>::value) {
+        ConstructiveHamiltonianPath construction(grid());
+        QVector<QPoint> path;
+        const ConstructiveHamiltonianPath::Outcome outcome = construction.construct(task.start, task.end, path);
+        QW_INFO(lcWorker) << "构造哈密顿路径 - 起点:" << task.start << "终点:" << task.end << "结果:" << outcome;
+        if (outcome == ConstructiveHamiltonianPath::Constructed) {
+            addPartialPathResult(task.start, task.end, path, 1, 1, task.taskId);
+            summary = "按规则构造";
+            return path;
+        }
+        if (outcome == ConstructiveHamiltonianPath::NoPath) {
+            summary = "按存在性规则判定无解";
+            return QVector<QPoint>();
+        }
+        summary = "区域形状超出构造范围，已改为搜索";
+    } else {
+        summary = "构造只支持四邻域，已改为搜索";
+    }
+    QString searchSummary;
+    return calculateDFS<Neighborhood>(task, 1, searchSummary);
+}
 
-bool PathCalculatorWorker::isValidPoint(const QPoint& point) const {
-    return point.x() >= 0 && point.x() < m_grid[0].size() &&
-           point.y() >= 0 && point.y() < m_grid.size() &&
-           m_grid[point.y()][point.x()].isWalkable();
+template<class Neighborhood>
+QVector<QPoint> PathCalculatorWorker::calculatePortfolio(const CalculationTask& task, QString& summary) {
+    if (m_snapshot->isEmpty() || !isValidPoint(task.start) || !isValidPoint(task.end)) {
+        return QVector<QPoint>();
+    }
+    
+    BasicHamiltonianPortfolio<Neighborhood> portfolio(grid());
+    portfolio.setStats(&m_stats);
+    portfolio.setCheckpoint([this, &portfolio]() {
+        return keepRunning(portfolio.expandedSoFar());
+    });
+    
+    QW_INFO(lcWorker) << "开始多策略竞速 - 起点:" << task.start << "终点:" << task.end;
+    const typename BasicHamiltonianPortfolio<Neighborhood>::Result result = portfolio.run(task.start, task.end);
+    if (!result.decided) {
+        return QVector<QPoint>();
+    }
+    
+    const QString winner = portfolioStrategyToString(result.winner);
+    QW_INFO(lcWorker) << "竞速结束，胜出策略:" << winner << "用时:" << result.elapsedMs << "ms"
+                      << "扩展节点:" << result.expandedNodes;
+    if (result.path.isEmpty()) {
+        summary = QString("无解（%1 判定）").arg(winner);
+    } else {
+        addPartialPathResult(task.start, task.end, result.path, 1, 1, task.taskId);
+        summary = QString("%1 胜出，用时 %2 ms").arg(winner).arg(result.elapsedMs);
+    }
+    return result.path;
 }
 
-QVector<QPoint> PathCalculatorWorker::getNeighbors(const QPoint& point) const {
-    QVector<QPoint> neighbors;
-    const int dx[] = {-1, 1, 0, 0};  // 左、右、上、下
-    const int dy[] = {0, 0, -1, 1};
+template<class Neighborhood>
+QVector<QPoint> PathCalculatorWorker::calculateMeetInTheMiddle(const CalculationTask& task, QString& summary) {
+    if (m_snapshot->isEmpty() || !isValidPoint(task.start) || !isValidPoint(task.end)) {
+        return QVector<QPoint>();
+    }
     
-    for (int i = 0; i < 4; ++i) {
-        QPoint neighbor(point.x() + dx[i], point.y() + dy[i]);
-        if (isValidPoint(neighbor)) {
-            neighbors.append(neighbor);
-        }
+    BasicHamiltonianMeetInTheMiddle<Neighborhood> search(grid());
+    if (!search.isSupported()) {
+        // 位集放不下全部格子，退回单向DFS
+        QW_INFO(lcWorker) << "可通行格子" << search.walkableCount() << "超过折半搜索上限，改为DFS";
+        summary = QString("可通行格子超过 %1，已改为DFS").arg(BasicHamiltonianMeetInTheMiddle<Neighborhood>::MAX_CELLS);
+        QString searchSummary;
+        return calculateDFS<Neighborhood>(task, task.maxPaths, searchSummary);
     }
+    search.setStats(&m_stats);
+    // 内存预算同时约束连接表，放不下时分批流式连接
+    search.setMemoryLimit(task.budget.maxMemoryBytes);
+    search.setCheckpoint([this, &search]() {
+        return keepRunning(search.expandedSoFar());
+    });
+    
+    QW_INFO(lcWorker) << "开始折半搜索哈密顿路径 - 起点:" << task.start << "终点:" << task.end
+                      << "可通行点数量:" << search.walkableCount();
     
-    return neighbors;
+    QVector<QPoint> firstPath;
+    int found = 0;
+    search.findPaths(task.start, task.end, task.maxPaths, [&](const QVector<QPoint>& path) {
+        if (firstPath.isEmpty()) {
+            firstPath = path;
+        }
+        addPartialPathResult(task.start, task.end, path, ++found, -1, task.taskId);
+        m_budget.addPath(path);
+        return !m_isStopped && m_budget.withinBudget(search.expandedSoFar());
+    });
+    
+    QW_INFO(lcWorker) << "折半搜索结束，路径数量:" << found << "连接批数:" << search.passes()
+                      << "连接表:" << search.tableBytes() << "字节" << "扩展节点:" << search.expandedNodes();
+    if (search.passes() > 0) {
+        summary = QString("折半搜索：%1 批连接，连接表约 %2 KB").arg(search.passes()).arg(search.tableBytes() / 1024);
+    }
+    return firstPath;
 }
 
-// 基于您提供的哈密顿路径算法的Qt版本实现
-void PathCalculatorWorker::findHamiltonianPathsDFS(int x, int y, int endX, int endY, int totalPassableCells,
-                                                  QVector<QPoint>& currentPath, QVector<QVector<QPoint>>& allPaths,
-                                                  QVector<QVector<bool>>& visited, int taskId) {
-    // 检查是否被停止 - 在递归开始时立即检查
-    if (m_isStopped || allPaths.size() >= 5000) { // 增加限制到5000条哈密顿路径
-        return;
+template<class Neighborhood>
+QVector<QPoint> PathCalculatorWorker::calculateEndCounts(const CalculationTask& task, QString& summary) {
+    if (m_snapshot->isEmpty() || !isValidPoint(task.start)) {
+        return QVector<QPoint>();
     }
     
-    // 检查暂停状态，但要快速响应停止信号
-    if (m_isPaused && !m_isStopped) {
-        QMutexLocker locker(&m_taskMutex);
-        while (m_isPaused && !m_isStopped) {
-            m_taskCondition.wait(&m_taskMutex, 50); // 减少等待时间到50ms
+    BasicHamiltonianPathEngine<Neighborhood> engine(grid());
+    engine.setPruning(HamiltonianPathEngine::PruneAll);
+    engine.setMoveOrder(task.moveOrder, static_cast<quint32>(task.taskId));
+    engine.setStats(&m_stats);
+    const int totalPassableCells = engine.walkableCount();
+    // 检查点中按间隔把各终点目前的计数发布给界面画热力图
+    QElapsedTimer publishClock;
+    publishClock.start();
+    engine.setCheckpoint([&]() {
+        setProgress(task.taskId, (engine.depth() * 80) / totalPassableCells);
+        if (publishClock.elapsed() >= END_COUNTS_INTERVAL_MS) {
+            publishClock.restart();
+            publishEndCounts(task.taskId, engine.endCountsSoFar());
+        }
+        return keepRunning(engine.expandedSoFar());
+    });
+    
+    QW_INFO(lcWorker) << "开始按终点统计哈密顿路径 - 起点:" << task.start;
+    
+    // 前maxPaths条路径照常送出，之后只计数
+    QVector<QPoint> firstPath;
+    int found = 0;
+    QVector<quint64> counts;
+    const quint64 total = engine.countPathsByEnd(task.start, counts, task.maxPaths,
+                                                 [&](const QVector<QPoint>& path) {
+        if (firstPath.isEmpty()) {
+            firstPath = path;
         }
-        // 暂停恢复后再次检查停止状态
-        if (m_isStopped) {
-            return;
+        addPartialPathResult(task.start, path.last(), path, ++found, -1, task.taskId);
+        m_budget.addPath(path);
+        return !m_isStopped && m_budget.withinBudget(engine.expandedSoFar());
+    });
+    m_coverage = engine.coverage();
+    publishEndCounts(task.taskId, counts);
+    
+    int reachable = 0;
+    int busiest = -1;
+    for (int i = 0; i < counts.size(); ++i) {
+        if (counts[i] > 0) {
+            ++reachable;
+            if (busiest < 0 || counts[i] > counts[busiest]) {
+                busiest = i;
+            }
         }
     }
+    QW_INFO(lcWorker) << "按终点统计完成，路径总数:" << total << "可达终点:" << reachable;
+    summary = QString("按终点统计：共 %1 条路径，%2 个终点").arg(total).arg(reachable);
+    if (busiest >= 0) {
+        const QPoint cell = grid().toPoint(busiest);
+        summary += QString("，最多的终点 (%1,%2) %3 条").arg(cell.x()).arg(cell.y()).arg(counts[busiest]);
+    }
+    return firstPath;
+}
+
+template<class Neighborhood>
+QVector<QPoint> PathCalculatorWorker::calculateKShortestPaths(const CalculationTask& task) {
+    if (m_snapshot->isEmpty() || !isValidPoint(task.start) || !isValidPoint(task.end)) {
+        return QVector<QPoint>();
+    }
     
-    // 标记当前位置为已访问
-    visited[x][y] = true;
-    currentPath.append(QPoint(y, x)); // 注意：QPoint是(x,y)，但我们的坐标是(row,col)
+    typedef BasicKShortestPathEngine<Neighborhood> Engine;
+    Engine engine(grid());
+    engine.setSpurSearch(task.algorithm == AlgorithmType::AStar
+                         ? Engine::SpurSearch::AStar
+                         : Engine::SpurSearch::Dijkstra);
+    // 引擎内部只有扩展节点总数，按增量写入统计
+    quint64 reportedNodes = 0;
+    auto flushNodes = [this, &engine, &reportedNodes]() {
+        m_stats.addNodes(engine.expandedNodes() - reportedNodes);
+        reportedNodes = engine.expandedNodes();
+    };
+    engine.setCheckpoint([this, &engine, &flushNodes]() {
+        flushNodes();
+        return keepRunning(engine.expandedNodes());
+    });
     
-    // 进度更新
-    if (currentPath.size() % 3 == 0) {
-        int progress = (currentPath.size() * 80) / totalPassableCells;
-        QMetaObject::invokeMethod(this, [this, taskId, progress]() {
-            emit taskProgress(taskId, progress);
-        }, Qt::QueuedConnection);
+    QVector<QPoint> firstPath;
+    int found = 0;
+    engine.findPaths(task.start, task.end, task.maxPaths,
+                     [&](const QVector<QPoint>& path, double cost) {
+        if (firstPath.isEmpty()) {
+            firstPath = path;
+        }
+        ++found;
+        flushNodes();
+        m_stats.addPaths(1);
+        m_stats.updateMaxDepth(path.size());
+        m_stats.addDepthSamples(m_stats.depthBucket(path.size()), 1);
+        // 每条路径找到后立即放入结果队列，按代价顺序流式显示
+        addRankedPathResult(task, path, found, cost);
+        setProgress(task.taskId, (found * 100) / task.maxPaths);
+        m_budget.addPath(path);
+        return !m_isStopped && m_budget.withinBudget(engine.expandedNodes());
+    });
+    
+    flushNodes();
+    QW_INFO(lcWorker) << "K最短路径搜索完成，找到路径数量:" << found;
+    return firstPath;
+}
+
+template<class Neighborhood>
+QVector<QPoint> PathCalculatorWorker::calculateAllShortestPaths(const CalculationTask& task, QString& summary) {
+    if (m_snapshot->isEmpty() || !isValidPoint(task.start) || !isValidPoint(task.end)) {
+        return QVector<QPoint>();
     }
     
-    // 到达终点且访问了所有可通行点（哈密顿路径条件）
-    if (x == endX && y == endY && currentPath.size() == totalPassableCells) {
-        allPaths.append(currentPath);
-        qDebug() << "找到哈密顿路径" << allPaths.size() << "，长度:" << currentPath.size();
-        
-        // 立即将这条路径放入结果队列，供主线程取出并显示
-        // 注意：currentPath中的QPoint已经是正确的(x,y)坐标了
-        QPoint start = currentPath.first();
-        QPoint end = currentPath.last();
-        addPartialPathResult(start, end, currentPath, allPaths.size(), -1, taskId); // -1表示总数未知，正在计算中
-        
-        // 回溯
-        visited[x][y] = false;
-        currentPath.removeLast();
-        return;
+    BasicShortestPathDag<Neighborhood> dag(grid());
+    const bool reachable = dag.build(task.start, task.end);
+    m_stats.addNodes(dag.expandedNodes());
+    if (!reachable) {
+        return QVector<QPoint>();
     }
     
-    // 如果还没有访问完所有可通行点，继续搜索
-    if (currentPath.size() < totalPassableCells) {
-        // 四个方向：上、下、左、右
-        const int dx[4] = {-1, 1, 0, 0};
-        const int dy[4] = {0, 0, -1, 1};
+    // 总数由DAG精确计数得到，可能远超64位
+    const QString totalText = dag.pathCount().toString();
+    const int expected = dag.pathCount().greaterThan(static_cast<quint64>(task.maxPaths))
+                         ? task.maxPaths
+                         : static_cast<int>(dag.pathCount().toUInt64());
+    summary = QString("共 %1 条最短路径（%2 步），显示前 %3 条")
+              .arg(totalText).arg(dag.distance()).arg(expected);
+    QW_INFO(lcWorker) << "最短路径DAG: 节点" << dag.nodeCount() << "边" << dag.edgeCount()
+                      << "最短路径总数" << totalText;
+    
+    QVector<QPoint> firstPath;
+    int produced = 0;
+    dag.enumerate(task.maxPaths, [&](const QVector<QPoint>& path) {
+        if (firstPath.isEmpty()) {
+            firstPath = path;
+        }
+        ++produced;
+        m_stats.addPaths(1);
+        m_stats.updateMaxDepth(path.size());
+        m_stats.addDepthSamples(m_stats.depthBucket(path.size()), 1);
         
-        // 尝试四个方向
-        for (int i = 0; i < 4; i++) {
-            // 在每次循环迭代中检查停止标志
-            if (m_isStopped || allPaths.size() >= 5000) {
-                break; // 立即退出循环
-            }
-            
-            int newX = x + dx[i];
-            int newY = y + dy[i];
-            
-            if (isValidDFS(newX, newY, visited)) {
-                findHamiltonianPathsDFS(newX, newY, endX, endY, totalPassableCells,
-                                      currentPath, allPaths, visited, taskId);
-            }
+        PathResult result(QString("最短路径_%1/%2").arg(produced).arg(totalText),
+                          task.start, task.end, path, task.algorithm, 0);
+        {
+            QMutexLocker locker(&m_resultMutex);
+            m_resultQueue.enqueue(CalculationResult(std::move(result), task.taskId, false, true));
         }
-    }
+        
+        setProgress(task.taskId, (produced * 100) / expected);
+        
+        m_budget.addPath(path);
+        return keepRunning(dag.expandedNodes());
+    });
     
-    // 回溯
-    visited[x][y] = false;
-    currentPath.removeLast();
+    return firstPath;
 }
 
-bool PathCalculatorWorker::isValidDFS(int x, int y, const QVector<QVector<bool>>& visited) const {
-    return x >= 0 && x < m_grid.size() && 
-           y >= 0 && y < m_grid[0].size() && 
-           m_grid[x][y].isWalkable() && !visited[x][y];
+
+
+bool PathCalculatorWorker::isValidPoint(const QPoint& point) const {
+    return grid().isWalkable(point);
 }
 
 void PathCalculatorWorker::addPartialResult(const CalculationTask& task, 
@@ -297,10 +759,10 @@ void PathCalculatorWorker::addPartialResult(const CalculationTask& task,
     PathResult result(QString("部分结果_%1_%2").arg(task.taskId).arg(progress),
                      task.start, task.end, partialPath, task.algorithm, 0);
     
-    CalculationResult calcResult(result, task.taskId, false, true);
+    CalculationResult calcResult(std::move(result), task.taskId, false, true);
     
     QMutexLocker locker(&m_resultMutex);
-    m_resultQueue.enqueue(calcResult);
+    m_resultQueue.enqueue(std::move(calcResult));
 }
 
 void PathCalculatorWorker::addPartialPathResult(const QPoint& start, const QPoint& end,
@@ -317,23 +779,57 @@ void PathCalculatorWorker::addPartialPathResult(const QPoint& start, const QPoin
     
     PathResult result(resultName, start, end, path, AlgorithmType::DFS, 0);
     
-    CalculationResult calcResult(result, taskId, false, true);
+    CalculationResult calcResult(std::move(result), taskId, false, true);
+    {
+        QMutexLocker locker(&m_resultMutex);
+        m_resultQueue.enqueue(std::move(calcResult));
+    }
     
-    QMutexLocker locker(&m_resultMutex);
-    m_resultQueue.enqueue(calcResult);
+    QW_TRACE_RATE(lcWorker, 10) << "添加哈密顿路径到结果队列:" << resultName << "路径长度:" << path.size();
+}
+
+void PathCalculatorWorker::addRankedPathResult(const CalculationTask& task, const QVector<QPoint>& path,
+                                               int rank, double cost) {
+    QString resultName = QString("第%1短路径 (代价 %2)").arg(rank).arg(cost);
+    PathResult result(resultName, task.start, task.end, path, task.algorithm, 0);
+    
+    CalculationResult calcResult(std::move(result), task.taskId, false, true);
     
-    qDebug() << "添加哈密顿路径到结果队列:" << resultName << "路径长度:" << path.size();
+    QMutexLocker locker(&m_resultMutex);
+    m_resultQueue.enqueue(std::move(calcResult));
 }
 
 void PathCalculatorWorker::addFinalResult(const CalculationTask& task, 
-                                        const QVector<QPoint>& finalPath, qint64 elapsed) {
+                                        const QVector<QPoint>& finalPath, qint64 elapsed,
+                                        const QString& summary) {
     QString resultName = QString("任务_%1_最终结果").arg(task.taskId);
+    if (!summary.isEmpty()) {
+        resultName += QString(" - %1").arg(summary);
+    }
     PathResult result(resultName, task.start, task.end, finalPath, task.algorithm, elapsed);
     
-    CalculationResult calcResult(result, task.taskId, true, false);
+    CalculationResult calcResult(std::move(result), task.taskId, true, false);
+    calcResult.budgetExhausted = m_budget.isExhausted();
+    calcResult.morePaths = m_morePaths;
     
     QMutexLocker locker(&m_resultMutex);
-    m_resultQueue.enqueue(calcResult);
+    m_resultQueue.enqueue(std::move(calcResult));
+}
+
+bool PathCalculatorWorker::keepRunning(quint64 nodes) {
+    waitForResume();
+    return !m_isStopped && m_budget.withinBudget(nodes);
+}
+
+QString PathCalculatorWorker::budgetReport() const {
+    const SearchStats::Snapshot stats = m_stats.snapshot();
+    QString report = QString("预算用尽（%1）：已找到 %2 条路径，扩展 %3 个节点")
+                     .arg(BudgetMeter::resourceDisplayName(m_budget.exhausted()))
+                     .arg(stats.paths).arg(stats.nodes);
+    if (m_coverage >= 0.0) {
+        report += QString("，估计覆盖 %1%").arg(QString::number(m_coverage * 100.0, 'g', 3));
+    }
+    return report;
 }
 
 void PathCalculatorWorker::waitForResume() {
@@ -353,7 +849,16 @@ AsyncPathCalculator::AsyncPathCalculator(QObject* parent)
     , m_workerThread(nullptr)
     , m_resultTimer(nullptr)
     , m_nextTaskId(1)
+    , m_lastProgressTask(-1)
+    , m_lastProgress(-1)
+    , m_neighborhood(NeighborhoodType::Four)
+    , m_moveOrder(MoveOrder::Natural)
+    , m_endpointMode(EndpointMode::Fixed)
+    , m_hasMorePaths(false)
 {
+    // 路径结果隐式共享，注册后可经排队连接传递而不深拷贝路径
+    qRegisterMetaType<PathResult>();
+    
     // 创建结果检查定时器
     m_resultTimer = new QTimer(this);
     connect(m_resultTimer, &QTimer::timeout, this, &AsyncPathCalculator::checkResults);
@@ -382,19 +887,22 @@ AsyncPathCalculator::~AsyncPathCalculator() {
     }
 }
 
-void AsyncPathCalculator::setGrid(const QVector<QVector<GridPoint>>& grid) {
-    // 保存网格数据
-    m_gridData = grid;
-    
-    if (m_worker) {
-        m_worker->setGrid(grid);
-    }
+void AsyncPathCalculator::setGrid(const GridSnapshotPtr& snapshot) {
+    m_snapshot = snapshot;
 }
 
-int AsyncPathCalculator::addCalculationTask(const QPoint& start, const QPoint& end, AlgorithmType algorithm) {
+int AsyncPathCalculator::addCalculationTask(const QPoint& start, const QPoint& end, AlgorithmType algorithm,
+                                            int maxPaths, PathObjective objective) {
     int taskId = getNextTaskId();
-    CalculationTask task(start, end, algorithm, taskId);
+    CalculationTask task(start, end, algorithm, taskId, maxPaths, objective);
+    task.grid = m_snapshot;
+    task.neighborhood = m_neighborhood;
+    task.moveOrder = m_moveOrder;
+    task.endpointMode = m_endpointMode;
+    task.budget = m_budget;
     
+    // 新任务开始时worker丢弃上一次枚举的生成器
+    m_hasMorePaths = false;
     if (m_worker) {
         m_worker->addTask(task);
     }
@@ -402,6 +910,21 @@ int AsyncPathCalculator::addCalculationTask(const QPoint& start, const QPoint& e
     return taskId;
 }
 
+int AsyncPathCalculator::fetchMorePaths() {
+    if (!m_hasMorePaths || !m_worker) {
+        return -1;
+    }
+    m_hasMorePaths = false;
+    // 其余参数由worker从生成器所属的任务沿用
+    CalculationTask task;
+    task.taskId = getNextTaskId();
+    task.algorithm = AlgorithmType::DFS;
+    task.budget = m_budget;
+    task.nextPage = true;
+    m_worker->addTask(task);
+    return task.taskId;
+}
+
 void AsyncPathCalculator::pauseAllCalculations() {
     if (m_worker) {
         m_worker->pauseCalculation();
@@ -420,7 +943,7 @@ void AsyncPathCalculator::stopAllCalculations() {
         stopResultChecker();
         
         // 激进停止策略：直接终止线程并重新创建
-        qDebug() << "正在强制停止工作线程...";
+        QW_INFO(lcWorker) << "正在强制停止工作线程...";
         
         // 立即终止线程
         if (m_workerThread->isRunning()) {
@@ -428,8 +951,11 @@ void AsyncPathCalculator::stopAllCalculations() {
             m_workerThread->wait(500); // 只等待500ms
         }
         
-        // 清理旧的worker和线程
+        // 清理旧的worker和线程，生成器随worker一起销毁
+        m_hasMorePaths = false;
         if (m_worker) {
+            m_lastStats = m_worker->statsSnapshot();
+            m_lastStats.running = false;
             delete m_worker;
             m_worker = nullptr;
         }
@@ -440,7 +966,7 @@ void AsyncPathCalculator::stopAllCalculations() {
         // 重新创建工作线程和worker
         recreateWorkerThread();
         
-        qDebug() << "工作线程已重新创建";
+        QW_DEBUG(lcWorker) << "工作线程已重新创建";
         
         // 发出停止完成信号
         emit allCalculationsFinished();
@@ -448,7 +974,7 @@ void AsyncPathCalculator::stopAllCalculations() {
 }
 
 void AsyncPathCalculator::recreateWorkerThread() {
-    qDebug() << "重新创建工作线程...";
+    QW_DEBUG(lcWorker) << "重新创建工作线程...";
     
     // 创建新的工作线程
     m_workerThread = new QThread(this);
@@ -464,22 +990,14 @@ void AsyncPathCalculator::recreateWorkerThread() {
     // 连接worker信号
     connect(m_worker, &PathCalculatorWorker::taskStarted,
             this, &AsyncPathCalculator::onTaskStarted);
-    connect(m_worker, &PathCalculatorWorker::taskProgress,
-            this, &AsyncPathCalculator::onTaskProgress);
     connect(m_worker, &PathCalculatorWorker::taskCompleted,
             this, &AsyncPathCalculator::onTaskCompleted);
     connect(m_worker, &PathCalculatorWorker::allTasksCompleted,
             this, &AsyncPathCalculator::onAllTasksCompleted);
     
-    // 如果有网格数据，重新设置
-    if (!m_gridData.isEmpty()) {
-        qDebug() << "重新设置网格数据到新worker";
-        m_worker->setGrid(m_gridData);
-    }
-    
     // 启动新线程
     m_workerThread->start();
-    qDebug() << "新工作线程已启动";
+    QW_DEBUG(lcWorker) << "新工作线程已启动";
 }
 
 void AsyncPathCalculator::stopTask(int taskId) {
@@ -511,15 +1029,61 @@ int AsyncPathCalculator::getResultQueueSize() {
     return 0;
 }
 
+SearchStats::Snapshot AsyncPathCalculator::statsSnapshot() const {
+    if (m_worker) {
+        const SearchStats::Snapshot snapshot = m_worker->statsSnapshot();
+        // 新worker尚未开始任务时沿用被停止任务的统计
+        if (snapshot.running || snapshot.elapsedMs > 0 || m_lastStats.elapsedMs == 0) {
+            return snapshot;
+        }
+    }
+    return m_lastStats;
+}
+
+void AsyncPathCalculator::pollProgress() {
+    int taskId = -1;
+    const int progress = m_worker->currentProgress(taskId);
+    if (taskId < 0 || (taskId == m_lastProgressTask && progress == m_lastProgress)) {
+        return;
+    }
+    // 同一任务内限频；新任务的第一次进度和100%立即发出
+    if (taskId == m_lastProgressTask && progress < 100 && m_progressClock.isValid() &&
+        m_progressClock.elapsed() < PROGRESS_INTERVAL_MS) {
+        return;
+    }
+    m_lastProgressTask = taskId;
+    m_lastProgress = progress;
+    m_progressClock.start();
+    emit calculationProgress(taskId, progress);
+}
+
+void AsyncPathCalculator::pollEndCounts() {
+    int taskId = -1;
+    QVector<quint64> counts;
+    if (m_worker->takeEndCounts(taskId, counts)) {
+        emit endCountsUpdated(taskId, counts);
+    }
+}
+
 void AsyncPathCalculator::checkResults() {
     if (!m_worker) return;
     
+    // 先读进度和终点计数再取结果，保证最终结果到达前二者都已更新
+    pollProgress();
+    pollEndCounts();
+    
     CalculationResult result;
     while (m_worker->getNextResult(result)) {
         if (result.isPartial) {
             emit partialPathFound(result.pathResult, result.taskId);
         } else if (result.isComplete) {
-            if (result.pathResult.getPath().isEmpty()) {
+            // 最终计数在最终结果之前发布，可能晚于本次开头的读取
+            pollEndCounts();
+            // 界面在任务完成时查询是否还有下一页
+            m_hasMorePaths = result.morePaths;
+            if (result.budgetExhausted) {
+                emit budgetExhausted(result.pathResult, result.taskId);
+            } else if (result.pathResult.getPath().isEmpty()) {
                 emit pathNotFound(result.taskId);
             } else {
                 emit pathFound(result.pathResult, result.taskId);
@@ -533,10 +1097,6 @@ void AsyncPathCalculator::onTaskStarted(int taskId) {
     emit calculationStarted(taskId);
 }
 
-void AsyncPathCalculator::onTaskProgress(int taskId, int percentage) {
-    emit calculationProgress(taskId, percentage);
-}
-
 void AsyncPathCalculator::onTaskCompleted(int taskId) {
     // 任务完成会在checkResults中处理
     Q_UNUSED(taskId);
@@ -2,8 +2,10 @@
 #define ASYNCPATHCALCULATOR_H
 
 #include "Common.h"
-#include "GridPoint.h"
+#include "GridSnapshot.h"
 #include "PathResult.h"
+#include "SearchBudget.h"
+#include "SearchStats.h"
 #include <QObject>
 #include <QThread>
 #include <QVector>
@@ -14,7 +16,11 @@
 #include <QElapsedTimer>
 #include <QWaitCondition>
 #include <QHash>
+#include <QPair>
+#include <QSet>
 #include <atomic>
+#include <functional>
+#include <memory>
 
 // 为QPoint添加哈希函数支持
 inline uint qHash(const QPoint &key, uint seed = 0) {
@@ -27,10 +33,24 @@ struct CalculationTask {
     QPoint end;
     AlgorithmType algorithm;
     int taskId;
+    int maxPaths;     // 最多产出的路径条数（哈密顿路径上限 / K最短路径的K）
+    PathObjective objective;  // 只对DFS（哈密顿路径）有效
+    GridSnapshotPtr grid;  // 提交时的网格快照，任务运行期间保持不变
+    NeighborhoodType neighborhood;  // 提交时的邻域，与快照一起决定图的结构
+    MoveOrder moveOrder;            // 哈密顿路径枚举的展开顺序，随机顺序以taskId为种子
+    EndpointMode endpointMode;      // 哈密顿路径的端点约束；端点自由时总是枚举，忽略objective
+    SearchBudget budget;            // 节点、时间、内存预算，用完时任务正常结束并报告已有结果
+    bool nextPage;                  // 不新建搜索，从上一个分页枚举任务停下的位置再取一页；其余参数沿用该任务
     
-    CalculationTask() : taskId(-1) {}
-    CalculationTask(const QPoint& s, const QPoint& e, AlgorithmType algo, int id)
-        : start(s), end(e), algorithm(algo), taskId(id) {}
+    CalculationTask() : taskId(-1), maxPaths(Constants::DEFAULT_MAX_PATHS), objective(PathObjective::Enumerate),
+                        neighborhood(NeighborhoodType::Four), moveOrder(MoveOrder::Natural),
+                        endpointMode(EndpointMode::Fixed), nextPage(false) {}
+    CalculationTask(const QPoint& s, const QPoint& e, AlgorithmType algo, int id,
+                    int limit = Constants::DEFAULT_MAX_PATHS,
+                    PathObjective goal = PathObjective::Enumerate)
+        : start(s), end(e), algorithm(algo), taskId(id), maxPaths(limit), objective(goal),
+          neighborhood(NeighborhoodType::Four), moveOrder(MoveOrder::Natural),
+          endpointMode(EndpointMode::Fixed), nextPage(false) {}
 };
 
 // 计算结果结构
@@ -39,10 +59,13 @@ struct CalculationResult {
     int taskId;
     bool isComplete;  // 是否为完整计算完成
     bool isPartial;   // 是否为部分结果
+    bool budgetExhausted;  // 最终结果：任务因预算用完而结束，结果名称中带有报告
+    bool morePaths;        // 最终结果：分页枚举还有下一页，可提交nextPage任务续取
     
-    CalculationResult() : taskId(-1), isComplete(false), isPartial(false) {}
-    CalculationResult(const PathResult& result, int id, bool complete = true, bool partial = false)
-        : pathResult(result), taskId(id), isComplete(complete), isPartial(partial) {}
+    CalculationResult() : taskId(-1), isComplete(false), isPartial(false), budgetExhausted(false), morePaths(false) {}
+    CalculationResult(PathResult result, int id, bool complete = true, bool partial = false)
+        : pathResult(std::move(result)), taskId(id), isComplete(complete), isPartial(partial),
+          budgetExhausted(false), morePaths(false) {}
 };
 
 // 工作线程类
@@ -53,7 +76,6 @@ public:
     explicit PathCalculatorWorker(QObject* parent = nullptr);
     ~PathCalculatorWorker();
     
-    void setGrid(const QVector<QVector<GridPoint>>& grid);
     void addTask(const CalculationTask& task);
     void pauseCalculation();
     void resumeCalculation();
@@ -63,18 +85,30 @@ public:
     // 获取结果队列中的数据（线程安全）
     bool getNextResult(CalculationResult& result);
     int getResultQueueSize();
+    
+    // 当前（或最近一个）任务的搜索统计，任意线程可读
+    SearchStats::Snapshot statsSnapshot() const { return m_stats.snapshot(); }
+    
+    // 当前任务的进度（0~100），任意线程可读；没有任务时taskId为-1
+    int currentProgress(int& taskId) const;
+    
+    // 取出按终点计数任务最近一次发布的各终点路径数（行优先下标），任意线程可调用
+    // 自上次取出后没有新的发布时返回false
+    bool takeEndCounts(int& taskId, QVector<quint64>& counts);
 
 public slots:
     void processNextTask();
 
 signals:
     void taskStarted(int taskId);
-    void taskProgress(int taskId, int percentage);
     void taskCompleted(int taskId);
     void allTasksCompleted();
 
 private:
-    QVector<QVector<GridPoint>> m_grid;
+    // 当前任务固定的网格快照，只在工作线程中读写
+    GridSnapshotPtr m_snapshot;
+    const GridModel& grid() const { return m_snapshot->grid(); }
+    
     QQueue<CalculationTask> m_taskQueue;
     QQueue<CalculationResult> m_resultQueue;
     QMutex m_taskMutex;
@@ -85,25 +119,79 @@ private:
     std::atomic<bool> m_isStopped;
     std::atomic<bool> m_isRunning;
     
-    // 算法实现
-    void calculatePathAsync(const CalculationTask& task);
-    QVector<QPoint> calculateDFS(const QPoint& start, const QPoint& end, int taskId);
+    SearchStats m_stats;
+    
+    // 当前任务的预算计量；coverage为当前任务的搜索覆盖比例估计，-1表示该算法没有估计
+    BudgetMeter m_budget;
+    double m_coverage;
+    // 检查点公共部分：等待暂停结束，停止或预算用完时返回false；nodes为任务目前扩展的节点数
+    bool keepRunning(quint64 nodes);
+    QString budgetReport() const;
+    
+    // 进度不再逐次投递事件：搜索线程只写这个原子量，界面按自己的节奏读取
+    // 高32位为任务ID，低32位为百分比，一次读写保证二者一致
+    std::atomic<quint64> m_progress;
+    void setProgress(int taskId, int percentage);
     
-    // 基于用户算法的哈密顿路径查找
-    void findHamiltonianPathsDFS(int x, int y, int endX, int endY, int totalPassableCells,
-                               QVector<QPoint>& currentPath, QVector<QVector<QPoint>>& allPaths,
-                               QVector<QVector<bool>>& visited, int taskId);
-    bool isValidDFS(int x, int y, const QVector<QVector<bool>>& visited) const;
+    // 按终点计数：搜索线程在检查点中按间隔发布各终点目前的计数，界面取走最新一份
+    static const int END_COUNTS_INTERVAL_MS = 200;
+    QMutex m_endCountsMutex;
+    QVector<quint64> m_endCounts;
+    int m_endCountsTask;
+    bool m_endCountsPending;
+    void publishEndCounts(int taskId, const QVector<quint64>& counts);
+    
+    // 分页枚举：DFS枚举任务的生成器在任务结束后保留，nextPage任务从停下的位置再取一页
+    // 引擎按邻域特化，这里只保存续取用的闭包；新的普通任务开始时丢弃
+    struct PathPager {
+        CalculationTask task;           // 创建生成器的任务，续取时沿用其参数和网格快照
+        int delivered;                  // 已产出的路径数，总数不超过task.maxPaths
+        quint64 pageStartNodes;         // 本页开始时生成器累计扩展的节点数，预算按页计
+        std::function<int(int count, const std::function<bool(const QVector<QPoint>&)>& onPath)> next;
+        std::function<bool()> exhausted;
+        std::function<quint64()> expandedSoFar;
+        std::function<double()> coverage;
+        QSet<QPair<int, int>> endpointPairs;    // 端点自由时出现过的端点组合（行优先下标）
+    };
+    std::unique_ptr<PathPager> m_pager;
+    int m_pagerTaskId;                  // 当前一页的任务ID，生成器的检查点据此报告进度
+    bool m_morePaths;                   // 当前任务结束后还有下一页
+    QVector<QPoint> fetchPage(const CalculationTask& task, QString& summary);
+    
+    // 算法实现；按任务的邻域分派一次，各算法都是对应邻域策略的特化版本
+    void calculatePathAsync(const CalculationTask& task);
+    template<class Neighborhood>
+    QVector<QPoint> calculateDFS(const CalculationTask& task, int maxPaths, QString& summary);
+    template<class Neighborhood>
+    QVector<QPoint> calculatePagedDFS(const CalculationTask& task, QString& summary);
+    template<class Neighborhood>
+    QVector<QPoint> calculateMinWeight(const CalculationTask& task, QString& summary);
+    template<class Neighborhood>
+    QVector<QPoint> calculateMinTurns(const CalculationTask& task, QString& summary);
+    template<class Neighborhood>
+    QVector<QPoint> calculateConstruct(const CalculationTask& task, QString& summary);
+    template<class Neighborhood>
+    QVector<QPoint> calculatePortfolio(const CalculationTask& task, QString& summary);
+    template<class Neighborhood>
+    QVector<QPoint> calculateMeetInTheMiddle(const CalculationTask& task, QString& summary);
+    template<class Neighborhood>
+    QVector<QPoint> calculateEndCounts(const CalculationTask& task, QString& summary);
+    template<class Neighborhood>
+    QVector<QPoint> calculateKShortestPaths(const CalculationTask& task);
+    template<class Neighborhood>
+    QVector<QPoint> calculateAllShortestPaths(const CalculationTask& task, QString& summary);
     
     // 工具方法
     bool isValidPoint(const QPoint& point) const;
-    QVector<QPoint> getNeighbors(const QPoint& point) const;
     QVector<QPoint> findSimplePath(const QPoint& start, const QPoint& end, const QSet<QPoint>& allPoints);
     void addPartialResult(const CalculationTask& task, const QVector<QPoint>& partialPath, int progress);
     void addPartialPathResult(const QPoint& start, const QPoint& end,
                             const QVector<QPoint>& path, 
                             int pathNumber, int totalPaths, int taskId);
-    void addFinalResult(const CalculationTask& task, const QVector<QPoint>& finalPath, qint64 elapsed);
+    void addRankedPathResult(const CalculationTask& task, const QVector<QPoint>& path,
+                             int rank, double cost);
+    void addFinalResult(const CalculationTask& task, const QVector<QPoint>& finalPath, qint64 elapsed,
+                        const QString& summary = QString());
     
     // 等待暂停状态结束
     void waitForResume();
@@ -117,10 +205,26 @@ public:
     explicit AsyncPathCalculator(QObject* parent = nullptr);
     ~AsyncPathCalculator();
     
-    void setGrid(const QVector<QVector<GridPoint>>& grid);
+    // 之后提交的任务使用该快照；只保存共享指针，不复制网格
+    void setGrid(const GridSnapshotPtr& snapshot);
+    // 之后提交的任务使用该邻域
+    void setNeighborhood(NeighborhoodType neighborhood) { m_neighborhood = neighborhood; }
+    // 之后提交的哈密顿路径任务使用该展开顺序
+    void setMoveOrder(MoveOrder order) { m_moveOrder = order; }
+    // 之后提交的哈密顿路径任务使用该端点约束
+    void setEndpointMode(EndpointMode mode) { m_endpointMode = mode; }
+    // 之后提交的任务使用该预算
+    void setBudget(const SearchBudget& budget) { m_budget = budget; }
+    
+    // 最近结束的哈密顿路径枚举还有下一页；提交新任务或停止后为false
+    bool hasMorePaths() const { return m_hasMorePaths; }
+    // 从该枚举停下的位置再取一页路径，作为新任务运行，返回任务ID；没有下一页时返回-1
+    int fetchMorePaths();
     
     // 添加计算任务
-    int addCalculationTask(const QPoint& start, const QPoint& end, AlgorithmType algorithm);
+    int addCalculationTask(const QPoint& start, const QPoint& end, AlgorithmType algorithm,
+                           int maxPaths = Constants::DEFAULT_MAX_PATHS,
+                           PathObjective objective = PathObjective::Enumerate);
     
     // 控制方法
     void pauseAllCalculations();
@@ -138,11 +242,18 @@ public:
     // 获取状态信息
     int getPendingTaskCount();
     int getResultQueueSize();
+    
+    // 搜索统计快照，供界面定时刷新
+    SearchStats::Snapshot statsSnapshot() const;
 
 signals:
     void pathFound(const PathResult& result, int taskId);
     void partialPathFound(const PathResult& result, int taskId);
     void pathNotFound(int taskId);
+    // 预算用完，任务提前结束；result为最终结果（路径可能为空），名称中带有报告
+    void budgetExhausted(const PathResult& result, int taskId);
+    // 按终点计数任务的各终点路径数（行优先下标），计算中定期发出，结束时发出最终值
+    void endCountsUpdated(int taskId, const QVector<quint64>& counts);
     void calculationProgress(int taskId, int percentage);
     void calculationStarted(int taskId);
     void calculationFinished(int taskId);
@@ -151,7 +262,6 @@ signals:
 private slots:
     void checkResults();
     void onTaskStarted(int taskId);
-    void onTaskProgress(int taskId, int percentage);
     void onTaskCompleted(int taskId);
     void onAllTasksCompleted();
 
@@ -163,8 +273,24 @@ private:
     int m_nextTaskId;
     QMutex m_taskIdMutex;
     
-    // 保存网格数据用于重新创建线程时设置
-    QVector<QVector<GridPoint>> m_gridData;
+    // 进度轮询：数值变化且距上次发出超过PROGRESS_INTERVAL_MS才发出calculationProgress
+    static const int PROGRESS_INTERVAL_MS = 100;
+    QElapsedTimer m_progressClock;
+    int m_lastProgressTask;
+    int m_lastProgress;
+    void pollProgress();
+    void pollEndCounts();
+    
+    // 新任务使用的网格快照、邻域、展开顺序、端点约束和预算
+    GridSnapshotPtr m_snapshot;
+    NeighborhoodType m_neighborhood;
+    MoveOrder m_moveOrder;
+    EndpointMode m_endpointMode;
+    SearchBudget m_budget;
+    bool m_hasMorePaths;
+    
+    // 强制停止时worker被销毁，保留其最后的统计
+    SearchStats::Snapshot m_lastStats;
     
     // 获取下一个任务ID
     int getNextTaskId();
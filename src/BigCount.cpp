@@ -0,0 +1,84 @@
+#include "BigCount.h"
+#include <algorithm>
+#include <limits>
+
+BigCount::BigCount(quint64 value) {
+    while (value != 0) {
+        m_limbs.append(static_cast<quint32>(value & 0xFFFFFFFFu));
+        value >>= 32;
+    }
+}
+
+BigCount& BigCount::operator+=(const BigCount& other) {
+    if (other.m_limbs.size() > m_limbs.size()) {
+        m_limbs.resize(other.m_limbs.size());
+    }
+
+    quint64 carry = 0;
+    for (int i = 0; i < m_limbs.size(); ++i) {
+        quint64 sum = static_cast<quint64>(m_limbs[i]) + carry;
+        if (i < other.m_limbs.size()) {
+            sum += other.m_limbs[i];
+        }
+        m_limbs[i] = static_cast<quint32>(sum & 0xFFFFFFFFu);
+        carry = sum >> 32;
+        if (carry == 0 && i >= other.m_limbs.size()) {
+            break;
+        }
+    }
+    if (carry != 0) {
+        m_limbs.append(static_cast<quint32>(carry));
+    }
+    return *this;
+}
+
+quint64 BigCount::toUInt64() const {
+    if (!fitsInUInt64()) {
+        return std::numeric_limits<quint64>::max();
+    }
+    quint64 value = 0;
+    for (int i = m_limbs.size() - 1; i >= 0; --i) {
+        value = (value << 32) | m_limbs[i];
+    }
+    return value;
+}
+
+double BigCount::toDouble() const {
+    double value = 0.0;
+    for (int i = m_limbs.size() - 1; i >= 0; --i) {
+        value = value * 4294967296.0 + m_limbs[i];
+    }
+    return value;
+}
+
+bool BigCount::greaterThan(quint64 value) const {
+    return !fitsInUInt64() || toUInt64() > value;
+}
+
+QString BigCount::toString() const {
+    if (isZero()) {
+        return QString("0");
+    }
+
+    // 反复除以10^9，每次得到9位十进制数
+    QVector<quint32> digits = m_limbs;
+    QVector<quint32> chunks;
+    while (!digits.isEmpty()) {
+        quint64 remainder = 0;
+        for (int i = digits.size() - 1; i >= 0; --i) {
+            quint64 current = (remainder << 32) | digits[i];
+            digits[i] = static_cast<quint32>(current / 1000000000u);
+            remainder = current % 1000000000u;
+        }
+        chunks.append(static_cast<quint32>(remainder));
+        while (!digits.isEmpty() && digits.last() == 0) {
+            digits.removeLast();
+        }
+    }
+
+    QString text = QString::number(chunks.last());
+    for (int i = chunks.size() - 2; i >= 0; --i) {
+        text += QString::number(chunks[i]).rightJustified(9, QLatin1Char('0'));
+    }
+    return text;
+}
@@ -0,0 +1,30 @@
+#ifndef BIGCOUNT_H
+#define BIGCOUNT_H
+
+#include <QVector>
+#include <QString>
+#include <QtGlobal>
+
+// 无符号大整数计数器，只支持计数需要的加法和比较
+// 路径数量在大网格上会远超64位，按32位分段存储（低位在前）
+class BigCount {
+public:
+    BigCount() {}
+    BigCount(quint64 value);
+
+    BigCount& operator+=(const BigCount& other);
+
+    bool isZero() const { return m_limbs.isEmpty(); }
+    bool fitsInUInt64() const { return m_limbs.size() <= 2; }
+    quint64 toUInt64() const;       // 超出范围时返回quint64最大值
+    double toDouble() const;
+    bool greaterThan(quint64 value) const;
+
+    // 十进制字符串
+    QString toString() const;
+
+private:
+    QVector<quint32> m_limbs;
+};
+
+#endif // BIGCOUNT_H
@@ -1,43 +1,13 @@
 #ifndef COMMON_H
 #define COMMON_H
 
+#include "GridTypes.h"
 #include <QPoint>
 #include <QColor>
 #include <QString>
 
-// 点类型枚举
-enum class PointType {
-    Normal,     // 普通点
-    Start,      // 起点
-    End,        // 终点
-    Path,       // 路径点
-    Obstacle    // 障碍点
-};
-
-// 算法类型枚举
-enum class AlgorithmType {
-    AStar,      // A*算法
-    Dijkstra,   // Dijkstra算法
-    BFS,        // 广度优先搜索
-    DFS         // 深度优先搜索
-};
-
-// 计算状态枚举
-enum class CalculationState {
-    Idle,       // 空闲
-    Running,    // 运行中
-    Paused,     // 暂停
-    Completed,  // 完成
-    Stopped     // 停止
-};
-
-// 常量定义
+// 界面常量定义（引擎常量见GridTypes.h）
 namespace Constants {
-    const int DEFAULT_GRID_WIDTH = 5;
-    const int DEFAULT_GRID_HEIGHT = 5;
-    const int MIN_GRID_SIZE = 5;
-    const int MAX_GRID_SIZE = 100;
-    
     const int POINT_RADIUS = 8;
     const int GRID_SPACING = 25;
     
@@ -51,9 +21,6 @@ namespace Constants {
 }
 
 // 工具函数
-QString algorithmTypeToString(AlgorithmType type);
-AlgorithmType stringToAlgorithmType(const QString& str);
-QString pointTypeToString(PointType type);
 QColor getPointColor(PointType type);
 
 #endif // COMMON_H
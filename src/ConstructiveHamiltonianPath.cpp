@@ -0,0 +1,505 @@
+#include "ConstructiveHamiltonianPath.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+// 不超过该面积的矩形直接回溯
+const int SMALL_RECT_AREA = 16;
+// 回溯补齐的节点上限，超过即放弃构造（正常情况下只会在很小的矩形上回溯）
+const quint64 SMALL_NODE_LIMIT = 1u << 20;
+}
+
+ConstructiveHamiltonianPath::ConstructiveHamiltonianPath(const GridModel& grid)
+    : m_grid(grid)
+    , m_transposed(false)
+    , m_width(0)
+    , m_height(0)
+    , m_smallNodes(0)
+{
+}
+
+bool ConstructiveHamiltonianPath::rectangleHasPath(int width, int height, const QPoint& s, const QPoint& t) {
+    int sx = s.x(), sy = s.y(), tx = t.x(), ty = t.y();
+    if (sx == tx && sy == ty) {
+        return width * height == 1;
+    }
+
+    // 染色条件：格子数为偶数时两端异色；为奇数时两端都是角上的颜色（多出一个的那种）
+    const int sColor = (sx + sy) & 1;
+    const int tColor = (tx + ty) & 1;
+    if ((width * height) % 2 == 0) {
+        if (sColor == tColor) {
+            return false;
+        }
+    } else if (sColor != 0 || tColor != 0) {
+        return false;
+    }
+
+    // 以下按横放（宽不小于高）讨论
+    if (height > width) {
+        std::swap(width, height);
+        std::swap(sx, sy);
+        std::swap(tx, ty);
+    }
+    if (height == 1) {
+        // 单行：两端必须是行的两头
+        return std::min(sx, tx) == 0 && std::max(sx, tx) == width - 1;
+    }
+    if (height == 2) {
+        // 两行：两端不能是中间某一列的上下两格
+        return !(sx == tx && sx > 0 && sx < width - 1);
+    }
+    if (height == 3 && width % 2 == 0) {
+        // 3xn且n为偶数：记与左上角异色的端点为a、同色的为b，
+        // a在b左侧隔开一列以上，或a在中间一行且位于b左侧时无解
+        const bool sIsA = sColor != 0;
+        const int ax = sIsA ? sx : tx;
+        const int ay = sIsA ? sy : ty;
+        const int bx = sIsA ? tx : sx;
+        if (ax < bx - 1 || (ay == 1 && ax < bx)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ConstructiveHamiltonianPath::acceptable(const Rect& r, int s, int t) const {
+    return rectangleHasPath(r.width, r.height,
+                            QPoint(cellX(s) - r.x, cellY(s) - r.y),
+                            QPoint(cellX(t) - r.x, cellY(t) - r.y));
+}
+
+ConstructiveHamiltonianPath::Outcome ConstructiveHamiltonianPath::construct(const QPoint& start, const QPoint& end,
+                                                                            QVector<QPoint>& path) {
+    path.clear();
+    if (!m_grid.isWalkable(start) || !m_grid.isWalkable(end)) {
+        return NoPath;
+    }
+
+    // 染色条件对任何形状都是必要的：路径黑白交替
+    int colorCount[2] = {0, 0};
+    for (int i = 0; i < m_grid.cellCount(); ++i) {
+        if (m_grid.isWalkable(i)) {
+            const QPoint p = m_grid.toPoint(i);
+            ++colorCount[(p.x() + p.y()) & 1];
+        }
+    }
+    if (start == end) {
+        if (m_grid.walkableCount() != 1) {
+            return NoPath;
+        }
+        path.append(start);
+        return Constructed;
+    }
+    const int startColor = (start.x() + start.y()) & 1;
+    const int endColor = (end.x() + end.y()) & 1;
+    if (colorCount[0] == colorCount[1]) {
+        if (startColor == endColor) {
+            return NoPath;
+        }
+    } else if (qAbs(colorCount[0] - colorCount[1]) == 1) {
+        const int majority = colorCount[0] > colorCount[1] ? 0 : 1;
+        if (startColor != majority || endColor != majority) {
+            return NoPath;
+        }
+    } else {
+        return NoPath;
+    }
+
+    // 先按行分解，不行再按列
+    if (!decompose(false) && !decompose(true)) {
+        return Unsupported;
+    }
+
+    int s = m_transposed ? index(start.y(), start.x()) : index(start.x(), start.y());
+    int t = m_transposed ? index(end.y(), end.x()) : index(end.x(), end.y());
+    const Outcome outcome = constructChain(s, t);
+    if (outcome != Constructed) {
+        return outcome;
+    }
+
+    path.reserve(m_grid.walkableCount());
+    for (int cell = s; cell >= 0 && path.size() < m_grid.walkableCount(); cell = m_next[cell]) {
+        path.append(m_transposed ? QPoint(cellY(cell), cellX(cell)) : QPoint(cellX(cell), cellY(cell)));
+    }
+    if (path.size() != m_grid.walkableCount() || path.last() != end) {
+        path.clear();
+        return Unsupported;
+    }
+    return Constructed;
+}
+
+bool ConstructiveHamiltonianPath::decompose(bool transposed) {
+    m_transposed = transposed;
+    m_width = transposed ? m_grid.height() : m_grid.width();
+    m_height = transposed ? m_grid.width() : m_grid.height();
+    m_slabs.clear();
+
+    for (int y = 0; y < m_height; ++y) {
+        int first = -1;
+        int last = -1;
+        for (int x = 0; x < m_width; ++x) {
+            const bool walkable = transposed ? m_grid.isWalkable(y, x) : m_grid.isWalkable(x, y);
+            if (!walkable) {
+                continue;
+            }
+            if (last >= 0 && last != x - 1) {
+                return false;   // 这一行分成了不止一段
+            }
+            if (first < 0) {
+                first = x;
+            }
+            last = x;
+        }
+        if (first < 0) {
+            continue;
+        }
+        if (!m_slabs.isEmpty()) {
+            Rect& previous = m_slabs.last();
+            if (previous.y + previous.height == y && previous.x == first && previous.width == last - first + 1) {
+                ++previous.height;
+                continue;
+            }
+        }
+        m_slabs.append(Rect(first, y, last - first + 1, 1));
+    }
+    return !m_slabs.isEmpty();
+}
+
+ConstructiveHamiltonianPath::Outcome ConstructiveHamiltonianPath::constructChain(int s, int t) {
+    const int slabCount = m_slabs.size();
+    for (int m = 0; m + 1 < slabCount; ++m) {
+        const Rect& a = m_slabs[m];
+        const Rect& b = m_slabs[m + 1];
+        if (a.y + a.height != b.y || std::max(a.x, b.x) >= std::min(a.x + a.width, b.x + b.width)) {
+            return NoPath;  // 不连通
+        }
+    }
+
+    int first = 0;
+    int last = 0;
+    for (int m = 0; m < slabCount; ++m) {
+        if (inRect(m_slabs[m], s)) first = m;
+        if (inRect(m_slabs[m], t)) last = m;
+    }
+    // 链上从上往下构造，起点在下方时交换两端，最后从原起点读出即可（后继指针反向）
+    const bool reversed = first > last;
+    if (reversed) {
+        std::swap(first, last);
+        std::swap(s, t);
+    }
+
+    m_next.fill(-1, m_width * m_height);
+    m_smallNodes = 0;
+
+    if (first == last) {
+        if (!acceptable(m_slabs[first], s, t)) {
+            return slabCount == 1 ? NoPath : Unsupported;
+        }
+        if (!solveRect(m_slabs[first], s, t)) {
+            return Unsupported;
+        }
+    } else {
+        // 自下而上求每个条带顶行可行的入口列：从入口出发能覆盖本条带，
+        // 并在底行某列出去接上下一个条带的可行入口
+        QVector<QVector<bool>> feasible(slabCount);
+        for (int m = last; m > first; --m) {
+            const Rect& r = m_slabs[m];
+            feasible[m].fill(false, r.width);
+            for (int c = 0; c < r.width; ++c) {
+                const int entry = index(r.x + c, r.y);
+                if (m == last) {
+                    feasible[m][c] = acceptable(r, entry, t);
+                    continue;
+                }
+                const Rect& below = m_slabs[m + 1];
+                const int lo = std::max(r.x, below.x);
+                const int hi = std::min(r.x + r.width, below.x + below.width);
+                for (int x = lo; x < hi && !feasible[m][c]; ++x) {
+                    feasible[m][c] = feasible[m + 1][x - below.x] &&
+                                     acceptable(r, entry, index(x, r.y + r.height - 1));
+                }
+            }
+        }
+
+        // 自上而下选出口并构造
+        int entry = s;
+        for (int m = first; m < last; ++m) {
+            const Rect& r = m_slabs[m];
+            const Rect& below = m_slabs[m + 1];
+            const int lo = std::max(r.x, below.x);
+            const int hi = std::min(r.x + r.width, below.x + below.width);
+            int exit = -1;
+            for (int x = lo; x < hi && exit < 0; ++x) {
+                const int candidate = index(x, r.y + r.height - 1);
+                if (feasible[m + 1][x - below.x] && acceptable(r, entry, candidate)) {
+                    exit = candidate;
+                }
+            }
+            if (exit < 0 || !solveRect(r, entry, exit)) {
+                return Unsupported;
+            }
+            m_next[exit] = exit + m_width;
+            entry = exit + m_width;
+        }
+        if (!solveRect(m_slabs[last], entry, t)) {
+            return Unsupported;
+        }
+    }
+
+    // 两头多出的条带由近及远挂到已有路径上
+    for (int m = first - 1; m >= 0; --m) {
+        if (!absorb(m, m + 1)) {
+            return Unsupported;
+        }
+    }
+    for (int m = last + 1; m < slabCount; ++m) {
+        if (!absorb(m, m - 1)) {
+            return Unsupported;
+        }
+    }
+
+    if (reversed) {
+        // 把后继指针反过来，使路径从原起点出发
+        int previous = -1;
+        for (int cell = s; cell >= 0;) {
+            const int next = m_next[cell];
+            m_next[cell] = previous;
+            previous = cell;
+            cell = next;
+        }
+    }
+    return Constructed;
+}
+
+bool ConstructiveHamiltonianPath::absorb(int tail, int attached) {
+    const Rect& r = m_slabs[tail];
+    const Rect& a = m_slabs[attached];
+    const int rowAttached = tail < attached ? a.y : a.y + a.height - 1;
+    const int rowTail = tail < attached ? r.y + r.height - 1 : r.y;
+    const int lo = std::max(r.x, a.x);
+    const int hi = std::min(r.x + r.width, a.x + a.width);
+    for (int x = lo; x + 1 < hi; ++x) {
+        const int u = index(x, rowAttached);
+        const int v = u + 1;
+        if (m_next[u] == v && detour(u, v, r, index(x, rowTail), index(x + 1, rowTail))) {
+            return true;
+        }
+        if (m_next[v] == u && detour(v, u, r, index(x + 1, rowTail), index(x, rowTail))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ConstructiveHamiltonianPath::solveRect(const Rect& r, int s, int t) {
+    m_next[t] = -1;
+    if (r.width == 1 || r.height == 1) {
+        linkLine(s, t);
+        return true;
+    }
+    if (r.area() <= SMALL_RECT_AREA) {
+        return solveSmall(r, s, t);
+    }
+    if (peel(r, s, t) || split(r, s, t)) {
+        return true;
+    }
+    return solveSmall(r, s, t);
+}
+
+bool ConstructiveHamiltonianPath::peel(const Rect& r, int s, int t) {
+    const int sx = cellX(s) - r.x, sy = cellY(s) - r.y;
+    const int tx = cellX(t) - r.x, ty = cellY(t) - r.y;
+
+    // 四个方向：左、右、上、下。free为该侧不含端点的行列数，条带厚度取不超过它的偶数
+    for (int side = 0; side < 4; ++side) {
+        const bool vertical = side < 2;     // 剥下的是若干列
+        const int extent = vertical ? r.width : r.height;
+        int free = 0;
+        switch (side) {
+            case 0: free = std::min(sx, tx); break;
+            case 1: free = r.width - 1 - std::max(sx, tx); break;
+            case 2: free = std::min(sy, ty); break;
+            default: free = r.height - 1 - std::max(sy, ty); break;
+        }
+        for (int k = std::min(free, extent - 1) & ~1; k >= 2; k -= 2) {
+            Rect strip;
+            Rect rest;
+            switch (side) {
+                case 0:
+                    strip = Rect(r.x, r.y, k, r.height);
+                    rest = Rect(r.x + k, r.y, r.width - k, r.height);
+                    break;
+                case 1:
+                    strip = Rect(r.x + r.width - k, r.y, k, r.height);
+                    rest = Rect(r.x, r.y, r.width - k, r.height);
+                    break;
+                case 2:
+                    strip = Rect(r.x, r.y, r.width, k);
+                    rest = Rect(r.x, r.y + k, r.width, r.height - k);
+                    break;
+                default:
+                    strip = Rect(r.x, r.y + r.height - k, r.width, k);
+                    rest = Rect(r.x, r.y, r.width, r.height - k);
+                    break;
+            }
+            if (!acceptable(rest, s, t)) {
+                continue;
+            }
+            if (!solveRect(rest, s, t)) {
+                break;
+            }
+
+            // 在剩余部分紧贴条带的一行（列）上找一条路径边，把条带接进去
+            const int boundary = side == 0 ? index(rest.x, rest.y)
+                               : side == 1 ? index(rest.x + rest.width - 1, rest.y)
+                               : side == 2 ? index(rest.x, rest.y)
+                               : index(rest.x, rest.y + rest.height - 1);
+            const int step = vertical ? m_width : 1;
+            const int offset = side == 0 ? -1 : side == 1 ? 1 : side == 2 ? -m_width : m_width;
+            const int length = vertical ? r.height : r.width;
+            for (int i = 0; i + 1 < length; ++i) {
+                const int u = boundary + i * step;
+                const int v = u + step;
+                if (m_next[u] == v && detour(u, v, strip, u + offset, v + offset)) {
+                    return true;
+                }
+                if (m_next[v] == u && detour(v, u, strip, v + offset, u + offset)) {
+                    return true;
+                }
+            }
+            break;
+        }
+    }
+    return false;
+}
+
+bool ConstructiveHamiltonianPath::split(const Rect& r, int s, int t) {
+    const int sx = cellX(s) - r.x, sy = cellY(s) - r.y;
+    const int tx = cellX(t) - r.x, ty = cellY(t) - r.y;
+
+    // 竖切：左侧k列、右侧其余；跨切线的边在第y行
+    for (int k = std::min(sx, tx) + 1; k <= std::max(sx, tx); ++k) {
+        const Rect left(r.x, r.y, k, r.height);
+        const Rect right(r.x + k, r.y, r.width - k, r.height);
+        const bool startLeft = sx < k;
+        for (int y = 0; y < r.height; ++y) {
+            const int p = index(r.x + k - 1, r.y + y);
+            const int q = p + 1;
+            if (startLeft && acceptable(left, s, p) && acceptable(right, q, t)) {
+                if (!solveRect(left, s, p) || !solveRect(right, q, t)) return false;
+                m_next[p] = q;
+                return true;
+            }
+            if (!startLeft && acceptable(right, s, q) && acceptable(left, p, t)) {
+                if (!solveRect(right, s, q) || !solveRect(left, p, t)) return false;
+                m_next[q] = p;
+                return true;
+            }
+        }
+    }
+
+    // 横切：上方k行、下方其余；跨切线的边在第x列
+    for (int k = std::min(sy, ty) + 1; k <= std::max(sy, ty); ++k) {
+        const Rect top(r.x, r.y, r.width, k);
+        const Rect bottom(r.x, r.y + k, r.width, r.height - k);
+        const bool startTop = sy < k;
+        for (int x = 0; x < r.width; ++x) {
+            const int p = index(r.x + x, r.y + k - 1);
+            const int q = p + m_width;
+            if (startTop && acceptable(top, s, p) && acceptable(bottom, q, t)) {
+                if (!solveRect(top, s, p) || !solveRect(bottom, q, t)) return false;
+                m_next[p] = q;
+                return true;
+            }
+            if (!startTop && acceptable(bottom, s, q) && acceptable(top, p, t)) {
+                if (!solveRect(bottom, s, q) || !solveRect(top, p, t)) return false;
+                m_next[q] = p;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool ConstructiveHamiltonianPath::solveSmall(const Rect& r, int s, int t) {
+    QVector<bool> visited(r.area(), false);
+    visited[(cellY(s) - r.y) * r.width + cellX(s) - r.x] = true;
+    return smallStep(r, s, t, r.area(), visited);
+}
+
+bool ConstructiveHamiltonianPath::smallStep(const Rect& r, int current, int t, int remaining,
+                                            QVector<bool>& visited) {
+    if (remaining == 1) {
+        return current == t;
+    }
+    if (current == t || ++m_smallNodes > SMALL_NODE_LIMIT) {
+        return false;
+    }
+    const int x = cellX(current);
+    const int y = cellY(current);
+    const int candidates[4][2] = {{x, y - 1}, {x, y + 1}, {x - 1, y}, {x + 1, y}};
+    for (int i = 0; i < 4; ++i) {
+        const int nx = candidates[i][0];
+        const int ny = candidates[i][1];
+        if (!r.contains(nx, ny)) {
+            continue;
+        }
+        const int local = (ny - r.y) * r.width + nx - r.x;
+        const int next = index(nx, ny);
+        if (visited[local] || (next == t && remaining != 2)) {
+            continue;
+        }
+        visited[local] = true;
+        m_next[current] = next;
+        if (smallStep(r, next, t, remaining - 1, visited)) {
+            return true;
+        }
+        visited[local] = false;
+    }
+    return false;
+}
+
+void ConstructiveHamiltonianPath::linkLine(int s, int t) {
+    const int step = cellY(s) == cellY(t) ? (t > s ? 1 : -1) : (t > s ? m_width : -m_width);
+    for (int cell = s; cell != t; cell += step) {
+        m_next[cell] = cell + step;
+    }
+    m_next[t] = -1;
+}
+
+void ConstructiveHamiltonianPath::linkRing(const Rect& r, int from, int to) {
+    // 厚度为2的矩形只有外圈，按顺时针列出
+    QVector<int> ring;
+    ring.reserve(2 * (r.width + r.height));
+    for (int x = r.x; x < r.x + r.width; ++x) ring.append(index(x, r.y));
+    for (int y = r.y + 1; y < r.y + r.height; ++y) ring.append(index(r.x + r.width - 1, y));
+    for (int x = r.x + r.width - 2; x >= r.x; --x) ring.append(index(x, r.y + r.height - 1));
+    for (int y = r.y + r.height - 2; y > r.y; --y) ring.append(index(r.x, y));
+
+    // from与to在环上相邻，从from出发背向to绕一圈
+    const int n = ring.size();
+    const int position = ring.indexOf(from);
+    const int direction = ring[(position + 1) % n] == to ? n - 1 : 1;
+    int current = position;
+    for (int i = 0; i + 1 < n; ++i) {
+        const int next = (current + direction) % n;
+        m_next[ring[current]] = ring[next];
+        current = next;
+    }
+}
+
+bool ConstructiveHamiltonianPath::detour(int u, int v, const Rect& r, int uIn, int vIn) {
+    if (!acceptable(r, uIn, vIn)) {
+        return false;
+    }
+    if (r.width >= 2 && r.height >= 2 && std::min(r.width, r.height) == 2) {
+        linkRing(r, uIn, vIn);
+        m_next[vIn] = -1;
+    } else if (!solveRect(r, uIn, vIn)) {
+        return false;
+    }
+    m_next[u] = uIn;
+    m_next[vIn] = v;
+    return true;
+}
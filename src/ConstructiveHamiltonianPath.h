@@ -0,0 +1,77 @@
+#ifndef CONSTRUCTIVEHAMILTONIANPATH_H
+#define CONSTRUCTIVEHAMILTONIANPATH_H
+
+#include "GridModel.h"
+#include <QVector>
+#include <QPoint>
+
+// 构造式哈密顿路径（四邻域）：不搜索，直接按规则拼出一条路径，耗时与格子数成正比
+//
+// 完整矩形中两点之间是否存在哈密顿路径有封闭形式的判定（Itai, Papadimitriou, Szwarcfiter 1982）：
+// 染色条件之外，只有单行、两行和3xn（n为偶数）三类窄矩形中的少数端点组合无解。
+// 可解时按两种方式化简：
+//   剥边 - 从不含端点的一侧剥下偶数厚度的条带，条带内的绕行路径接到剩余部分贴边的一条路径边上
+//   切分 - 在两个端点之间切成两个矩形，分别构造后用跨过切线的一条边相连
+// 化简到很小的矩形时用回溯补齐
+//
+// 可通行区域每一行（或每一列）都是一段连续区间时（矩形挖去边角、边上的缺口等），
+// 按相同区间把行合并成矩形条带，条带首尾相接成链：端点之间的条带依次穿过，
+// 其余条带作为绕行挂到相邻条带的路径边上。这种情况下只是尽力构造，失败时返回Unsupported
+class ConstructiveHamiltonianPath {
+public:
+    enum Outcome {
+        Constructed,    // 已构造出一条路径
+        NoPath,         // 可以证明不存在哈密顿路径
+        Unsupported     // 区域形状超出构造范围或构造失败，需要退回搜索
+    };
+
+    explicit ConstructiveHamiltonianPath(const GridModel& grid);
+
+    Outcome construct(const QPoint& start, const QPoint& end, QVector<QPoint>& path);
+
+    // 宽width高height的完整矩形中，s到t是否存在哈密顿路径（坐标相对矩形左上角）
+    static bool rectangleHasPath(int width, int height, const QPoint& s, const QPoint& t);
+
+private:
+    // 内部坐标系中的矩形；按列分解时内部坐标是转置后的
+    struct Rect {
+        int x, y, width, height;
+        Rect() : x(0), y(0), width(0), height(0) {}
+        Rect(int x0, int y0, int w, int h) : x(x0), y(y0), width(w), height(h) {}
+        int area() const { return width * height; }
+        bool contains(int px, int py) const {
+            return px >= x && px < x + width && py >= y && py < y + height;
+        }
+    };
+
+    int index(int x, int y) const { return y * m_width + x; }
+    int cellX(int index) const { return index % m_width; }
+    int cellY(int index) const { return index / m_width; }
+    bool inRect(const Rect& r, int cell) const { return r.contains(cellX(cell), cellY(cell)); }
+    bool acceptable(const Rect& r, int s, int t) const;
+
+    bool decompose(bool transposed);
+    Outcome constructChain(int s, int t);
+    bool absorb(int tail, int attached);
+
+    // 在矩形r内写出s到t的后继指针，调用前须满足acceptable(r, s, t)
+    bool solveRect(const Rect& r, int s, int t);
+    bool peel(const Rect& r, int s, int t);
+    bool split(const Rect& r, int s, int t);
+    bool solveSmall(const Rect& r, int s, int t);
+    bool smallStep(const Rect& r, int current, int t, int remaining, QVector<bool>& visited);
+    void linkLine(int s, int t);
+    void linkRing(const Rect& r, int from, int to);
+    // 路径边u->v换成 u -> uIn ~(覆盖r)~ vIn -> v，uIn/vIn分别与u/v相邻
+    bool detour(int u, int v, const Rect& r, int uIn, int vIn);
+
+    const GridModel& m_grid;
+    bool m_transposed;
+    int m_width;                // 内部坐标系的宽高
+    int m_height;
+    QVector<Rect> m_slabs;      // 自上而下的条带
+    QVector<int> m_next;        // 路径上的后继格子，-1表示没有
+    quint64 m_smallNodes;       // 回溯补齐已扩展的节点数，超过上限放弃
+};
+
+#endif // CONSTRUCTIVEHAMILTONIANPATH_H
@@ -18,6 +18,7 @@ void ControlPanel::setupUI() {
     setupGridSizeGroup();
     setupPointControlGroup();
     setupCalculationGroup();
+    setupStatsGroup();
     setupSaveGroup();
     
     // 添加弹性空间
@@ -69,6 +70,21 @@ void ControlPanel::setupPointControlGroup() {
     );
     layout->addWidget(m_setEndButton);
     
+    // 格子权重：最小代价搜索按相邻格子的权重差计算每步代价
+    QHBoxLayout* weightLayout = new QHBoxLayout();
+    weightLayout->addWidget(new QLabel("权重:"));
+    m_weightSpinBox = new QSpinBox();
+    m_weightSpinBox->setRange(0, 99);
+    m_weightSpinBox->setValue(1);
+    weightLayout->addWidget(m_weightSpinBox);
+    m_setWeightButton = new QPushButton("设置权重");
+    m_setWeightButton->setCheckable(true);
+    m_setWeightButton->setStyleSheet(
+        "QPushButton:checked { background-color: lightblue; }"
+    );
+    weightLayout->addWidget(m_setWeightButton);
+    layout->addLayout(weightLayout);
+    
     m_mainLayout->addWidget(m_pointControlGroup);
 }
 
@@ -76,15 +92,94 @@ void ControlPanel::setupCalculationGroup() {
     m_calculationGroup = new QGroupBox("路径计算", this);
     QVBoxLayout* layout = new QVBoxLayout(m_calculationGroup);
     
-    // 算法选择（固定为DFS）
+    // 算法选择：DFS为哈密顿路径，A*/Dijkstra为按代价排序的K条最短路径，BFS为全部最短路径
     QHBoxLayout* algoLayout = new QHBoxLayout();
     algoLayout->addWidget(new QLabel("算法:"));
     m_algorithmCombo = new QComboBox();
-    m_algorithmCombo->addItem("DFS (深度优先搜索)", static_cast<int>(AlgorithmType::DFS));
-    m_algorithmCombo->setEnabled(false);  // 禁用算法选择，固定为DFS
+    m_algorithmCombo->addItem("DFS (哈密顿路径)", static_cast<int>(AlgorithmType::DFS));
+    m_algorithmCombo->addItem("A* (K条最短路径)", static_cast<int>(AlgorithmType::AStar));
+    m_algorithmCombo->addItem("Dijkstra (K条最短路径)", static_cast<int>(AlgorithmType::Dijkstra));
+    m_algorithmCombo->addItem("BFS (全部最短路径)", static_cast<int>(AlgorithmType::BFS));
     algoLayout->addWidget(m_algorithmCombo);
     layout->addLayout(algoLayout);
     
+    // 格子之间的连通方式，对所有算法有效
+    QHBoxLayout* neighborhoodLayout = new QHBoxLayout();
+    neighborhoodLayout->addWidget(new QLabel("邻域:"));
+    m_neighborhoodCombo = new QComboBox();
+    m_neighborhoodCombo->addItem("四邻域", static_cast<int>(NeighborhoodType::Four));
+    m_neighborhoodCombo->addItem("八邻域", static_cast<int>(NeighborhoodType::Eight));
+    m_neighborhoodCombo->addItem("八邻域（不穿角）", static_cast<int>(NeighborhoodType::EightNoCornerCutting));
+    m_neighborhoodCombo->addItem("六边形（奇数行右移）", static_cast<int>(NeighborhoodType::Hex));
+    m_neighborhoodCombo->addItem("马步", static_cast<int>(NeighborhoodType::Knight));
+    neighborhoodLayout->addWidget(m_neighborhoodCombo);
+    layout->addLayout(neighborhoodLayout);
+    
+    // 路径数量上限
+    QHBoxLayout* limitLayout = new QHBoxLayout();
+    limitLayout->addWidget(new QLabel("路径上限:"));
+    m_maxPathsSpinBox = new QSpinBox();
+    m_maxPathsSpinBox->setRange(1, Constants::MAX_PATHS_LIMIT);
+    m_maxPathsSpinBox->setValue(Constants::DEFAULT_MAX_PATHS);
+    limitLayout->addWidget(m_maxPathsSpinBox);
+    layout->addLayout(limitLayout);
+    
+    // 哈密顿路径的搜索目标，只对DFS有效
+    QHBoxLayout* objectiveLayout = new QHBoxLayout();
+    objectiveLayout->addWidget(new QLabel("目标:"));
+    m_objectiveCombo = new QComboBox();
+    m_objectiveCombo->addItem("枚举路径", static_cast<int>(PathObjective::Enumerate));
+    m_objectiveCombo->addItem("最小代价", static_cast<int>(PathObjective::MinWeight));
+    m_objectiveCombo->addItem("最少转弯", static_cast<int>(PathObjective::MinTurns));
+    m_objectiveCombo->addItem("直接构造", static_cast<int>(PathObjective::Construct));
+    m_objectiveCombo->addItem("多策略竞速", static_cast<int>(PathObjective::Portfolio));
+    m_objectiveCombo->addItem("按终点统计", static_cast<int>(PathObjective::EndCounts));
+    m_objectiveCombo->addItem("折半搜索", static_cast<int>(PathObjective::MeetInTheMiddle));
+    objectiveLayout->addWidget(m_objectiveCombo);
+    layout->addLayout(objectiveLayout);
+    
+    // 枚举时子节点的展开顺序，只影响第一条路径来得快慢
+    QHBoxLayout* moveOrderLayout = new QHBoxLayout();
+    moveOrderLayout->addWidget(new QLabel("展开顺序:"));
+    m_moveOrderCombo = new QComboBox();
+    m_moveOrderCombo->addItem("上下左右", static_cast<int>(MoveOrder::Natural));
+    m_moveOrderCombo->addItem("Warnsdorff（出路最少优先）", static_cast<int>(MoveOrder::Warnsdorff));
+    m_moveOrderCombo->addItem("贴边优先", static_cast<int>(MoveOrder::WallHugging));
+    m_moveOrderCombo->addItem("远离终点优先", static_cast<int>(MoveOrder::DistanceToEnd));
+    m_moveOrderCombo->addItem("随机", static_cast<int>(MoveOrder::Random));
+    moveOrderLayout->addWidget(m_moveOrderCombo);
+    layout->addLayout(moveOrderLayout);
+    
+    // 哈密顿路径的端点约束，端点自由时按枚举搜索
+    QHBoxLayout* endpointLayout = new QHBoxLayout();
+    endpointLayout->addWidget(new QLabel("端点:"));
+    m_endpointCombo = new QComboBox();
+    m_endpointCombo->addItem("固定起终点", static_cast<int>(EndpointMode::Fixed));
+    m_endpointCombo->addItem("终点任意", static_cast<int>(EndpointMode::FreeEnd));
+    m_endpointCombo->addItem("起终点都任意", static_cast<int>(EndpointMode::FreeBoth));
+    endpointLayout->addWidget(m_endpointCombo);
+    layout->addLayout(endpointLayout);
+    
+    // 任务预算，任一项用完任务即结束并报告已有结果；0为不限
+    QHBoxLayout* budgetLayout = new QHBoxLayout();
+    budgetLayout->addWidget(new QLabel("预算:"));
+    m_nodeBudgetSpinBox = new QSpinBox();
+    m_nodeBudgetSpinBox->setRange(0, 1000000);
+    m_nodeBudgetSpinBox->setSpecialValueText("节点不限");
+    m_nodeBudgetSpinBox->setSuffix(" 百万节点");
+    budgetLayout->addWidget(m_nodeBudgetSpinBox);
+    m_timeBudgetSpinBox = new QSpinBox();
+    m_timeBudgetSpinBox->setRange(0, 86400);
+    m_timeBudgetSpinBox->setSpecialValueText("时间不限");
+    m_timeBudgetSpinBox->setSuffix(" 秒");
+    budgetLayout->addWidget(m_timeBudgetSpinBox);
+    m_memoryBudgetSpinBox = new QSpinBox();
+    m_memoryBudgetSpinBox->setRange(0, 65536);
+    m_memoryBudgetSpinBox->setSpecialValueText("内存不限");
+    m_memoryBudgetSpinBox->setSuffix(" MB");
+    budgetLayout->addWidget(m_memoryBudgetSpinBox);
+    layout->addLayout(budgetLayout);
+    
     // 控制按钮
     QHBoxLayout* buttonLayout1 = new QHBoxLayout();
     m_startButton = new QPushButton("开始计算");
@@ -113,6 +208,39 @@ void ControlPanel::setupCalculationGroup() {
     m_mainLayout->addWidget(m_calculationGroup);
 }
 
+void ControlPanel::setupStatsGroup() {
+    m_statsGroup = new QGroupBox("搜索统计", this);
+    QGridLayout* layout = new QGridLayout(m_statsGroup);
+    
+    m_nodesLabel = new QLabel("-");
+    m_rateLabel = new QLabel("-");
+    m_pruneLabel = new QLabel("-");
+    m_backtrackLabel = new QLabel("-");
+    m_depthLabel = new QLabel("-");
+    m_elapsedLabel = new QLabel("-");
+    
+    layout->addWidget(new QLabel("扩展节点:"), 0, 0);
+    layout->addWidget(m_nodesLabel, 0, 1);
+    layout->addWidget(new QLabel("节点/秒:"), 1, 0);
+    layout->addWidget(m_rateLabel, 1, 1);
+    layout->addWidget(new QLabel("剪枝:"), 2, 0);
+    layout->addWidget(m_pruneLabel, 2, 1);
+    layout->addWidget(new QLabel("回溯:"), 3, 0);
+    layout->addWidget(m_backtrackLabel, 3, 1);
+    layout->addWidget(new QLabel("最大深度:"), 4, 0);
+    layout->addWidget(m_depthLabel, 4, 1);
+    layout->addWidget(new QLabel("用时:"), 5, 0);
+    layout->addWidget(m_elapsedLabel, 5, 1);
+    
+    // 深度分布：从左到右为浅到深
+    layout->addWidget(new QLabel("深度分布:"), 6, 0, 1, 2);
+    m_histogramLabel = new QLabel();
+    m_histogramLabel->setStyleSheet("QLabel { font-family: monospace; }");
+    layout->addWidget(m_histogramLabel, 7, 0, 1, 2);
+    
+    m_mainLayout->addWidget(m_statsGroup);
+}
+
 void ControlPanel::setupSaveGroup() {
     m_saveGroup = new QGroupBox("结果保存", this);
     QVBoxLayout* layout = new QVBoxLayout(m_saveGroup);
@@ -144,6 +272,14 @@ void ControlPanel::setupConnections() {
             this, &ControlPanel::onStartPointMode);
     connect(m_setEndButton, &QPushButton::clicked,
             this, &ControlPanel::onEndPointMode);
+    connect(m_setWeightButton, &QPushButton::clicked,
+            this, &ControlPanel::onWeightMode);
+    connect(m_algorithmCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, [this]() {
+                m_objectiveCombo->setEnabled(getSelectedAlgorithm() == AlgorithmType::DFS);
+                m_moveOrderCombo->setEnabled(getSelectedAlgorithm() == AlgorithmType::DFS);
+                m_endpointCombo->setEnabled(getSelectedAlgorithm() == AlgorithmType::DFS);
+            });
     
     // 计算控制
     connect(m_startButton, &QPushButton::clicked,
@@ -175,6 +311,38 @@ AlgorithmType ControlPanel::getSelectedAlgorithm() const {
     return static_cast<AlgorithmType>(index);
 }
 
+int ControlPanel::getMaxPaths() const {
+    return m_maxPathsSpinBox->value();
+}
+
+PathObjective ControlPanel::getObjective() const {
+    return static_cast<PathObjective>(m_objectiveCombo->currentData().toInt());
+}
+
+MoveOrder ControlPanel::getMoveOrder() const {
+    return static_cast<MoveOrder>(m_moveOrderCombo->currentData().toInt());
+}
+
+EndpointMode ControlPanel::getEndpointMode() const {
+    return static_cast<EndpointMode>(m_endpointCombo->currentData().toInt());
+}
+
+SearchBudget ControlPanel::getBudget() const {
+    SearchBudget budget;
+    budget.maxNodes = static_cast<quint64>(m_nodeBudgetSpinBox->value()) * 1000000ULL;
+    budget.maxMillis = static_cast<qint64>(m_timeBudgetSpinBox->value()) * 1000;
+    budget.maxMemoryBytes = static_cast<qint64>(m_memoryBudgetSpinBox->value()) * 1024 * 1024;
+    return budget;
+}
+
+NeighborhoodType ControlPanel::getNeighborhood() const {
+    return static_cast<NeighborhoodType>(m_neighborhoodCombo->currentData().toInt());
+}
+
+double ControlPanel::getCellWeight() const {
+    return m_weightSpinBox->value();
+}
+
 void ControlPanel::setCalculationState(CalculationState state) {
     m_currentState = state;
     updateCalculationButtons(state);
@@ -215,6 +383,21 @@ void ControlPanel::updateProgress(int percentage) {
     m_progressBar->setValue(percentage);
 }
 
+void ControlPanel::updateSearchStats(const SearchStats::Snapshot& stats) {
+    m_nodesLabel->setText(QString::number(stats.nodes));
+    m_rateLabel->setText(QString::number(stats.nodesPerSecond(), 'f', 0));
+    m_pruneLabel->setText(QString("%1 (奇偶 %2 / 死角 %3 / 连通 %4 / 定界 %5)")
+                          .arg(stats.totalPrunes())
+                          .arg(stats.prunes[SearchStats::PruneParity])
+                          .arg(stats.prunes[SearchStats::PruneDeadEnd])
+                          .arg(stats.prunes[SearchStats::PruneConnectivity])
+                          .arg(stats.prunes[SearchStats::PruneBound]));
+    m_backtrackLabel->setText(QString::number(stats.backtracks));
+    m_depthLabel->setText(QString("%1 / %2").arg(stats.maxDepth).arg(stats.depthLimit));
+    m_elapsedLabel->setText(QString("%1 s").arg(stats.elapsedMs / 1000.0, 0, 'f', 1));
+    m_histogramLabel->setText(stats.histogramText());
+}
+
 void ControlPanel::setGridSize(int width, int height) {
     m_widthSpinBox->setValue(width);
     m_heightSpinBox->setValue(height);
@@ -230,6 +413,15 @@ void ControlPanel::updateCalculationButtons(CalculationState state) {
             m_pauseResumeButton->setText("暂停");
             m_stopButton->setEnabled(false);
             m_resetButton->setEnabled(true);
+            m_algorithmCombo->setEnabled(true);
+            m_neighborhoodCombo->setEnabled(true);
+            m_maxPathsSpinBox->setEnabled(true);
+            m_nodeBudgetSpinBox->setEnabled(true);
+            m_timeBudgetSpinBox->setEnabled(true);
+            m_memoryBudgetSpinBox->setEnabled(true);
+            m_objectiveCombo->setEnabled(getSelectedAlgorithm() == AlgorithmType::DFS);
+            m_moveOrderCombo->setEnabled(getSelectedAlgorithm() == AlgorithmType::DFS);
+            m_endpointCombo->setEnabled(getSelectedAlgorithm() == AlgorithmType::DFS);
             break;
             
         case CalculationState::Running:
@@ -238,6 +430,15 @@ void ControlPanel::updateCalculationButtons(CalculationState state) {
             m_pauseResumeButton->setText("暂停");
             m_stopButton->setEnabled(true);
             m_resetButton->setEnabled(false);
+            m_algorithmCombo->setEnabled(false);
+            m_neighborhoodCombo->setEnabled(false);
+            m_maxPathsSpinBox->setEnabled(false);
+            m_nodeBudgetSpinBox->setEnabled(false);
+            m_timeBudgetSpinBox->setEnabled(false);
+            m_memoryBudgetSpinBox->setEnabled(false);
+            m_objectiveCombo->setEnabled(false);
+            m_moveOrderCombo->setEnabled(false);
+            m_endpointCombo->setEnabled(false);
             break;
             
         case CalculationState::Paused:
@@ -246,6 +447,15 @@ void ControlPanel::updateCalculationButtons(CalculationState state) {
             m_pauseResumeButton->setText("继续");
             m_stopButton->setEnabled(true);
             m_resetButton->setEnabled(false);
+            m_algorithmCombo->setEnabled(false);
+            m_neighborhoodCombo->setEnabled(false);
+            m_maxPathsSpinBox->setEnabled(false);
+            m_nodeBudgetSpinBox->setEnabled(false);
+            m_timeBudgetSpinBox->setEnabled(false);
+            m_memoryBudgetSpinBox->setEnabled(false);
+            m_objectiveCombo->setEnabled(false);
+            m_moveOrderCombo->setEnabled(false);
+            m_endpointCombo->setEnabled(false);
             break;
     }
 }
@@ -257,14 +467,22 @@ void ControlPanel::onApplyGridSize() {
 
 void ControlPanel::onStartPointMode() {
     m_setEndButton->setChecked(false);
+    m_setWeightButton->setChecked(false);
     emit setStartPointMode();
 }
 
 void ControlPanel::onEndPointMode() {
     m_setStartButton->setChecked(false);
+    m_setWeightButton->setChecked(false);
     emit setEndPointMode();
 }
 
+void ControlPanel::onWeightMode() {
+    m_setStartButton->setChecked(false);
+    m_setEndButton->setChecked(false);
+    emit setWeightMode(m_setWeightButton->isChecked());
+}
+
 void ControlPanel::onStartCalculation() {
     emit startCalculation();
 }
@@ -2,6 +2,8 @@
 #define CONTROLPANEL_H
 
 #include "Common.h"
+#include "SearchBudget.h"
+#include "SearchStats.h"
 #include <QWidget>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -24,10 +26,18 @@ public:
     int getGridHeight() const;
     AlgorithmType getSelectedAlgorithm() const;
     AlgorithmType getCurrentAlgorithm() const { return getSelectedAlgorithm(); }  // 添加别名
+    int getMaxPaths() const;
+    PathObjective getObjective() const;
+    NeighborhoodType getNeighborhood() const;
+    MoveOrder getMoveOrder() const;
+    EndpointMode getEndpointMode() const;
+    SearchBudget getBudget() const;
+    double getCellWeight() const;
     
     // 设置控件状态
     void setCalculationState(CalculationState state);
     void updateProgress(int percentage);
+    void updateSearchStats(const SearchStats::Snapshot& stats);
     void setGridSize(int width, int height);
 
 signals:
@@ -38,6 +48,7 @@ signals:
     // 点设置信号
     void setStartPointMode();
     void setEndPointMode();
+    void setWeightMode(bool enabled);
     
     // 计算控制信号
     void startCalculation();
@@ -54,6 +65,7 @@ private slots:
     void onApplyGridSize();
     void onStartPointMode();
     void onEndPointMode();
+    void onWeightMode();
     void onStartCalculation();
     void onPauseResume();
     void onStopCalculation();
@@ -66,6 +78,7 @@ private:
     void setupGridSizeGroup();
     void setupPointControlGroup();
     void setupCalculationGroup();
+    void setupStatsGroup();
     void setupSaveGroup();
     void setupConnections();
     void updateCalculationButtons(CalculationState state);
@@ -80,10 +93,20 @@ private:
     QGroupBox* m_pointControlGroup;
     QPushButton* m_setStartButton;
     QPushButton* m_setEndButton;
+    QSpinBox* m_weightSpinBox;
+    QPushButton* m_setWeightButton;
     
     // 计算控制
     QGroupBox* m_calculationGroup;
     QComboBox* m_algorithmCombo;
+    QSpinBox* m_maxPathsSpinBox;
+    QComboBox* m_objectiveCombo;
+    QComboBox* m_moveOrderCombo;
+    QComboBox* m_endpointCombo;
+    QSpinBox* m_nodeBudgetSpinBox;      // 百万节点
+    QSpinBox* m_timeBudgetSpinBox;      // 秒
+    QSpinBox* m_memoryBudgetSpinBox;    // MB
+    QComboBox* m_neighborhoodCombo;
     QPushButton* m_startButton;
     QPushButton* m_pauseResumeButton;
     QPushButton* m_stopButton;
@@ -91,6 +114,16 @@ private:
     QProgressBar* m_progressBar;
     QLabel* m_statusLabel;
     
+    // 搜索统计
+    QGroupBox* m_statsGroup;
+    QLabel* m_nodesLabel;
+    QLabel* m_rateLabel;
+    QLabel* m_pruneLabel;
+    QLabel* m_backtrackLabel;
+    QLabel* m_depthLabel;
+    QLabel* m_elapsedLabel;
+    QLabel* m_histogramLabel;
+    
     // 结果保存
     QGroupBox* m_saveGroup;
     QPushButton* m_saveXmlButton;
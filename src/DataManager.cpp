@@ -5,12 +5,13 @@
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QSqlError>
+#include <QSqlRecord>
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QXmlStreamWriter>
 #include <QXmlStreamReader>
-#include <QApplication>
+#include <QCoreApplication>
 #include <QStandardPaths>
 #include <QDebug>
 
@@ -26,7 +27,7 @@ DataManager::~DataManager() {
 
 void DataManager::initializeDataDirectory() {
     // 获取应用程序目录下的data文件夹
-    QString appDir = QApplication::applicationDirPath();
+    QString appDir = QCoreApplication::applicationDirPath();
     m_dataDirectory = QDir(appDir).absoluteFilePath("data");
     
     // 创建data目录（如果不存在）
@@ -101,6 +102,7 @@ bool DataManager::saveToXml(const QString& filename, const QVector<PathResult>&
         QDomElement resultElement = doc.createElement("PathResult");
         
         // 基本信息
+        resultElement.setAttribute("uuid", result.uuid());
         resultElement.setAttribute("algorithm", static_cast<int>(result.algorithm()));
         resultElement.setAttribute("algorithmName", result.algorithmString());
         resultElement.setAttribute("pathLength", result.pathLength());
@@ -215,6 +217,9 @@ QVector<PathResult> DataManager::loadFromXml(const QString& filename) {
         // 创建路径结果
         PathResult result("", startPoint, endPoint, path, algorithm, calculationTime);
         result.setTimestamp(timestamp);
+        if (resultElement.hasAttribute("uuid")) {
+            result.setUuid(resultElement.attribute("uuid"));
+        }
         results.append(result);
     }
     
@@ -246,7 +251,8 @@ bool DataManager::saveToSqlite(const QString& filename, const QVector<PathResult
             path_length INTEGER NOT NULL,
             calculation_time INTEGER NOT NULL,
             timestamp TEXT NOT NULL,
-            path_data TEXT NOT NULL
+            path_data TEXT NOT NULL,
+            uuid TEXT
         )
     )";
     
@@ -257,6 +263,11 @@ bool DataManager::saveToSqlite(const QString& filename, const QVector<PathResult
         return false;
     }
     
+    // 旧版本创建的表没有uuid列，补上
+    if (!db.record("path_results").contains("uuid")) {
+        query.exec("ALTER TABLE path_results ADD COLUMN uuid TEXT");
+    }
+    
     // 开始事务
     db.transaction();
     
@@ -264,8 +275,8 @@ bool DataManager::saveToSqlite(const QString& filename, const QVector<PathResult
     QString insertSQL = R"(
         INSERT INTO path_results (
             algorithm, algorithm_name, start_x, start_y, end_x, end_y,
-            path_length, calculation_time, timestamp, path_data
-        ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+            path_length, calculation_time, timestamp, path_data, uuid
+        ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
     )";
     
     query.prepare(insertSQL);
@@ -293,6 +304,7 @@ bool DataManager::saveToSqlite(const QString& filename, const QVector<PathResult
         query.bindValue(7, result.calculationTime());
         query.bindValue(8, result.timestamp().toString(Qt::ISODate));
         query.bindValue(9, pathData);
+        query.bindValue(10, result.uuid());
         
         if (query.exec()) {
             successCount++;
@@ -332,14 +344,15 @@ QVector<PathResult> DataManager::loadFromSqlite(const QString& filename) {
         return results;
     }
     
-    // 查询数据
+    // 查询数据；旧版本的文件没有uuid列
+    const bool hasUuid = db.record("path_results").contains("uuid");
     QSqlQuery query(db);
-    QString selectSQL = R"(
+    QString selectSQL = QString(R"(
         SELECT algorithm, algorithm_name, start_x, start_y, end_x, end_y,
-               path_length, calculation_time, timestamp, path_data
+               path_length, calculation_time, timestamp, path_data%1
         FROM path_results
         ORDER BY id
-    )";
+    )").arg(hasUuid ? ", uuid" : "");
     
     if (!query.exec(selectSQL)) {
         db.close();
@@ -376,6 +389,9 @@ QVector<PathResult> DataManager::loadFromSqlite(const QString& filename) {
         // 创建路径结果
         PathResult result("", startPoint, endPoint, path, algorithm, calculationTime);
         result.setTimestamp(timestamp);
+        if (hasUuid && !query.value(10).toString().isEmpty()) {
+            result.setUuid(query.value(10).toString());
+        }
         results.append(result);
     }
     
@@ -529,6 +545,7 @@ void DataManager::closeSqliteConnection() {
 void DataManager::writePathResultToXml(QXmlStreamWriter& writer, const PathResult& result, int index) {
     writer.writeStartElement("PathResult");
     writer.writeAttribute("id", QString::number(index));
+    writer.writeAttribute("uuid", result.uuid());
     writer.writeAttribute("algorithm", QString::number(static_cast<int>(result.algorithm())));
     writer.writeAttribute("algorithmName", result.algorithmString());
     writer.writeAttribute("pathLength", QString::number(result.pathLength()));
@@ -569,6 +586,7 @@ PathResult DataManager::readPathResultFromXml(QXmlStreamReader& reader) {
         AlgorithmType algorithm = static_cast<AlgorithmType>(attrs.value("algorithm").toInt());
         qint64 calculationTime = attrs.value("calculationTime").toLongLong();
         QDateTime timestamp = QDateTime::fromString(attrs.value("timestamp").toString(), Qt::ISODate);
+        const QString uuid = attrs.value("uuid").toString();
         
         QPoint startPoint, endPoint;
         QVector<QPoint> path;
@@ -600,6 +618,9 @@ PathResult DataManager::readPathResultFromXml(QXmlStreamReader& reader) {
         
         result = PathResult("", startPoint, endPoint, path, algorithm, calculationTime);
         result.setTimestamp(timestamp);
+        if (!uuid.isEmpty()) {
+            result.setUuid(uuid);
+        }
     }
     
     return result;
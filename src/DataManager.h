@@ -1,7 +1,7 @@
 #ifndef DATAMANAGER_H
 #define DATAMANAGER_H
 
-#include "Common.h"
+#include "GridTypes.h"
 #include "PathResult.h"
 #include <QObject>
 #include <QString>
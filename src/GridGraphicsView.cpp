@@ -15,6 +15,7 @@ GridGraphicsView::GridGraphicsView(QWidget* parent)
     , m_scene(nullptr)
     , m_gridWidth(5)  // 直接使用数值
     , m_gridHeight(5) // 直接使用数值
+    , m_snapshotDirty(true)
     , m_startPoint(0, 0)
     , m_endPoint(1, 1)
     , m_scaleFactor(1.0)
@@ -73,17 +74,12 @@ void GridGraphicsView::createGrid(int width, int height) {
         m_gridHeight = height;
         
         qDebug() << "初始化网格数据...";
-        m_gridData.resize(m_gridHeight);
+        m_gridData = GridModel(m_gridWidth, m_gridHeight);
+        m_snapshotDirty = true;
         m_pointItems.resize(m_gridHeight);
         
         for (int y = 0; y < m_gridHeight; ++y) {
-            m_gridData[y].resize(m_gridWidth);
-            m_pointItems[y].resize(m_gridWidth);
-            
-            for (int x = 0; x < m_gridWidth; ++x) {
-                m_gridData[y][x] = GridPoint(x, y, PointType::Normal);
-                m_pointItems[y][x] = nullptr;
-            }
+            m_pointItems[y].fill(nullptr, m_gridWidth);
         }
         
         qDebug() << "创建网格点（不创建网格线）...";
@@ -114,10 +110,12 @@ void GridGraphicsView::clearGrid() {
         m_scene->clear();
         
         qDebug() << "清理数据结构...";
-        m_gridData.clear();
+        m_gridData = GridModel();
+        m_snapshotDirty = true;
         m_pointItems.clear();
         m_gridLines.clear();
         m_pathArrows.clear();  // 清空路径箭头容器
+        m_heatItems.clear();
         
         m_startPoint = QPoint(-1, -1);
         m_endPoint = QPoint(-1, -1);
@@ -131,9 +129,13 @@ void GridGraphicsView::clearGrid() {
 }
 
 void GridGraphicsView::resetGrid() {
+    m_gridData.reset();
+    m_snapshotDirty = true;
     for (int y = 0; y < m_gridHeight; ++y) {
         for (int x = 0; x < m_gridWidth; ++x) {
-            m_gridData[y][x].reset();
+            if (m_pointItems[y][x]) {
+                m_pointItems[y][x]->setToolTip(QString());   // 权重已随网格重置
+            }
             updatePointAppearance(x, y);
         }
     }
@@ -141,6 +143,7 @@ void GridGraphicsView::resetGrid() {
     m_startPoint = QPoint(-1, -1);
     m_endPoint = QPoint(-1, -1);
     clearPath();
+    clearHeatmap();
 }
 
 void GridGraphicsView::createGridLines() {
@@ -191,7 +194,8 @@ void GridGraphicsView::setPointType(int x, int y, PointType type) {
         return;
     }
     
-    m_gridData[y][x].setType(type);
+    m_gridData.setType(x, y, type);
+    m_snapshotDirty = true;
     updatePointAppearance(x, y);
     
     if (type == PointType::Start) {
@@ -203,12 +207,32 @@ void GridGraphicsView::setPointType(int x, int y, PointType type) {
     }
 }
 
+void GridGraphicsView::setPointWeight(int x, int y, double weight) {
+    if (x < 0 || x >= m_gridWidth || y < 0 || y >= m_gridHeight) {
+        return;
+    }
+    
+    m_gridData.setWeight(m_gridData.index(x, y), weight);
+    m_snapshotDirty = true;
+    if (QGraphicsEllipseItem* item = m_pointItems[y][x]) {
+        item->setToolTip(QString("(%1,%2) 权重 %3").arg(x).arg(y).arg(weight));
+    }
+}
+
+GridSnapshotPtr GridGraphicsView::snapshot() const {
+    if (m_snapshotDirty || !m_snapshot) {
+        m_snapshot = GridSnapshot::update(m_snapshot, m_gridData);
+        m_snapshotDirty = false;
+    }
+    return m_snapshot;
+}
+
 PointType GridGraphicsView::getPointType(int x, int y) const {
     if (x < 0 || x >= m_gridWidth || y < 0 || y >= m_gridHeight) {
         return PointType::Normal;
     }
     
-    return m_gridData[y][x].type();
+    return m_gridData.type(x, y);
 }
 
 void GridGraphicsView::updatePointAppearance(int x, int y) {
@@ -219,7 +243,7 @@ void GridGraphicsView::updatePointAppearance(int x, int y) {
     QGraphicsEllipseItem* item = m_pointItems[y][x];
     if (!item) return;
     
-    PointType type = m_gridData[y][x].type();
+    PointType type = m_gridData.type(x, y);
     QColor color = getPointColor(type);
     
     item->setBrush(QBrush(color));
@@ -269,8 +293,9 @@ void GridGraphicsView::clearPath() {
         // 重置路径点的颜色
         for (int y = 0; y < m_gridHeight; ++y) {
             for (int x = 0; x < m_gridWidth; ++x) {
-                if (m_gridData[y][x].type() == PointType::Path) {
-                    m_gridData[y][x].setType(PointType::Normal);
+                if (m_gridData.type(x, y) == PointType::Path) {
+                    m_gridData.setType(x, y, PointType::Normal);
+                    m_snapshotDirty = true;
                     updatePointAppearance(x, y);
                 }
             }
@@ -284,6 +309,54 @@ void GridGraphicsView::clearPath() {
     }
 }
 
+void GridGraphicsView::showHeatmap(const QVector<quint64>& counts) {
+    if (!m_scene || counts.size() != m_gridWidth * m_gridHeight) {
+        return;
+    }
+    
+    // 第一次显示时创建底色方块，放在格子点和路径箭头下面
+    if (m_heatItems.isEmpty()) {
+        const double half = Constants::GRID_SPACING / 2.0;
+        for (int y = 0; y < m_gridHeight; ++y) {
+            for (int x = 0; x < m_gridWidth; ++x) {
+                QPointF center = gridToScene(x, y);
+                QGraphicsRectItem* item = m_scene->addRect(center.x() - half, center.y() - half,
+                                                           Constants::GRID_SPACING, Constants::GRID_SPACING,
+                                                           Qt::NoPen, Qt::NoBrush);
+                item->setZValue(-1);
+                m_heatItems.append(item);
+            }
+        }
+    }
+    
+    quint64 maximum = 0;
+    for (quint64 count : counts) {
+        maximum = qMax(maximum, count);
+    }
+    const double scale = std::log1p(static_cast<double>(maximum));
+    
+    // 路径数跨越多个数量级，按对数从浅黄过渡到深红；没有路径的格子不着色
+    for (int i = 0; i < counts.size(); ++i) {
+        QGraphicsRectItem* item = m_heatItems[i];
+        if (counts[i] == 0) {
+            item->setBrush(Qt::NoBrush);
+            item->setToolTip(QString());
+            continue;
+        }
+        const double t = scale > 0 ? std::log1p(static_cast<double>(counts[i])) / scale : 1.0;
+        item->setBrush(QColor::fromHsvF((60.0 - 60.0 * t) / 360.0, 0.3 + 0.7 * t, 1.0, 0.7));
+        item->setToolTip(QString("终点 (%1,%2)：%3 条路径").arg(i % m_gridWidth).arg(i / m_gridWidth).arg(counts[i]));
+    }
+}
+
+void GridGraphicsView::clearHeatmap() {
+    for (QGraphicsRectItem* item : m_heatItems) {
+        m_scene->removeItem(item);
+        delete item;
+    }
+    m_heatItems.clear();
+}
+
 void GridGraphicsView::drawArrow(const QPointF& start, const QPointF& end, const QPen& pen) {
     if (!m_scene) return;
     
@@ -2,13 +2,14 @@
 #define GRIDGRAPHICSVIEW_H
 
 #include "Common.h"
-#include "GridPoint.h"
+#include "GridSnapshot.h"
 #include "ArrowRenderer.h"
 #include "ArrowGraphicsItem.h"
 #include <QGraphicsView>
 #include <QGraphicsScene>
 #include <QGraphicsEllipseItem>
 #include <QGraphicsLineItem>
+#include <QGraphicsRectItem>
 #include <QVector>
 #include <QMouseEvent>
 #include <QWheelEvent>
@@ -28,17 +29,26 @@ public:
     // 点操作
     void setPointType(int x, int y, PointType type);
     PointType getPointType(int x, int y) const;
+    void setPointWeight(int x, int y, double weight);
     
     // 路径显示
     void showPath(const QVector<QPoint>& path);
     void clearPath();
     
+    // 终点热力图：按各格子作为终点的路径数给格子铺底色，数量按对数映射到颜色深浅
+    // counts按行优先下标，长度须等于格子数；可反复调用以刷新
+    void showHeatmap(const QVector<quint64>& counts);
+    void clearHeatmap();
+    
     // 网格信息
     int gridWidth() const { return m_gridWidth; }
     int gridHeight() const { return m_gridHeight; }
     
     // 获取网格数据
-    const QVector<QVector<GridPoint>>& getGrid() const { return m_gridData; }
+    const GridModel& getGrid() const { return m_gridData; }
+    
+    // 当前网格的不可变快照；网格未编辑时重复调用返回同一个快照，内容未变时不产生新版本
+    GridSnapshotPtr snapshot() const;
     
     // 起点终点操作
     void setStartPoint(const QPoint& point);
@@ -76,12 +86,15 @@ private:
     int m_gridHeight;
     
     // 网格数据
-    QVector<QVector<GridPoint>> m_gridData;
+    GridModel m_gridData;
+    mutable GridSnapshotPtr m_snapshot;
+    mutable bool m_snapshotDirty;
     
     // 图形项
     QVector<QVector<QGraphicsEllipseItem*>> m_pointItems;
     QVector<QGraphicsLineItem*> m_gridLines;
     QVector<ArrowGraphicsItem*> m_pathArrows;  // 改为箭头图形项
+    QVector<QGraphicsRectItem*> m_heatItems;   // 热力图底色，每格一个，未显示时为空
     
     // 起点终点
     QPoint m_startPoint;
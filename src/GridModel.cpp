@@ -0,0 +1,109 @@
+#include "GridModel.h"
+#include <cstring>
+
+namespace {
+// FNV-1a，逐字节混入
+void mix(quint64& hash, quint64 value) {
+    for (int i = 0; i < 8; ++i) {
+        hash ^= (value >> (i * 8)) & 0xff;
+        hash *= 1099511628211ULL;
+    }
+}
+}
+
+GridModel::GridModel()
+    : m_width(0)
+    , m_height(0)
+    , m_walkableCount(0)
+{
+}
+
+GridModel::GridModel(int width, int height, PointType fill)
+    : m_width(width)
+    , m_height(height)
+    , m_types(width * height, static_cast<quint8>(fill))
+    , m_walkable((width * height + 63) / 64, 0)
+    , m_walkableCount(0)
+{
+    if (isWalkableType(fill)) {
+        for (int i = 0; i < cellCount(); ++i) {
+            m_walkable[i >> 6] |= quint64(1) << (i & 63);
+        }
+        m_walkableCount = cellCount();
+    }
+}
+
+void GridModel::setType(int index, PointType type) {
+    const bool wasWalkable = isWalkable(index);
+    const bool walkable = isWalkableType(type);
+    m_types[index] = static_cast<quint8>(type);
+    if (walkable != wasWalkable) {
+        m_walkable[index >> 6] ^= quint64(1) << (index & 63);
+        m_walkableCount += walkable ? 1 : -1;
+    }
+}
+
+void GridModel::replaceType(PointType from, PointType to) {
+    for (int i = 0; i < cellCount(); ++i) {
+        if (type(i) == from) {
+            setType(i, to);
+        }
+    }
+}
+
+void GridModel::setWeight(int index, double weight) {
+    if (m_weights.isEmpty()) {
+        m_weights.resize(cellCount());
+        for (int i = 0; i < cellCount(); ++i) {
+            m_weights[i] = defaultWeight(type(i));
+        }
+    }
+    m_weights[index] = weight;
+}
+
+void GridModel::setFlags(int index, quint8 flags) {
+    if (m_flags.isEmpty()) {
+        m_flags.fill(0, cellCount());
+    }
+    m_flags[index] = flags;
+}
+
+void GridModel::reset() {
+    *this = GridModel(m_width, m_height);
+}
+
+quint64 GridModel::contentHash() const {
+    quint64 hash = 14695981039346656037ULL;
+    mix(hash, static_cast<quint64>(m_height));
+    mix(hash, static_cast<quint64>(m_width));
+    for (quint64 bits : m_walkable) {
+        mix(hash, bits);
+    }
+    // 未分配权重平面时权重由可通行性决定，已经包含在位图中
+    if (hasWeights()) {
+        for (double weight : m_weights) {
+            quint64 bits;
+            std::memcpy(&bits, &weight, sizeof(bits));
+            mix(hash, bits);
+        }
+    }
+    return hash;
+}
+
+bool GridModel::sameContent(const GridModel& other) const {
+    // 只有一方分配了权重平面时按不同处理，与哈希的取舍一致
+    return m_width == other.m_width && m_height == other.m_height &&
+           m_walkable == other.m_walkable && m_weights == other.m_weights;
+}
+
+double GridModel::defaultWeight(PointType type) {
+    switch (type) {
+        case PointType::Obstacle:
+            return 999999.0; // 障碍物权重非常高
+        case PointType::Start:
+        case PointType::End:
+        case PointType::Normal:
+        default:
+            return 1.0; // 正常路径权重为1
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef GRIDMODEL_H
+#define GRIDMODEL_H
+
+#include "GridTypes.h"
+#include <QPoint>
+#include <QVector>
+#include <QtGlobal>
+
+// 扁平网格模型
+// 按行优先存放每格一个字节的点类型，另有可通行位图（每格1位）；
+// 权重和标志平面只在用到时分配，未分配时权重由点类型决定、标志为0
+// 100x100的网格类型平面约10KB、位图约1.3KB，搜索时可以整体留在L1/L2中
+class GridModel {
+public:
+    GridModel();
+    GridModel(int width, int height, PointType fill = PointType::Normal);
+
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    int cellCount() const { return m_types.size(); }
+    bool isEmpty() const { return m_types.isEmpty(); }
+
+    // 坐标与行优先下标的换算
+    int index(int x, int y) const { return y * m_width + x; }
+    int index(const QPoint& point) const { return index(point.x(), point.y()); }
+    QPoint toPoint(int index) const { return QPoint(index % m_width, index / m_width); }
+    bool contains(int x, int y) const { return x >= 0 && x < m_width && y >= 0 && y < m_height; }
+    bool contains(const QPoint& point) const { return contains(point.x(), point.y()); }
+
+    // 点类型
+    PointType type(int index) const { return static_cast<PointType>(m_types[index]); }
+    PointType type(int x, int y) const { return type(index(x, y)); }
+    void setType(int index, PointType type);
+    void setType(int x, int y, PointType type) { setType(index(x, y), type); }
+    void replaceType(PointType from, PointType to);
+
+    // 可通行位图：第i格在 bits[i/64] 的第 i%64 位
+    bool isWalkable(int index) const { return (m_walkable[index >> 6] >> (index & 63)) & 1; }
+    bool isWalkable(int x, int y) const { return contains(x, y) && isWalkable(index(x, y)); }
+    bool isWalkable(const QPoint& point) const { return isWalkable(point.x(), point.y()); }
+    const QVector<quint64>& walkableBits() const { return m_walkable; }
+    int walkableCount() const { return m_walkableCount; }
+
+    // 进入格子的代价
+    double weight(int index) const {
+        return m_weights.isEmpty() ? defaultWeight(type(index)) : m_weights[index];
+    }
+    bool hasWeights() const { return !m_weights.isEmpty(); }
+    void setWeight(int index, double weight);
+    void clearWeights() { m_weights.clear(); }
+
+    // 附加标志（界面标记等），引擎不读取
+    quint8 flags(int index) const { return m_flags.isEmpty() ? 0 : m_flags[index]; }
+    void setFlags(int index, quint8 flags);
+    void clearFlags() { m_flags.clear(); }
+
+    // 全部恢复为普通点，并释放权重和标志平面
+    void reset();
+
+    // 覆盖尺寸、可通行性和权重；标志平面和路径显示等纯界面状态不参与
+    quint64 contentHash() const;
+    // 与contentHash()覆盖的内容逐项比较；哈希相同不代表内容相同，复用快照前需要确认
+    bool sameContent(const GridModel& other) const;
+
+    static double defaultWeight(PointType type);
+    static bool isWalkableType(PointType type) { return type != PointType::Obstacle; }
+
+private:
+    int m_width;
+    int m_height;
+    QVector<quint8> m_types;
+    QVector<quint64> m_walkable;
+    QVector<double> m_weights;
+    QVector<quint8> m_flags;
+    int m_walkableCount;
+};
+
+#endif // GRIDMODEL_H
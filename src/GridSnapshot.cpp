@@ -0,0 +1,30 @@
+#include "GridSnapshot.h"
+#include <atomic>
+
+namespace {
+quint64 nextVersion() {
+    static std::atomic<quint64> counter(0);
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+}
+
+GridSnapshot::GridSnapshot(const GridModel& grid, quint64 hash)
+    : m_grid(grid)
+    , m_version(nextVersion())
+    , m_hash(hash)
+{
+}
+
+GridSnapshotPtr GridSnapshot::create(const GridModel& grid) {
+    return GridSnapshotPtr(new GridSnapshot(grid, grid.contentHash()));
+}
+
+GridSnapshotPtr GridSnapshot::update(const GridSnapshotPtr& previous,
+                                     const GridModel& grid) {
+    // 哈希只用来快速排除不同的内容，相同时仍逐项比较，避免碰撞时沿用旧网格
+    const quint64 hash = grid.contentHash();
+    if (previous && previous->m_hash == hash && previous->m_grid.sameContent(grid)) {
+        return previous;
+    }
+    return GridSnapshotPtr(new GridSnapshot(grid, hash));
+}
@@ -0,0 +1,41 @@
+#ifndef GRIDSNAPSHOT_H
+#define GRIDSNAPSHOT_H
+
+#include "GridModel.h"
+#include <QSharedPointer>
+#include <QtGlobal>
+
+class GridSnapshot;
+typedef QSharedPointer<const GridSnapshot> GridSnapshotPtr;
+
+// 不可变的网格快照
+// 界面每次编辑后最多生成一个新快照，提交任务时只传递共享指针，
+// 每个任务固定引用提交时的快照，工作线程读取时不需要加锁，也不会因界面继续编辑而看到半改的网格
+//
+// 版本号在进程内单调递增；内容哈希只覆盖引擎关心的内容（尺寸、可通行性、权重），
+// 显示路径等界面状态的变化不会产生新版本
+class GridSnapshot {
+public:
+    static GridSnapshotPtr create(const GridModel& grid);
+
+    // 内容与grid相同时复用previous，否则创建新快照；哈希相同时还会逐项比较内容
+    static GridSnapshotPtr update(const GridSnapshotPtr& previous,
+                                  const GridModel& grid);
+
+    const GridModel& grid() const { return m_grid; }
+    quint64 version() const { return m_version; }
+    quint64 hash() const { return m_hash; }
+    int width() const { return m_grid.width(); }
+    int height() const { return m_grid.height(); }
+    int walkableCount() const { return m_grid.walkableCount(); }
+    bool isEmpty() const { return m_grid.isEmpty(); }
+
+private:
+    GridSnapshot(const GridModel& grid, quint64 hash);
+
+    const GridModel m_grid;
+    const quint64 m_version;
+    const quint64 m_hash;
+};
+
+#endif // GRIDSNAPSHOT_H
@@ -0,0 +1,92 @@
+#include "GridTypes.h"
+
+QString algorithmTypeToString(AlgorithmType type) {
+    switch (type) {
+        case AlgorithmType::AStar: return "A*";
+        case AlgorithmType::Dijkstra: return "Dijkstra";
+        case AlgorithmType::BFS: return "BFS";
+        case AlgorithmType::DFS: return "DFS";
+        default: return "Unknown";
+    }
+}
+
+AlgorithmType stringToAlgorithmType(const QString& str) {
+    if (str == "A*") return AlgorithmType::AStar;
+    if (str == "Dijkstra") return AlgorithmType::Dijkstra;
+    if (str == "BFS") return AlgorithmType::BFS;
+    if (str == "DFS") return AlgorithmType::DFS;
+    return AlgorithmType::AStar; // 默认值
+}
+
+QString pointTypeToString(PointType type) {
+    switch (type) {
+        case PointType::Normal: return "Normal";
+        case PointType::Start: return "Start";
+        case PointType::End: return "End";
+        case PointType::Path: return "Path";
+        case PointType::Obstacle: return "Obstacle";
+        default: return "Unknown";
+    }
+}
+
+QString neighborhoodTypeToString(NeighborhoodType type) {
+    switch (type) {
+        case NeighborhoodType::Four: return "four";
+        case NeighborhoodType::Eight: return "eight";
+        case NeighborhoodType::EightNoCornerCutting: return "eightNoCornerCutting";
+        case NeighborhoodType::Hex: return "hex";
+        case NeighborhoodType::Knight: return "knight";
+        default: return "unknown";
+    }
+}
+
+NeighborhoodType stringToNeighborhoodType(const QString& str, bool* ok) {
+    if (ok) *ok = true;
+    if (str == "four") return NeighborhoodType::Four;
+    if (str == "eight") return NeighborhoodType::Eight;
+    if (str == "eightNoCornerCutting") return NeighborhoodType::EightNoCornerCutting;
+    if (str == "hex") return NeighborhoodType::Hex;
+    if (str == "knight") return NeighborhoodType::Knight;
+    if (ok) *ok = false;
+    return NeighborhoodType::Four;
+}
+
+QString moveOrderToString(MoveOrder order) {
+    switch (order) {
+        case MoveOrder::Natural: return "natural";
+        case MoveOrder::Warnsdorff: return "warnsdorff";
+        case MoveOrder::WallHugging: return "wallHugging";
+        case MoveOrder::DistanceToEnd: return "distanceToEnd";
+        case MoveOrder::Random: return "random";
+        default: return "unknown";
+    }
+}
+
+MoveOrder stringToMoveOrder(const QString& str, bool* ok) {
+    if (ok) *ok = true;
+    if (str == "natural") return MoveOrder::Natural;
+    if (str == "warnsdorff") return MoveOrder::Warnsdorff;
+    if (str == "wallHugging") return MoveOrder::WallHugging;
+    if (str == "distanceToEnd") return MoveOrder::DistanceToEnd;
+    if (str == "random") return MoveOrder::Random;
+    if (ok) *ok = false;
+    return MoveOrder::Natural;
+}
+
+QString endpointModeToString(EndpointMode mode) {
+    switch (mode) {
+        case EndpointMode::Fixed: return "fixed";
+        case EndpointMode::FreeEnd: return "freeEnd";
+        case EndpointMode::FreeBoth: return "freeBoth";
+        default: return "unknown";
+    }
+}
+
+EndpointMode stringToEndpointMode(const QString& str, bool* ok) {
+    if (ok) *ok = true;
+    if (str == "fixed") return EndpointMode::Fixed;
+    if (str == "freeEnd") return EndpointMode::FreeEnd;
+    if (str == "freeBoth") return EndpointMode::FreeBoth;
+    if (ok) *ok = false;
+    return EndpointMode::Fixed;
+}
@@ -0,0 +1,97 @@
+#ifndef GRIDTYPES_H
+#define GRIDTYPES_H
+
+#include <QString>
+
+// 引擎层公共类型，只依赖QtCore，可在无界面环境下使用
+// 界面相关的颜色等定义在Common.h中
+
+// 点类型枚举
+enum class PointType {
+    Normal,     // 普通点
+    Start,      // 起点
+    End,        // 终点
+    Path,       // 路径点
+    Obstacle    // 障碍点
+};
+
+// 算法类型枚举
+enum class AlgorithmType {
+    AStar,      // A*算法
+    Dijkstra,   // Dijkstra算法
+    BFS,        // 广度优先搜索
+    DFS         // 深度优先搜索
+};
+
+// 哈密顿路径的搜索目标
+enum class PathObjective {
+    Enumerate,  // 依次产出路径，直到路径上限
+    MinWeight,  // 只求总代价最小的一条（分支定界），过程中产出逐步改进的路径
+    MinTurns,   // 只求转弯次数最少的一条（分支定界），过程中产出逐步改进的路径
+    Construct,  // 按矩形的存在性规则直接构造一条，不搜索；只对四邻域有效，形状不支持时退回搜索
+    Portfolio,  // 多种策略在不同线程上竞速求一条，最先给出答案的胜出
+    EndCounts,  // 起点固定、终点任意，一次搜索按终点格子统计路径数，同时产出前若干条路径
+    MeetInTheMiddle // 折半搜索：两端各搜一半再按已访问集合拼接，用内存换时间；只支持不超过64个可通行格子
+};
+
+// 哈密顿路径枚举时子节点的展开顺序，影响找到第一条路径的快慢，不影响结果集合
+enum class MoveOrder {
+    Natural,    // 按邻域的固定顺序（四邻域为上、下、左、右）
+    Warnsdorff,     // 后续可走格子最少的优先
+    WallHugging,    // 贴着边界和障碍走：四周固定不可走的方向最多的优先
+    DistanceToEnd,  // 离终点（按步数）远的优先，终点附近的格子留到最后
+    Random          // 按种子随机打乱
+};
+
+// 哈密顿路径枚举的端点约束；端点自由时所有可能的端点在同一棵搜索树中一起搜索，每条结果带着自己的端点
+enum class EndpointMode {
+    Fixed,      // 起点和终点都固定
+    FreeEnd,    // 起点固定，终点任意
+    FreeBoth    // 起点终点都任意；路径与其反向是同一条，只按起点下标小于终点下标的方向产出一次
+};
+
+// 格子之间的连通方式，对应 Neighborhood.h 中的邻域策略
+enum class NeighborhoodType {
+    Four,                   // 上下左右
+    Eight,                  // 含斜向，允许斜穿障碍拐角
+    EightNoCornerCutting,   // 含斜向，两侧正交格子都可走时才能斜走
+    Hex,                    // 六边形，奇数行右移半格
+    Knight                  // 马步
+};
+
+// 计算状态枚举
+enum class CalculationState {
+    Idle,       // 空闲
+    Running,    // 运行中
+    Paused,     // 暂停
+    Completed,  // 完成
+    Stopped     // 停止
+};
+
+// 常量定义
+namespace Constants {
+    const int DEFAULT_GRID_WIDTH = 5;
+    const int DEFAULT_GRID_HEIGHT = 5;
+    const int MIN_GRID_SIZE = 5;
+    const int MAX_GRID_SIZE = 100;
+    
+    const int DEFAULT_MAX_PATHS = 5000;     // 默认最多产出的路径条数
+    const int MAX_PATHS_LIMIT = 100000;
+    const int PATH_PAGE_SIZE = 200;         // 界面枚举哈密顿路径时每页的条数，滚动到底再取下一页
+}
+
+// 工具函数
+QString algorithmTypeToString(AlgorithmType type);
+AlgorithmType stringToAlgorithmType(const QString& str);
+QString pointTypeToString(PointType type);
+QString neighborhoodTypeToString(NeighborhoodType type);
+// 无法识别时ok为false并返回Four
+NeighborhoodType stringToNeighborhoodType(const QString& str, bool* ok = nullptr);
+QString moveOrderToString(MoveOrder order);
+// 无法识别时ok为false并返回Natural
+MoveOrder stringToMoveOrder(const QString& str, bool* ok = nullptr);
+QString endpointModeToString(EndpointMode mode);
+// 无法识别时ok为false并返回Fixed
+EndpointMode stringToEndpointMode(const QString& str, bool* ok = nullptr);
+
+#endif // GRIDTYPES_H
@@ -0,0 +1,372 @@
+#include "HamiltonianMeetInTheMiddle.h"
+#include <QHash>
+#include <QtAlgorithms>
+#include <cmath>
+#include <limits>
+
+namespace {
+// 连接表每项的估计开销：键、值和哈希表节点；枚举时另加后半段的格子编号
+const int TABLE_ENTRY_BYTES = 48;
+
+// 连接表的键：半段的已访问位集和中点
+struct HalfKey {
+    quint64 mask;
+    int middle;
+
+    bool operator==(const HalfKey& other) const { return mask == other.mask && middle == other.middle; }
+};
+
+inline uint qHash(const HalfKey& key, uint seed = 0) {
+    return ::qHash(key.mask, seed) ^ static_cast<uint>(key.middle * 0x9E3779B1u);
+}
+}
+
+template<class Neighborhood>
+BasicHamiltonianMeetInTheMiddle<Neighborhood>::BasicHamiltonianMeetInTheMiddle(const GridModel& grid)
+    : m_width(grid.width())
+    , m_cellCount(grid.walkableCount())
+    , m_all(0)
+    , m_stats(nullptr)
+    , m_memoryLimit(0)
+    , m_source(-1)
+    , m_target(-1)
+    , m_forwardLength(0)
+    , m_maxPaths(0)
+    , m_stop(false)
+    , m_found(0)
+    , m_pathCount(0)
+    , m_expanded(0)
+    , m_sinceCheckpoint(0)
+    , m_statNodes(0)
+    , m_passes(0)
+    , m_tableBytes(0)
+{
+    QVector<bool> walkable(grid.cellCount());
+    m_cellOf.fill(-1, grid.cellCount());
+    for (int i = 0; i < grid.cellCount(); ++i) {
+        walkable[i] = grid.isWalkable(i);
+        if (walkable[i]) {
+            m_cellOf[i] = m_gridIndex.size();
+            m_gridIndex.append(i);
+        }
+    }
+    if (!isSupported()) {
+        return;
+    }
+
+    // 邻居关系预先转成位集，搜索中只做位运算
+    m_adjacent.fill(0, m_cellCount);
+    int adjacent[Neighborhood::MaxDegree];
+    for (int cell = 0; cell < m_cellCount; ++cell) {
+        const int count = Neighborhood::collect(grid.width(), grid.height(), walkable, m_gridIndex[cell], adjacent);
+        for (int i = 0; i < count; ++i) {
+            m_adjacent[cell] |= bit(m_cellOf[adjacent[i]]);
+        }
+        m_all |= bit(cell);
+    }
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianMeetInTheMiddle<Neighborhood>::parityAllows() const {
+    // 与DFS引擎相同：按 (x+y) 奇偶黑白染色，路径上颜色交替出现
+    int counts[2] = {0, 0};
+    for (int cell = 0; cell < m_cellCount; ++cell) {
+        counts[(m_gridIndex[cell] % m_width + m_gridIndex[cell] / m_width) & 1]++;
+    }
+    const int sourceColor = (m_gridIndex[m_source] % m_width + m_gridIndex[m_source] / m_width) & 1;
+    const int targetColor = (m_gridIndex[m_target] % m_width + m_gridIndex[m_target] / m_width) & 1;
+    if ((m_cellCount & 1) == 0) {
+        return counts[0] == counts[1] && sourceColor != targetColor;
+    }
+    const int majority = counts[0] > counts[1] ? 0 : 1;
+    return counts[majority] == counts[1 - majority] + 1 &&
+           sourceColor == majority && targetColor == majority;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianMeetInTheMiddle<Neighborhood>::prepare(const QPoint& start, const QPoint& end) {
+    m_expanded = 0;
+    m_pathCount = 0;
+    m_found = 0;
+    m_stop = false;
+    m_sinceCheckpoint = 0;
+    m_statNodes = 0;
+    m_passes = 0;
+    m_tableBytes = 0;
+    if (!isSupported() || m_cellCount == 0) {
+        return false;
+    }
+    const int height = m_cellOf.size() / m_width;
+    const auto cellAt = [this, height](const QPoint& p) {
+        if (p.x() < 0 || p.x() >= m_width || p.y() < 0 || p.y() >= height) {
+            return -1;
+        }
+        return m_cellOf[p.y() * m_width + p.x()];
+    };
+    m_source = cellAt(start);
+    m_target = cellAt(end);
+    if (m_source < 0 || m_target < 0 || (m_source == m_target && m_cellCount > 1)) {
+        return false;
+    }
+    if (Neighborhood::Bipartite && !parityAllows()) {
+        if (m_stats) {
+            m_stats->addPrunes(SearchStats::PruneParity, 1);
+        }
+        return false;
+    }
+    // 中点取第 (N-1)/2 步，前半段不长于后半段
+    m_forwardLength = (m_cellCount - 1) / 2 + 1;
+    return true;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianMeetInTheMiddle<Neighborhood>::pruneAfterEnter(const Half& half, int previous, int current) const {
+    // 剩下的格子要能从当前格出发、以target结束一笔走完
+    const Mask remaining = m_all & ~half.visited;
+    if (remaining == 0 || current == half.target) {
+        return false;
+    }
+
+    // 死角：上一格成为路径内部后，它的未访问邻居少了一个可用邻居；
+    // 除target外每个未访问格子都要有两个可用邻居（一进一出），target至少一个
+    if (previous >= 0) {
+        const Mask open = remaining | bit(current);
+        for (Mask around = m_adjacent[previous] & remaining; around; around &= around - 1) {
+            const int cell = qCountTrailingZeroBits(around);
+            if (qPopulationCount(m_adjacent[cell] & open) < (cell == half.target ? 1 : 2)) {
+                if (m_stats) {
+                    m_stats->addPrunes(SearchStats::PruneDeadEnd, 1);
+                }
+                return true;
+            }
+        }
+    }
+
+    // 连通性：从当前格经未访问格子必须能到达全部未访问格子，每个格子只展开一次
+    Mask reached = m_adjacent[current] & remaining;
+    Mask frontier = reached;
+    while (frontier) {
+        const int cell = qCountTrailingZeroBits(frontier);
+        frontier &= frontier - 1;
+        const Mask fresh = m_adjacent[cell] & remaining & ~reached;
+        reached |= fresh;
+        frontier |= fresh;
+    }
+    if (reached != remaining) {
+        if (m_stats) {
+            m_stats->addPrunes(SearchStats::PruneConnectivity, 1);
+        }
+        return true;
+    }
+    return false;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianMeetInTheMiddle<Neighborhood>::checkpoint() {
+    ++m_expanded;
+    ++m_statNodes;
+    if (++m_sinceCheckpoint >= CHECKPOINT_INTERVAL) {
+        m_sinceCheckpoint = 0;
+        if (m_stats) {
+            m_stats->addNodes(m_statNodes);
+            m_statNodes = 0;
+        }
+        if (m_checkpoint && !m_checkpoint()) {
+            m_stop = true;
+        }
+    }
+    return !m_stop;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianMeetInTheMiddle<Neighborhood>::searchHalf(Half& half, int previous, int current,
+                                                               const HalfCallback& onHalf) {
+    if (!checkpoint()) {
+        return false;
+    }
+
+    half.visited |= bit(current);
+    half.cells.append(current);
+
+    bool keepGoing = true;
+    if (!pruneAfterEnter(half, previous, current)) {
+        if (half.cells.size() == half.length) {
+            keepGoing = onHalf(half);
+        } else {
+            for (Mask moves = m_adjacent[current] & ~half.visited & ~half.blocked; moves && keepGoing;
+                 moves &= moves - 1) {
+                keepGoing = searchHalf(half, current, qCountTrailingZeroBits(moves), onHalf);
+            }
+        }
+    }
+
+    half.cells.removeLast();
+    half.visited &= ~bit(current);
+    return keepGoing;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianMeetInTheMiddle<Neighborhood>::runHalf(int from, int target, int length,
+                                                            const HalfCallback& onHalf) {
+    Half half;
+    half.from = from;
+    half.target = target;
+    half.length = length;
+    half.visited = 0;
+    // 半段不会经过另一端，除非另一端就是中点（不超过两个格子时）
+    half.blocked = length < m_cellCount ? bit(target) : 0;
+    half.cells.reserve(length);
+    return searchHalf(half, -1, from, onHalf);
+}
+
+template<class Neighborhood>
+int BasicHamiltonianMeetInTheMiddle<Neighborhood>::partitionOf(Mask mask, int middle) const {
+    if (m_passes <= 1) {
+        return 0;
+    }
+    // splitmix64的混合步，使各批大小接近
+    quint64 h = mask ^ (static_cast<quint64>(middle) * 0x9E3779B97F4A7C15ULL);
+    h ^= h >> 31;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 29;
+    return static_cast<int>(h % static_cast<quint64>(m_passes));
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianMeetInTheMiddle<Neighborhood>::planPasses(int halfBytes) {
+    m_passes = 1;
+    if (m_memoryLimit <= 0) {
+        return true;
+    }
+    // 先只数一遍后半段，估算一次建完整张表的内存，放不下时分批
+    quint64 halves = 0;
+    runHalf(m_target, m_source, m_cellCount - m_forwardLength + 1, [&halves](const Half&) {
+        ++halves;
+        return true;
+    });
+    if (m_stop) {
+        return false;
+    }
+    const double passes = std::ceil(static_cast<double>(halves) * halfBytes / m_memoryLimit);
+    m_passes = static_cast<int>(qBound(1.0, passes, static_cast<double>(std::numeric_limits<int>::max())));
+    return true;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianMeetInTheMiddle<Neighborhood>::join(bool counting) {
+    const int backwardLength = m_cellCount - m_forwardLength + 1;
+    const int halfBytes = TABLE_ENTRY_BYTES + (counting ? 0 : backwardLength + static_cast<int>(sizeof(int)));
+    if (!planPasses(halfBytes)) {
+        return false;
+    }
+
+    QVector<QPoint> path(m_cellCount);
+    for (int pass = 0; pass < m_passes && !m_stop; ++pass) {
+        // 后半段：从终点倒着走到中点，只保留键落在本批的
+        // 计数时同一个键只记条数；枚举时记下各条后半段在arena中的位置
+        QHash<HalfKey, quint64> counts;
+        QHash<HalfKey, QVector<int>> offsets;
+        QVector<quint8> arena;
+        qint64 bytes = 0;
+        runHalf(m_target, m_source, backwardLength, [&](const Half& half) {
+            const int middle = half.cells.last();
+            if (partitionOf(half.visited, middle) != pass) {
+                return true;
+            }
+            const HalfKey key = {half.visited, middle};
+            if (counting) {
+                ++counts[key];
+            } else {
+                offsets[key].append(arena.size());
+                for (int cell : half.cells) {
+                    arena.append(static_cast<quint8>(cell));
+                }
+            }
+            bytes += halfBytes;
+            return true;
+        });
+        m_tableBytes = qMax(m_tableBytes, bytes);
+        if (m_stop || bytes == 0) {
+            continue;
+        }
+
+        // 前半段：从起点走到中点，与之互补的后半段已访问集合只在中点相交
+        runHalf(m_source, m_target, m_forwardLength, [&](const Half& half) {
+            const int middle = half.cells.last();
+            const Mask complement = (m_all & ~half.visited) | bit(middle);
+            if (partitionOf(complement, middle) != pass) {
+                return true;
+            }
+            const HalfKey key = {complement, middle};
+            if (counting) {
+                m_pathCount += counts.value(key, 0);
+                return true;
+            }
+            const QVector<int> matches = offsets.value(key);
+            if (matches.isEmpty()) {
+                return true;
+            }
+            for (int i = 0; i < m_forwardLength; ++i) {
+                path[i] = toPoint(half.cells[i]);
+            }
+            for (int offset : matches) {
+                // 后半段按终点到中点存放，倒过来接在前半段之后，中点只出现一次
+                for (int i = 1; i < backwardLength; ++i) {
+                    path[m_forwardLength - 1 + i] = toPoint(arena[offset + backwardLength - 1 - i]);
+                }
+                ++m_pathCount;
+                ++m_found;
+                if (m_stats) {
+                    m_stats->addPaths(1);
+                }
+                if (!m_onPath(path) || m_found >= m_maxPaths) {
+                    m_stop = true;
+                    return false;
+                }
+            }
+            return true;
+        });
+    }
+    return !m_stop;
+}
+
+template<class Neighborhood>
+void BasicHamiltonianMeetInTheMiddle<Neighborhood>::flushStats() {
+    if (m_stats) {
+        m_stats->addNodes(m_statNodes);
+    }
+    m_statNodes = 0;
+}
+
+template<class Neighborhood>
+quint64 BasicHamiltonianMeetInTheMiddle<Neighborhood>::countPaths(const QPoint& start, const QPoint& end) {
+    if (!prepare(start, end)) {
+        return 0;
+    }
+    join(true);
+    flushStats();
+    if (m_stats) {
+        m_stats->addPaths(m_pathCount);
+    }
+    return m_pathCount;
+}
+
+template<class Neighborhood>
+int BasicHamiltonianMeetInTheMiddle<Neighborhood>::findPaths(const QPoint& start, const QPoint& end, int maxPaths,
+                                                             const PathCallback& onPath) {
+    if (maxPaths <= 0 || !prepare(start, end)) {
+        return 0;
+    }
+    m_maxPaths = maxPaths;
+    m_onPath = onPath;
+    join(false);
+    m_onPath = PathCallback();
+    flushStats();
+    return m_found;
+}
+
+template class BasicHamiltonianMeetInTheMiddle<Neighborhoods::Four>;
+template class BasicHamiltonianMeetInTheMiddle<Neighborhoods::EightAllowCornerCutting>;
+template class BasicHamiltonianMeetInTheMiddle<Neighborhoods::EightNoCornerCutting>;
+template class BasicHamiltonianMeetInTheMiddle<Neighborhoods::Hex>;
+template class BasicHamiltonianMeetInTheMiddle<Neighborhoods::Knight>;
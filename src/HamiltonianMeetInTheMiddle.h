@@ -0,0 +1,110 @@
+#ifndef HAMILTONIANMEETINTHEMIDDLE_H
+#define HAMILTONIANMEETINTHEMIDDLE_H
+
+#include "GridModel.h"
+#include "Neighborhood.h"
+#include "SearchStats.h"
+#include <QVector>
+#include <QPoint>
+#include <functional>
+
+// 折半搜索（meet-in-the-middle）求起点到终点的哈密顿路径，适用于可通行格子不超过64的网格
+// 一条N格的路径在第 (N-1)/2 步处的格子（中点）分成两半：从起点走到中点的前半段，
+// 和从终点倒着走到中点的后半段。两半的已访问集合恰好只在中点相交、并集为全部格子。
+// 后半段按 (已访问位集, 中点) 建成哈希表，前半段边搜索边按互补的键查表拼接，
+// 两侧各只需搜索一半深度，深度40~64格时比单向DFS少展开指数级的节点，代价是连接表的内存
+//
+// 设置内存上限后先数一遍后半段的条数估算表的大小，放不下时按键的哈希分成若干批：
+// 每批只保留哈希落在本批的后半段，前半段重新搜索并只查本批的键，用多次展开换内存（流式连接）
+// 单线程执行；路径产出顺序与DFS引擎不同，结果集合相同
+template<class Neighborhood>
+class BasicHamiltonianMeetInTheMiddle {
+public:
+    using PathCallback = std::function<bool(const QVector<QPoint>& path)>;
+    // 搜索过程中定期回调，返回false停止
+    using CheckpointCallback = std::function<bool()>;
+
+    static const int MAX_CELLS = 64;
+
+    explicit BasicHamiltonianMeetInTheMiddle(const GridModel& grid);
+
+    void setCheckpoint(const CheckpointCallback& checkpoint) { m_checkpoint = checkpoint; }
+    void setStats(SearchStats* stats) { m_stats = stats; }      // 可为空；由调用方负责reset
+    // 连接表的内存上限（字节），超出时改为分批的流式连接；<=0为不限
+    void setMemoryLimit(qint64 bytes) { m_memoryLimit = bytes; }
+
+    // 可通行格子不超过MAX_CELLS时才能使用
+    bool isSupported() const { return m_cellCount <= MAX_CELLS; }
+    int walkableCount() const { return m_cellCount; }
+
+    // 只统计路径总数；被检查点中止时返回已统计的部分
+    quint64 countPaths(const QPoint& start, const QPoint& end);
+    // 依次产出最多maxPaths条路径，返回产出数量
+    int findPaths(const QPoint& start, const QPoint& end, int maxPaths, const PathCallback& onPath);
+
+    quint64 expandedNodes() const { return m_expanded; }    // 上次两侧展开的节点总数，含各批的重复展开
+    quint64 expandedSoFar() const { return m_expanded; }    // 可在检查点中读取
+    int passes() const { return m_passes; }                  // 上次连接分成的批数
+    qint64 tableBytes() const { return m_tableBytes; }      // 上次单批连接表的估计峰值
+
+private:
+    typedef quint64 Mask;
+
+    // 每扩展多少个节点调用一次检查点
+    static const int CHECKPOINT_INTERVAL = 1024;
+
+    // 半段搜索的状态：from为出发的端点，target为整条路径另一端的端点
+    struct Half {
+        int from;
+        int target;
+        int length;             // 半段的格子数（含出发端点和中点）
+        Mask visited;
+        Mask blocked;           // 半段不能进入的格子
+        QVector<int> cells;     // 半段经过的格子编号
+    };
+    // 走完一个半段时回调，返回false停止
+    using HalfCallback = std::function<bool(const Half& half)>;
+
+    Mask bit(int cell) const { return Mask(1) << cell; }
+    QPoint toPoint(int cell) const { return QPoint(m_gridIndex[cell] % m_width, m_gridIndex[cell] / m_width); }
+    bool prepare(const QPoint& start, const QPoint& end);
+    bool parityAllows() const;
+    bool pruneAfterEnter(const Half& half, int previous, int current) const;
+    bool checkpoint();
+    bool searchHalf(Half& half, int previous, int current, const HalfCallback& onHalf);
+    bool runHalf(int from, int target, int length, const HalfCallback& onHalf);
+    int partitionOf(Mask mask, int middle) const;
+    bool planPasses(int halfBytes);
+    bool join(bool counting);
+    void flushStats();
+
+    int m_width;
+    int m_cellCount;
+    QVector<int> m_gridIndex;       // 格子编号 -> 行优先下标；格子编号即位集中的位序号
+    QVector<int> m_cellOf;          // 行优先下标 -> 格子编号，不可通行为-1
+    QVector<Mask> m_adjacent;       // 每个格子的邻居位集
+    Mask m_all;
+
+    CheckpointCallback m_checkpoint;
+    SearchStats* m_stats;
+    qint64 m_memoryLimit;
+
+    // 单次搜索状态
+    int m_source;
+    int m_target;
+    int m_forwardLength;            // 前半段格子数，后半段为 N - 前半段 + 1（中点两边共用）
+    int m_maxPaths;
+    PathCallback m_onPath;
+    bool m_stop;
+    int m_found;
+    quint64 m_pathCount;
+    quint64 m_expanded;
+    int m_sinceCheckpoint;
+    quint64 m_statNodes;            // 尚未写入SearchStats的节点数
+    int m_passes;
+    qint64 m_tableBytes;
+};
+
+typedef BasicHamiltonianMeetInTheMiddle<Neighborhoods::Four> HamiltonianMeetInTheMiddle;
+
+#endif // HAMILTONIANMEETINTHEMIDDLE_H
@@ -0,0 +1,1252 @@
+#include "HamiltonianPathEngine.h"
+#include <QThreadPool>
+#include <QtAlgorithms>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace {
+// W×H不超过64格的四邻域位棋盘，位序号即行优先的格子下标
+// 所有掩码都是编译期常量，移位量也是常量
+template<int W, int H>
+struct SmallBoard {
+    static constexpr quint64 all() {
+        return W * H == 64 ? ~0ULL : (1ULL << (W * H)) - 1;
+    }
+    static constexpr quint64 column(int x) {
+        quint64 mask = 0;
+        for (int y = 0; y < H; ++y) {
+            mask |= 1ULL << (y * W + x);
+        }
+        return mask;
+    }
+    static constexpr quint64 All = all();
+    static constexpr quint64 NotFirstColumn = all() & ~column(0);
+    static constexpr quint64 NotLastColumn = all() & ~column(W - 1);
+
+    // 集合中所有格子的四邻居；左右移一位后跨行的位由列掩码去掉
+    static quint64 spread(quint64 cells) {
+        return (((cells << 1) & NotFirstColumn) | ((cells >> 1) & NotLastColumn) |
+                (cells << W) | (cells >> W)) & All;
+    }
+};
+
+const int SMALL_BOARD_SIDE = 8;
+}
+
+template<class Neighborhood>
+BasicHamiltonianPathEngine<Neighborhood>::BasicHamiltonianPathEngine(const GridModel& grid)
+    : m_width(grid.width())
+    , m_height(grid.height())
+    , m_walkableCount(grid.walkableCount())
+    , m_pruning(PruneNone)
+    , m_threadCount(1)
+    , m_smallGridKernel(true)
+    , m_moveOrder(MoveOrder::Natural)
+    , m_seed(0)
+    , m_endpointMode(EndpointMode::Fixed)
+    , m_stats(nullptr)
+    , m_target(-1)
+    , m_maxPaths(0)
+    , m_counting(false)
+    , m_skipReversed(false)
+    , m_nextSource(0)
+    , m_generating(false)
+    , m_stop(false)
+    , m_found(0)
+    , m_expandedNodes(0)
+    , m_pathCount(0)
+    , m_coverage(0.0)
+    , m_bestCost(-1.0)
+    , m_bestTurns(-1)
+{
+    m_walkable.resize(grid.cellCount());
+    for (int i = 0; i < grid.cellCount(); ++i) {
+        m_walkable[i] = grid.isWalkable(i);
+    }
+}
+
+template<class Neighborhood>
+void BasicHamiltonianPathEngine<Neighborhood>::SearchState::clearStats() {
+    statNodes = 0;
+    statBacktracks = 0;
+    statPaths = 0;
+    statMaxDepth = 0;
+    for (int i = 0; i < SearchStats::PruneReasonCount; ++i) statPrunes[i] = 0;
+    for (int i = 0; i < SearchStats::DEPTH_BUCKETS; ++i) statDepth[i] = 0;
+}
+
+template<class Neighborhood>
+void BasicHamiltonianPathEngine<Neighborhood>::resetState(SearchState& state) const {
+    const int cellCount = m_width * m_height;
+    state.visited.fill(false, cellCount);
+    state.path.clear();
+    state.path.reserve(m_walkableCount);
+    state.floodStamp.fill(0, cellCount);
+    state.floodQueue.reserve(m_walkableCount);
+    state.floodGeneration = 0;
+    state.remaining = m_walkableCount;
+    state.cost = 0.0;
+    state.bound = 0.0;
+    state.turns = 0;
+    state.forcedTurns = 0;
+    state.random = (m_seed * 2654435761u) | 1;     // xorshift的状态不能为0
+    state.share = 1.0;
+    state.covered = 0.0;
+    state.expanded = 0;
+    state.counted = 0;
+    state.sinceCheckpoint = 0;
+    state.clearStats();
+}
+
+template<class Neighborhood>
+void BasicHamiltonianPathEngine<Neighborhood>::enter(SearchState& state, int cell) const {
+    state.visited[cell] = true;
+    state.path.append(cell);
+    --state.remaining;
+}
+
+template<class Neighborhood>
+void BasicHamiltonianPathEngine<Neighborhood>::leave(SearchState& state, int cell) const {
+    state.path.removeLast();
+    state.visited[cell] = false;
+    ++state.remaining;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianPathEngine<Neighborhood>::parityAllows(int source, int target) const {
+    // 网格按 (x+y) 奇偶黑白染色，路径上颜色交替出现
+    int counts[2] = {0, 0};
+    for (int cell = 0; cell < m_walkable.size(); ++cell) {
+        if (m_walkable[cell]) {
+            counts[(cell % m_width + cell / m_width) & 1]++;
+        }
+    }
+    const int sourceColor = (source % m_width + source / m_width) & 1;
+    const int targetColor = (target % m_width + target / m_width) & 1;
+    if ((m_walkableCount & 1) == 0) {
+        // 偶数个格子：两色各半，起终点异色
+        return counts[0] == counts[1] && sourceColor != targetColor;
+    }
+    // 奇数个格子：多数色恰好多一个，起终点都是多数色
+    const int majority = counts[0] > counts[1] ? 0 : 1;
+    return counts[majority] == counts[1 - majority] + 1 &&
+           sourceColor == majority && targetColor == majority;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianPathEngine<Neighborhood>::parityAllowsStart(int source) const {
+    int counts[2] = {0, 0};
+    for (int cell = 0; cell < m_walkable.size(); ++cell) {
+        if (m_walkable[cell]) {
+            counts[(cell % m_width + cell / m_width) & 1]++;
+        }
+    }
+    const int sourceColor = (source % m_width + source / m_width) & 1;
+    if ((m_walkableCount & 1) == 0) {
+        return counts[0] == counts[1];
+    }
+    // 奇数个格子：首尾都是多数色
+    const int majority = counts[0] > counts[1] ? 0 : 1;
+    return counts[majority] == counts[1 - majority] + 1 && sourceColor == majority;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianPathEngine<Neighborhood>::deadEndAfterMove(const SearchState& state, int previous, int current) const {
+    // 上一个格子不再是路径端点，它的未访问邻居各少了一个可用邻居
+    // 未访问格子需要一进一出，至少两个可用邻居（未访问格子或当前端点）；终点只需要一个
+    // 终点自由时只剩一个可用邻居的格子只能是终点，这样的格子最多一个
+    int around[Neighborhood::MaxDegree];
+    int adjacent[Neighborhood::MaxDegree];
+    int endpoints = 0;
+    const int count = neighbors(previous, around);
+    for (int i = 0; i < count; ++i) {
+        const int cell = around[i];
+        if (state.visited[cell]) {
+            continue;
+        }
+        int available = 0;
+        const int degree = neighbors(cell, adjacent);
+        for (int j = 0; j < degree; ++j) {
+            if (!state.visited[adjacent[j]] || adjacent[j] == current) {
+                ++available;
+            }
+        }
+        if (m_target < 0) {
+            if (available == 0 || (available == 1 && ++endpoints > 1)) {
+                return true;
+            }
+        } else if (available < (cell == m_target ? 1 : 2)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianPathEngine<Neighborhood>::disconnected(SearchState& state) const {
+    // 从终点出发在未访问格子中泛洪，必须能覆盖全部未访问格子
+    // 终点自由时改从当前端点出发，当前端点本身已访问，不计入
+    const int seed = m_target >= 0 ? m_target : state.path.last();
+    ++state.floodGeneration;
+    state.floodQueue.clear();
+    state.floodQueue.append(seed);
+    state.floodStamp[seed] = state.floodGeneration;
+
+    int adjacent[Neighborhood::MaxDegree];
+    for (int head = 0; head < state.floodQueue.size(); ++head) {
+        const int count = neighbors(state.floodQueue[head], adjacent);
+        for (int i = 0; i < count; ++i) {
+            const int next = adjacent[i];
+            if (!state.visited[next] && state.floodStamp[next] != state.floodGeneration) {
+                state.floodStamp[next] = state.floodGeneration;
+                state.floodQueue.append(next);
+            }
+        }
+    }
+    return state.floodQueue.size() - (m_target >= 0 ? 0 : 1) < state.remaining;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianPathEngine<Neighborhood>::reportPath(SearchState& state) {
+    // 起终点都自由时一条路径和它的反向各会走到一次，只保留一个方向
+    if (m_skipReversed && state.path.last() < state.path.first()) {
+        return true;
+    }
+    if (m_counting) {
+        ++state.counted;
+        ++state.statPaths;
+        if (!m_endCounts.empty()) {
+            m_endCounts[state.path.last()].fetch_add(1, std::memory_order_relaxed);
+        }
+        // 计数时可顺带产出前maxPaths条路径，产出完后只计数
+        if (!m_onPath || m_found.load(std::memory_order_relaxed) >= m_maxPaths) {
+            return true;
+        }
+    }
+
+    state.points.resize(state.path.size());
+    for (int i = 0; i < state.path.size(); ++i) {
+        state.points[i] = toPoint(state.path[i]);
+    }
+
+    // 并行时回调串行化，并保证不超过上限
+    QMutexLocker locker(m_threadCount > 1 ? &m_callbackMutex : nullptr);
+    if (m_stop.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    if (m_found.load() >= m_maxPaths) {
+        return m_counting;
+    }
+    const int found = ++m_found;
+    if (!m_counting) {
+        ++state.statPaths;
+    }
+    const bool keepGoing = m_onPath(state.points) && (m_counting || found < m_maxPaths);
+    if (!keepGoing) {
+        m_stop = true;
+    }
+    return keepGoing;
+}
+
+template<class Neighborhood>
+void BasicHamiltonianPathEngine<Neighborhood>::flushStats(SearchState& state) {
+    m_stats->addNodes(state.statNodes);
+    m_stats->addBacktracks(state.statBacktracks);
+    m_stats->addPaths(state.statPaths);
+    for (int i = 0; i < SearchStats::PruneReasonCount; ++i) {
+        if (state.statPrunes[i] > 0) {
+            m_stats->addPrunes(static_cast<SearchStats::PruneReason>(i), state.statPrunes[i]);
+        }
+    }
+    for (int i = 0; i < SearchStats::DEPTH_BUCKETS; ++i) {
+        if (state.statDepth[i] > 0) {
+            m_stats->addDepthSamples(i, state.statDepth[i]);
+        }
+    }
+    m_stats->updateMaxDepth(state.statMaxDepth);
+    state.clearStats();
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianPathEngine<Neighborhood>::reportImproved(SearchState& state) {
+    m_bestCost = state.cost;
+    ++state.statPaths;
+    state.points.resize(state.path.size());
+    for (int i = 0; i < state.path.size(); ++i) {
+        state.points[i] = toPoint(state.path[i]);
+    }
+    if (!m_onImproved(state.points, state.cost)) {
+        m_stop = true;
+        return false;
+    }
+    return true;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianPathEngine<Neighborhood>::checkpoint(SearchState& state) {
+    ++state.expanded;
+    if (++state.sinceCheckpoint >= CHECKPOINT_INTERVAL) {
+        state.sinceCheckpoint = 0;
+        if (m_stats) {
+            flushStats(state);
+        }
+        if (state.mainThread && m_checkpoint && !m_checkpoint()) {
+            m_stop = true;
+        }
+    }
+    return !m_stop.load(std::memory_order_relaxed);
+}
+
+template<class Neighborhood>
+void BasicHamiltonianPathEngine<Neighborhood>::recordNode(SearchState& state) {
+    if (m_stats) {
+        const int depth = state.path.size();
+        ++state.statNodes;
+        ++state.statDepth[m_stats->depthBucket(depth)];
+        state.statMaxDepth = qMax(state.statMaxDepth, depth);
+    }
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianPathEngine<Neighborhood>::pruneAfterEnter(SearchState& state, int current) {
+    if ((m_pruning & PruneDeadEnd) && state.path.size() >= 2 &&
+        deadEndAfterMove(state, state.path[state.path.size() - 2], current)) {
+        ++state.statPrunes[SearchStats::PruneDeadEnd];
+        return true;
+    }
+    if ((m_pruning & PruneConnectivity) && disconnected(state)) {
+        ++state.statPrunes[SearchStats::PruneConnectivity];
+        return true;
+    }
+    return false;
+}
+
+template<class Neighborhood>
+void BasicHamiltonianPathEngine<Neighborhood>::orderMoves(SearchState& state, int* moves, int count) const {
+    if (m_moveOrder == MoveOrder::Random) {
+        for (int i = count - 1; i > 0; --i) {
+            state.random ^= state.random << 13;
+            state.random ^= state.random >> 17;
+            state.random ^= state.random << 5;
+            std::swap(moves[i], moves[state.random % (i + 1)]);
+        }
+        return;
+    }
+
+    // 按排序键从小到大，相同时保持邻域的原顺序
+    int keys[Neighborhood::MaxDegree];
+    if (m_moveOrder == MoveOrder::Warnsdorff) {
+        // 后续可走格子数随搜索变化，每次现算
+        int adjacent[Neighborhood::MaxDegree];
+        for (int i = 0; i < count; ++i) {
+            keys[i] = 0;
+            const int degree = neighbors(moves[i], adjacent);
+            for (int j = 0; j < degree; ++j) {
+                if (!state.visited[adjacent[j]]) ++keys[i];
+            }
+        }
+    } else {
+        for (int i = 0; i < count; ++i) {
+            keys[i] = m_orderKey[moves[i]];
+        }
+    }
+    for (int i = 1; i < count; ++i) {
+        const int move = moves[i];
+        const int key = keys[i];
+        int j = i - 1;
+        for (; j >= 0 && keys[j] > key; --j) {
+            moves[j + 1] = moves[j];
+            keys[j + 1] = keys[j];
+        }
+        moves[j + 1] = move;
+        keys[j + 1] = key;
+    }
+}
+
+template<class Neighborhood>
+void BasicHamiltonianPathEngine<Neighborhood>::buildOrderKeys() {
+    const int cellCount = m_width * m_height;
+    m_orderKey.fill(0, cellCount);
+    int adjacent[Neighborhood::MaxDegree];
+    if (m_moveOrder == MoveOrder::WallHugging) {
+        // 固定不可走的方向（出界或障碍）越多越靠前
+        for (int cell = 0; cell < cellCount; ++cell) {
+            if (m_walkable[cell]) {
+                m_orderKey[cell] = neighbors(cell, adjacent) - Neighborhood::MaxDegree;
+            }
+        }
+        return;
+    }
+
+    // 离终点的步数越多越靠前；与终点不连通的格子排在最后；终点自由时没有依据，保持邻域顺序
+    if (m_target < 0) {
+        return;
+    }
+    QVector<int> queue;
+    queue.reserve(m_walkableCount);
+    QVector<int> distance(cellCount, -1);
+    distance[m_target] = 0;
+    queue.append(m_target);
+    for (int head = 0; head < queue.size(); ++head) {
+        const int cell = queue[head];
+        const int degree = neighbors(cell, adjacent);
+        for (int i = 0; i < degree; ++i) {
+            if (distance[adjacent[i]] < 0) {
+                distance[adjacent[i]] = distance[cell] + 1;
+                queue.append(adjacent[i]);
+            }
+        }
+    }
+    for (int cell = 0; cell < cellCount; ++cell) {
+        m_orderKey[cell] = distance[cell] >= 0 ? -distance[cell] : 1;
+    }
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianPathEngine<Neighborhood>::search(SearchState& state, int current) {
+    if (!checkpoint(state)) {
+        return false;
+    }
+
+    const double share = state.share;
+    enter(state, current);
+    recordNode(state);
+
+    bool keepGoing = true;
+    bool extended = false;
+    if (current == m_target || state.remaining == 0) {
+        // 访问了所有可通行点且停在终点（终点自由时停在任意格子）才是哈密顿路径
+        if (state.remaining == 0) {
+            keepGoing = reportPath(state);
+        } else {
+            ++state.statBacktracks;     // 尚有未访问格子却已到终点
+        }
+    } else if (state.remaining > 0) {
+        if (!pruneAfterEnter(state, current)) {
+            int adjacent[Neighborhood::MaxDegree];
+            const int count = neighbors(current, adjacent);
+            if (m_moveOrder != MoveOrder::Natural) {
+                orderMoves(state, adjacent, count);
+            }
+            int open = 0;
+            for (int i = 0; i < count; ++i) {
+                if (!state.visited[adjacent[i]]) ++open;
+            }
+            for (int i = 0; i < count && keepGoing; ++i) {
+                if (!state.visited[adjacent[i]]) {
+                    extended = true;
+                    state.share = share / open;
+                    keepGoing = search(state, adjacent[i]);
+                }
+            }
+            // 剪枝没能提前发现的死路
+            if (!extended) ++state.statBacktracks;
+        }
+    }
+    // 叶子的份额计入覆盖比例，有子节点时份额已分给子节点
+    if (!extended) state.covered += share;
+
+    // 回溯
+    leave(state, current);
+    return keepGoing;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianPathEngine<Neighborhood>::searchMinCost(SearchState& state, int current) {
+    if (!checkpoint(state)) {
+        return false;
+    }
+
+    const double share = state.share;
+    bool extended = false;
+    enter(state, current);
+    recordNode(state);
+
+    bool keepGoing = true;
+    if (current == m_target) {
+        if (state.remaining == 0) {
+            // 进入子节点前已用下界排除了不更优的分支，到这里一定是改进
+            keepGoing = reportImproved(state);
+        } else {
+            ++state.statBacktracks;
+        }
+    } else if (state.remaining > 0 && !pruneAfterEnter(state, current)) {
+        // 子节点的下界：已走代价 + 这一步 + 其余未访问格子的最小进入代价，
+        // 即 cost + bound + (这一步 - 进入next的最小代价)。子节点按括号里的增量从小到大展开，
+        // 下界低的分支先走，尽早得到较好的解以收紧上界
+        int adjacent[Neighborhood::MaxDegree];
+        double costs[Neighborhood::MaxDegree];
+        double raises[Neighborhood::MaxDegree];
+        int count = 0;
+        int around[Neighborhood::MaxDegree];
+        const int degree = neighbors(current, around);
+        for (int i = 0; i < degree; ++i) {
+            if (state.visited[around[i]]) {
+                continue;
+            }
+            const double stepCost = moveCost(current, around[i]);
+            const double raise = stepCost - m_minEnter[around[i]];
+            int j = count++;
+            while (j > 0 && raises[j - 1] > raise) {
+                adjacent[j] = adjacent[j - 1];
+                costs[j] = costs[j - 1];
+                raises[j] = raises[j - 1];
+                --j;
+            }
+            adjacent[j] = around[i];
+            costs[j] = stepCost;
+            raises[j] = raise;
+        }
+        if (count == 0) ++state.statBacktracks;
+        extended = count > 0;
+
+        for (int i = 0; i < count && keepGoing; ++i) {
+            const int next = adjacent[i];
+            const double lowerBound = state.cost + state.bound + raises[i];
+            if (m_bestCost >= 0.0 && lowerBound >= m_bestCost - 1e-9) {
+                // 后面的子节点增量更大，下界只会更高
+                state.statPrunes[SearchStats::PruneBound] += count - i;
+                state.covered += share * (count - i) / count;
+                break;
+            }
+            state.cost += costs[i];
+            state.bound -= m_minEnter[next];
+            state.share = share / count;
+            keepGoing = searchMinCost(state, next);
+            state.bound += m_minEnter[next];
+            state.cost -= costs[i];
+        }
+    }
+    if (!extended) state.covered += share;
+
+    leave(state, current);
+    return keepGoing;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianPathEngine<Neighborhood>::forcedTurn(const SearchState& state, int cell, int endpoint) const {
+    // 终点之外的未访问格子在剩余路径中一进一出，进出两侧都只能是未访问格子或当前端点
+    if (!m_walkable[cell] || state.visited[cell] || cell == m_target) {
+        return false;
+    }
+    // 可用邻居的方向掩码；相反方向编号为 d 和 d^1，有一对都可用才可能直行穿过
+    int adjacent[Neighborhood::MaxDegree];
+    const int count = neighbors(cell, adjacent);
+    unsigned mask = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!state.visited[adjacent[i]] || adjacent[i] == endpoint) {
+            mask |= 1u << Neighborhood::direction(m_width, cell, adjacent[i]);
+        }
+    }
+    return (mask & (mask >> 1) & 0x55555555u) == 0;
+}
+
+template<class Neighborhood>
+int BasicHamiltonianPathEngine<Neighborhood>::forcedTurnsAround(const SearchState& state, int center, int endpoint) const {
+    int adjacent[Neighborhood::MaxDegree];
+    const int count = neighbors(center, adjacent);
+    int forced = 0;
+    for (int i = 0; i < count; ++i) {
+        if (forcedTurn(state, adjacent[i], endpoint)) {
+            ++forced;
+        }
+    }
+    return forced;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianPathEngine<Neighborhood>::searchMinTurns(SearchState& state, int current) {
+    if (!checkpoint(state)) {
+        return false;
+    }
+
+    const double share = state.share;
+    bool extended = false;
+    const int savedTurns = state.turns;
+    const int savedForced = state.forcedTurns;
+    const int previous = state.path.isEmpty() ? -1 : state.path.last();
+    if (previous >= 0) {
+        if (state.path.size() >= 2 &&
+            Neighborhood::direction(m_width, state.path[state.path.size() - 2], previous) !=
+            Neighborhood::direction(m_width, previous, current)) {
+            ++state.turns;
+        }
+        // 端点从previous移到current，只有previous的邻居（含current）的可用邻居发生变化
+        state.forcedTurns -= forcedTurnsAround(state, previous, previous);
+    }
+    enter(state, current);
+    if (previous >= 0) {
+        state.forcedTurns += forcedTurnsAround(state, previous, current);
+    } else {
+        state.forcedTurns = 0;
+        for (int cell = 0; cell < m_walkable.size(); ++cell) {
+            if (forcedTurn(state, cell, current)) {
+                ++state.forcedTurns;
+            }
+        }
+    }
+    recordNode(state);
+
+    bool keepGoing = true;
+    if (current == m_target) {
+        if (state.remaining == 0) {
+            if (m_bestTurns < 0 || state.turns < m_bestTurns) {
+                m_bestTurns = state.turns;
+                ++state.statPaths;
+                state.points.resize(state.path.size());
+                for (int i = 0; i < state.path.size(); ++i) {
+                    state.points[i] = toPoint(state.path[i]);
+                }
+                if (!m_onTurnsImproved(state.points, state.turns)) {
+                    m_stop = true;
+                    keepGoing = false;
+                }
+            }
+        } else {
+            ++state.statBacktracks;
+        }
+    } else if (state.remaining > 0) {
+        // 正前方的格子；起点还没有方向
+        int around[Neighborhood::MaxDegree];
+        const int degree = neighbors(current, around);
+        int ahead = -1;
+        if (previous >= 0) {
+            const int heading = Neighborhood::direction(m_width, previous, current);
+            for (int i = 0; i < degree; ++i) {
+                if (!state.visited[around[i]] &&
+                    Neighborhood::direction(m_width, current, around[i]) == heading) {
+                    ahead = around[i];
+                }
+            }
+        }
+        const int lowerBound = state.turns + state.forcedTurns + (previous >= 0 && ahead < 0 ? 1 : 0);
+        if (m_bestTurns >= 0 && lowerBound >= m_bestTurns) {
+            ++state.statPrunes[SearchStats::PruneBound];
+        } else if (!pruneAfterEnter(state, current)) {
+            // 优先直行
+            int adjacent[Neighborhood::MaxDegree];
+            int count = 0;
+            if (ahead >= 0) {
+                adjacent[count++] = ahead;
+            }
+            for (int i = 0; i < degree; ++i) {
+                if (!state.visited[around[i]] && around[i] != ahead) {
+                    adjacent[count++] = around[i];
+                }
+            }
+            if (count == 0) ++state.statBacktracks;
+            extended = count > 0;
+            for (int i = 0; i < count && keepGoing; ++i) {
+                state.share = share / count;
+                keepGoing = searchMinTurns(state, adjacent[i]);
+            }
+        }
+    }
+    if (!extended) state.covered += share;
+
+    leave(state, current);
+    state.turns = savedTurns;
+    state.forcedTurns = savedForced;
+    return keepGoing;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianPathEngine<Neighborhood>::prepare(const QPoint& start, const QPoint& end, EndpointMode mode) {
+    m_expandedNodes = 0;
+    m_pathCount = 0;
+    m_coverage = 0.0;
+    m_found = 0;
+    m_stop = false;
+    m_sources.clear();
+    m_frames.clear();
+    m_generating = false;
+    m_skipReversed = mode == EndpointMode::FreeBoth;
+    const auto walkable = [this](const QPoint& p) { return inGrid(p) && m_walkable[index(p)]; };
+    if ((mode != EndpointMode::FreeBoth && !walkable(start)) || (mode == EndpointMode::Fixed && !walkable(end))) {
+        return false;
+    }
+    m_target = mode == EndpointMode::Fixed ? index(end) : -1;
+    const bool parity = Neighborhood::Bipartite && (m_pruning & PruneParity);
+    if (mode == EndpointMode::FreeBoth) {
+        for (int cell = 0; cell < m_walkable.size(); ++cell) {
+            if (m_walkable[cell] && (!parity || parityAllowsStart(cell))) {
+                m_sources.append(cell);
+            }
+        }
+    } else if (!parity || (m_target >= 0 ? parityAllows(index(start), m_target) : parityAllowsStart(index(start)))) {
+        m_sources.append(index(start));
+    }
+    if (m_sources.isEmpty()) {
+        if (m_stats) {
+            m_stats->addPrunes(SearchStats::PruneParity, 1);
+        }
+        m_coverage = m_walkableCount > 0 ? 1.0 : 0.0;   // 不用搜索即可判定无解
+        return false;
+    }
+    if (m_moveOrder == MoveOrder::WallHugging || m_moveOrder == MoveOrder::DistanceToEnd) {
+        buildOrderKeys();
+    }
+    return true;
+}
+
+template<class Neighborhood>
+template<int W, int H>
+bool BasicHamiltonianPathEngine<Neighborhood>::pruneSmall(SearchState& state, quint64 unvisited, int current) {
+    typedef SmallBoard<W, H> Board;
+    const quint64 currentBit = 1ULL << current;
+    if ((m_pruning & PruneDeadEnd) && state.path.size() >= 2) {
+        // 与deadEndAfterMove()相同：上一格的未访问邻居至少要有两个可用邻居，终点一个
+        const quint64 available = unvisited | currentBit;
+        const quint64 targetBit = 1ULL << m_target;
+        for (quint64 around = Board::spread(1ULL << state.path[state.path.size() - 2]) & unvisited;
+             around; around &= around - 1) {
+            const quint64 cell = around & (~around + 1);
+            if (qPopulationCount(Board::spread(cell) & available) < (cell == targetBit ? 1 : 2)) {
+                ++state.statPrunes[SearchStats::PruneDeadEnd];
+                return true;
+            }
+        }
+    }
+    if (m_pruning & PruneConnectivity) {
+        // 从终点按位泛洪，每轮扩展一整圈
+        quint64 reached = 1ULL << m_target;
+        for (;;) {
+            const quint64 next = (reached | Board::spread(reached)) & unvisited;
+            if (next == reached) {
+                break;
+            }
+            reached = next;
+        }
+        if (reached != unvisited) {
+            ++state.statPrunes[SearchStats::PruneConnectivity];
+            return true;
+        }
+    }
+    return false;
+}
+
+template<class Neighborhood>
+template<int W, int H>
+bool BasicHamiltonianPathEngine<Neighborhood>::searchSmall(SearchState& state, quint64 unvisited, int current) {
+    typedef SmallBoard<W, H> Board;
+    if (!checkpoint(state)) {
+        return false;
+    }
+
+    const double share = state.share;
+    const quint64 currentBit = 1ULL << current;
+    unvisited &= ~currentBit;
+    state.path.append(current);
+    recordNode(state);
+
+    bool keepGoing = true;
+    bool extended = false;
+    if (current == m_target) {
+        if (unvisited == 0) {
+            keepGoing = reportPath(state);
+        } else {
+            ++state.statBacktracks;
+        }
+    } else if (unvisited != 0 && !pruneSmall<W, H>(state, unvisited, current)) {
+        // 与neighbors()相同的上、下、左、右顺序，产出顺序和通用内核一致
+        const quint64 up = (currentBit >> W) & unvisited;
+        const quint64 down = (currentBit << W) & unvisited & Board::All;
+        const quint64 left = (currentBit >> 1) & Board::NotLastColumn & unvisited;
+        const quint64 right = (currentBit << 1) & Board::NotFirstColumn & unvisited;
+        const int open = (up != 0) + (down != 0) + (left != 0) + (right != 0);
+        const double childShare = open > 0 ? share / open : 0.0;
+        extended = open > 0;
+        if (up) {
+            state.share = childShare;
+            keepGoing = searchSmall<W, H>(state, unvisited, current - W);
+        }
+        if (down && keepGoing) {
+            state.share = childShare;
+            keepGoing = searchSmall<W, H>(state, unvisited, current + W);
+        }
+        if (left && keepGoing) {
+            state.share = childShare;
+            keepGoing = searchSmall<W, H>(state, unvisited, current - 1);
+        }
+        if (right && keepGoing) {
+            state.share = childShare;
+            keepGoing = searchSmall<W, H>(state, unvisited, current + 1);
+        }
+        if (!extended) ++state.statBacktracks;
+    }
+    if (!extended) state.covered += share;
+
+    state.path.removeLast();
+    return keepGoing;
+}
+
+template<class Neighborhood>
+template<std::size_t... I>
+const typename BasicHamiltonianPathEngine<Neighborhood>::SmallKernel*
+BasicHamiltonianPathEngine<Neighborhood>::smallKernels(std::index_sequence<I...>) {
+    // 8×8种宽高组合各一个内核，按 (高-1)*8 + (宽-1) 排列
+    static const SmallKernel kernels[] = {
+        &BasicHamiltonianPathEngine::template searchSmall<I % SMALL_BOARD_SIDE + 1, I / SMALL_BOARD_SIDE + 1>...
+    };
+    return kernels;
+}
+
+template<class Neighborhood>
+template<int Unused>
+bool BasicHamiltonianPathEngine<Neighborhood>::runSmallKernel(SearchState& state, int current,
+                                                             Neighborhoods::Four) {
+    if (!m_smallGridKernel || m_moveOrder != MoveOrder::Natural || m_target < 0 ||
+        m_width > SMALL_BOARD_SIDE || m_height > SMALL_BOARD_SIDE) {
+        return false;
+    }
+    static const SmallKernel* kernels =
+        smallKernels(std::make_index_sequence<SMALL_BOARD_SIDE * SMALL_BOARD_SIDE>());
+
+    quint64 unvisited = 0;
+    for (int cell = 0; cell < m_walkable.size(); ++cell) {
+        if (m_walkable[cell] && !state.visited[cell]) {
+            unvisited |= 1ULL << cell;
+        }
+    }
+    (this->*kernels[(m_height - 1) * SMALL_BOARD_SIDE + (m_width - 1)])(state, unvisited, current);
+    return true;
+}
+
+template<class Neighborhood>
+void BasicHamiltonianPathEngine<Neighborhood>::searchFrom(SearchState& state, int current) {
+    if (!runSmallKernel(state, current, Neighborhood())) {
+        search(state, current);
+    }
+}
+
+template<class Neighborhood>
+void BasicHamiltonianPathEngine<Neighborhood>::run() {
+    if (m_threadCount > 1) {
+        runParallel();
+        return;
+    }
+    // 起点自由时各起点是同一棵搜索树根下的子树，依次搜索，份额均分
+    const double share = 1.0 / m_sources.size();
+    for (int source : m_sources) {
+        if (m_stop.load(std::memory_order_relaxed)) {
+            break;
+        }
+        runSingle(source, share);
+    }
+}
+
+template<class Neighborhood>
+void BasicHamiltonianPathEngine<Neighborhood>::runSingle(int source, double share) {
+    resetState(m_mainState);
+    m_mainState.mainThread = true;
+    m_mainState.share = share;
+    searchFrom(m_mainState, source);
+    if (m_stats) {
+        flushStats(m_mainState);
+    }
+    m_expandedNodes += m_mainState.expanded;
+    m_mainState.expanded = 0;
+    m_pathCount += m_mainState.counted;
+    m_coverage += m_mainState.covered;
+}
+
+template<class Neighborhood>
+void BasicHamiltonianPathEngine<Neighborhood>::runParallel() {
+    // 先在本线程中展开搜索树的前几层，直到前缀数足够分给各线程
+    // 前缀就是一条未完成的路径，各子任务从前缀末端继续搜索，互不重叠
+    // 每个前缀带着它在搜索树中的份额，子任务的覆盖比例按此累加
+    // 起点自由时每个起点都是一个初始前缀
+    QVector<QVector<int>> prefixes;
+    QVector<double> shares;
+    for (int source : m_sources) {
+        prefixes.append(QVector<int>() << source);
+        shares.append(1.0 / m_sources.size());
+    }
+    // 已到终点或已走完全部格子的前缀不会再延伸，在下面的子任务中处理
+    const auto finished = [this](const QVector<int>& prefix) {
+        return prefix.last() == m_target || prefix.size() == m_walkableCount;
+    };
+    const int wanted = m_threadCount * 8;
+
+    SearchState state;
+    resetState(state);
+    while (prefixes.size() < wanted && !m_stop.load()) {
+        QVector<QVector<int>> expanded;
+        QVector<double> expandedShares;
+        double dropped = 0.0;       // 无路可走的前缀，展开后不再产生子任务
+        bool grew = false;
+        for (int p = 0; p < prefixes.size(); ++p) {
+            const QVector<int>& prefix = prefixes[p];
+            const int last = prefix.last();
+            if (finished(prefix)) {
+                continue;
+            }
+            for (int i = 0; i < prefix.size(); ++i) {
+                enter(state, prefix[i]);
+            }
+            int adjacent[Neighborhood::MaxDegree];
+            const int count = neighbors(last, adjacent);
+            int open = 0;
+            for (int i = 0; i < count; ++i) {
+                if (!state.visited[adjacent[i]]) ++open;
+            }
+            for (int i = 0; i < count; ++i) {
+                if (!state.visited[adjacent[i]]) {
+                    expanded.append(prefix);
+                    expanded.last().append(adjacent[i]);
+                    expandedShares.append(shares[p] / open);
+                    grew = true;
+                }
+            }
+            if (open == 0) {
+                dropped += shares[p];
+            }
+            for (int i = prefix.size() - 1; i >= 0; --i) {
+                leave(state, prefix[i]);
+            }
+        }
+        if (!grew) {
+            break;
+        }
+        m_coverage += dropped;
+        for (int p = 0; p < prefixes.size(); ++p) {
+            if (finished(prefixes[p])) {
+                expanded.append(prefixes[p]);
+                expandedShares.append(shares[p]);
+            }
+        }
+        prefixes = expanded;
+        shares = expandedShares;
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(m_threadCount);
+    for (int p = 0; p < prefixes.size(); ++p) {
+        const QVector<int> prefix = prefixes[p];
+        const double share = shares[p];
+        pool.start([this, prefix, share]() {
+            SearchState local;
+            resetState(local);
+            local.mainThread = false;
+            local.share = share;
+            // 前缀除末端外直接标记为已访问，末端交给search()以执行相同的剪枝检查
+            for (int i = 0; i < prefix.size() - 1; ++i) {
+                enter(local, prefix[i]);
+            }
+            searchFrom(local, prefix.last());
+            if (m_stats) {
+                flushStats(local);
+            }
+
+            QMutexLocker locker(&m_callbackMutex);
+            m_expandedNodes += local.expanded;
+            m_pathCount += local.counted;
+            m_coverage += local.covered;
+        });
+    }
+
+    // 检查点只在本线程调用，停止时通知所有子任务
+    while (!pool.waitForDone(50)) {
+        if (m_checkpoint && !m_checkpoint()) {
+            m_stop = true;
+        }
+    }
+}
+
+template<class Neighborhood>
+int BasicHamiltonianPathEngine<Neighborhood>::findPaths(const QPoint& start, const QPoint& end, int maxPaths,
+                                     const PathCallback& onPath) {
+    if (maxPaths <= 0 || !prepare(start, end, m_endpointMode)) {
+        return 0;
+    }
+
+    m_counting = false;
+    m_maxPaths = maxPaths;
+    m_onPath = onPath;
+    run();
+    m_onPath = PathCallback();
+    return m_found.load();
+}
+
+template<class Neighborhood>
+QVector<QVector<QPoint>> BasicHamiltonianPathEngine<Neighborhood>::findPaths(const QPoint& start, const QPoint& end, int maxPaths) {
+    QVector<QVector<QPoint>> paths;
+    findPaths(start, end, maxPaths, [&paths](const QVector<QPoint>& path) {
+        paths.append(path);
+        return true;
+    });
+    return paths;
+}
+
+template<class Neighborhood>
+quint64 BasicHamiltonianPathEngine<Neighborhood>::countPaths(const QPoint& start, const QPoint& end) {
+    if (!prepare(start, end, m_endpointMode)) {
+        return 0;
+    }
+
+    m_counting = true;
+    m_maxPaths = std::numeric_limits<int>::max();
+    run();
+    return m_pathCount;
+}
+
+template<class Neighborhood>
+quint64 BasicHamiltonianPathEngine<Neighborhood>::countPathsByEnd(const QPoint& start, QVector<quint64>& endCounts,
+                                                                  int maxPaths, const PathCallback& onPath) {
+    endCounts.fill(0, m_width * m_height);
+    if (!prepare(start, QPoint(), EndpointMode::FreeEnd)) {
+        return 0;
+    }
+
+    // 各线程在到达终点时原子累加，检查点中随时可读
+    std::vector<std::atomic<quint64>> counts(m_width * m_height);
+    for (std::atomic<quint64>& count : counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    m_endCounts.swap(counts);
+    m_counting = true;
+    m_maxPaths = qMax(0, maxPaths);
+    m_onPath = maxPaths > 0 ? onPath : PathCallback();
+    run();
+    m_onPath = PathCallback();
+    endCounts = endCountsSoFar();
+    std::vector<std::atomic<quint64>>().swap(m_endCounts);
+    return m_pathCount;
+}
+
+template<class Neighborhood>
+QVector<quint64> BasicHamiltonianPathEngine<Neighborhood>::endCountsSoFar() const {
+    QVector<quint64> counts(static_cast<int>(m_endCounts.size()), 0);
+    for (int i = 0; i < counts.size(); ++i) {
+        counts[i] = m_endCounts[i].load(std::memory_order_relaxed);
+    }
+    return counts;
+}
+
+template<class Neighborhood>
+typename BasicHamiltonianPathEngine<Neighborhood>::Visit
+BasicHamiltonianPathEngine<Neighborhood>::visitFrame(SearchState& state, int current, double share) {
+    // 与search()进入一个节点时的处理相同，只是子节点不递归，而是压入显式栈
+    if (!checkpoint(state)) {
+        --state.expanded;       // 格子未进入，续取时会再经过检查点计数一次
+        return Visit::Stopped;
+    }
+    enter(state, current);
+    recordNode(state);
+
+    if (state.remaining == 0) {
+        return Visit::Path;
+    }
+    if (current == m_target) {
+        ++state.statBacktracks;     // 尚有未访问格子却已到终点
+    } else if (!pruneAfterEnter(state, current)) {
+        Frame frame;
+        frame.cell = current;
+        frame.count = neighbors(current, frame.moves);
+        if (m_moveOrder != MoveOrder::Natural) {
+            orderMoves(state, frame.moves, frame.count);
+        }
+        frame.open = 0;
+        for (int i = 0; i < frame.count; ++i) {
+            if (!state.visited[frame.moves[i]]) ++frame.open;
+        }
+        frame.next = 0;
+        frame.share = share;
+        frame.extended = false;
+        m_frames.append(frame);
+        return Visit::Expanded;
+    }
+    state.covered += share;
+    leave(state, current);
+    return Visit::Leaf;
+}
+
+template<class Neighborhood>
+bool BasicHamiltonianPathEngine<Neighborhood>::beginPaths(const QPoint& start, const QPoint& end) {
+    if (!prepare(start, end, m_endpointMode)) {
+        return false;
+    }
+    resetState(m_mainState);
+    m_mainState.mainThread = true;
+    m_frames.reserve(m_walkableCount);
+    m_nextSource = 0;
+    m_generating = true;
+    return true;
+}
+
+template<class Neighborhood>
+int BasicHamiltonianPathEngine<Neighborhood>::nextPaths(int count, const PathCallback& onPath) {
+    if (count <= 0 || pathsExhausted()) {
+        return 0;
+    }
+    m_stop = false;
+    SearchState& state = m_mainState;
+    int produced = 0;
+    bool keepGoing = true;
+    while (keepGoing && produced < count) {
+        // 取下一个要进入的格子：栈顶的下一个未访问子节点，栈空时为下一个起点
+        const int parent = m_frames.size() - 1;
+        int current;
+        double share;
+        if (parent < 0) {
+            if (m_nextSource >= m_sources.size()) {
+                break;
+            }
+            // 与runSingle()相同，每个起点的随机展开顺序从种子重新开始
+            state.random = (m_seed * 2654435761u) | 1;
+            current = m_sources[m_nextSource];
+            share = 1.0 / m_sources.size();
+        } else {
+            Frame& top = m_frames[parent];
+            while (top.next < top.count && state.visited[top.moves[top.next]]) {
+                ++top.next;
+            }
+            if (top.next >= top.count) {
+                // 子节点都已走完，回溯；没有子节点的份额计入覆盖比例
+                if (!top.extended) {
+                    ++state.statBacktracks;     // 剪枝没能提前发现的死路
+                    state.covered += top.share;
+                }
+                leave(state, top.cell);
+                m_frames.removeLast();
+                continue;
+            }
+            current = top.moves[top.next];
+            share = top.share / top.open;
+        }
+
+        const Visit visit = visitFrame(state, current, share);
+        if (visit == Visit::Stopped) {
+            break;      // 栈未改变，下次从同一个子节点继续
+        }
+        if (parent < 0) {
+            ++m_nextSource;
+        } else {
+            ++m_frames[parent].next;
+            m_frames[parent].extended = true;
+        }
+        if (visit == Visit::Path) {
+            // 起终点都自由时一条路径和它的反向各会走到一次，只保留一个方向
+            if (!m_skipReversed || state.path.last() >= state.path.first()) {
+                state.points.resize(state.path.size());
+                for (int i = 0; i < state.path.size(); ++i) {
+                    state.points[i] = toPoint(state.path[i]);
+                }
+                ++produced;
+                ++state.statPaths;
+                keepGoing = onPath(state.points);
+            }
+            state.covered += share;
+            leave(state, current);
+        }
+    }
+
+    if (m_stats) {
+        flushStats(state);
+    }
+    m_expandedNodes += state.expanded;
+    state.expanded = 0;
+    m_coverage += state.covered;
+    state.covered = 0.0;
+    return produced;
+}
+
+template<class Neighborhood>
+typename BasicHamiltonianPathEngine<Neighborhood>::MoveCost BasicHamiltonianPathEngine<Neighborhood>::enterCellCost(const GridModel& grid) {
+    return [grid](int, int to) {
+        return grid.weight(to);
+    };
+}
+
+template<class Neighborhood>
+typename BasicHamiltonianPathEngine<Neighborhood>::MoveCost BasicHamiltonianPathEngine<Neighborhood>::gradientCost(const GridModel& grid) {
+    return [grid](int from, int to) {
+        return 1.0 + qAbs(grid.weight(to) - grid.weight(from));
+    };
+}
+
+template<class Neighborhood>
+double BasicHamiltonianPathEngine<Neighborhood>::findMinimumCost(const QPoint& start, const QPoint& end, const MoveCost& cost,
+                                              const ImprovedCallback& onImproved) {
+    m_bestCost = -1.0;
+    if (!prepare(start, end, EndpointMode::Fixed)) {
+        return m_bestCost;
+    }
+
+    // 预先算好每个方向的移动代价和每个格子的最小进入代价，搜索中不再调用cost
+    const int cellCount = m_width * m_height;
+    m_moveCost.fill(0.0, cellCount * Neighborhood::MaxDegree);
+    m_minEnter.fill(0.0, cellCount);
+    double bound = 0.0;
+    int adjacent[Neighborhood::MaxDegree];
+    for (int cell = 0; cell < cellCount; ++cell) {
+        if (!m_walkable[cell]) {
+            continue;
+        }
+        const int count = neighbors(cell, adjacent);
+        double minEnter = -1.0;
+        for (int i = 0; i < count; ++i) {
+            const double outCost = cost(cell, adjacent[i]);
+            m_moveCost[cell * Neighborhood::MaxDegree + Neighborhood::direction(m_width, cell, adjacent[i])] = outCost;
+            const double inCost = cost(adjacent[i], cell);
+            if (!(inCost >= 0.0) || !std::isfinite(inCost)) {
+                // 负数或非有限的代价使下界不再可采纳，也与“负数表示无解”冲突，不搜索
+                return m_bestCost;
+            }
+            if (minEnter < 0.0 || inCost < minEnter) {
+                minEnter = inCost;
+            }
+        }
+        m_minEnter[cell] = qMax(minEnter, 0.0);
+        bound += m_minEnter[cell];
+    }
+
+    const int source = index(start);
+    m_counting = false;
+    m_maxPaths = std::numeric_limits<int>::max();
+    m_onImproved = onImproved;
+    resetState(m_mainState);
+    m_mainState.mainThread = true;
+    m_mainState.bound = bound - m_minEnter[source];   // 起点不需要进入
+    searchMinCost(m_mainState, source);
+    if (m_stats) {
+        flushStats(m_mainState);
+    }
+    m_expandedNodes += m_mainState.expanded;
+    m_mainState.expanded = 0;
+    m_coverage = m_mainState.covered;
+    m_onImproved = ImprovedCallback();
+    return m_bestCost;
+}
+
+template<class Neighborhood>
+int BasicHamiltonianPathEngine<Neighborhood>::findMinimumTurns(const QPoint& start, const QPoint& end,
+                                            const TurnsCallback& onImproved) {
+    m_bestTurns = -1;
+    if (!prepare(start, end, EndpointMode::Fixed)) {
+        return m_bestTurns;
+    }
+
+    m_counting = false;
+    m_maxPaths = std::numeric_limits<int>::max();
+    m_onTurnsImproved = onImproved;
+    resetState(m_mainState);
+    m_mainState.mainThread = true;
+    searchMinTurns(m_mainState, index(start));
+    if (m_stats) {
+        flushStats(m_mainState);
+    }
+    m_expandedNodes += m_mainState.expanded;
+    m_mainState.expanded = 0;
+    m_coverage = m_mainState.covered;
+    m_onTurnsImproved = TurnsCallback();
+    return m_bestTurns;
+}
+
+// 内置邻域策略的显式实例化；自定义邻域在这里追加一行
+template class BasicHamiltonianPathEngine<Neighborhoods::Four>;
+template class BasicHamiltonianPathEngine<Neighborhoods::EightAllowCornerCutting>;
+template class BasicHamiltonianPathEngine<Neighborhoods::EightNoCornerCutting>;
+template class BasicHamiltonianPathEngine<Neighborhoods::Hex>;
+template class BasicHamiltonianPathEngine<Neighborhoods::Knight>;
@@ -0,0 +1,280 @@
+#ifndef HAMILTONIANPATHENGINE_H
+#define HAMILTONIANPATHENGINE_H
+
+#include "GridModel.h"
+#include "Neighborhood.h"
+#include "SearchStats.h"
+#include <QVector>
+#include <QPoint>
+#include <QMutex>
+#include <atomic>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// 哈密顿路径搜索引擎：从起点到终点、恰好经过所有可通行格子各一次的路径
+// 只依赖网格数据，不依赖界面，可在工作线程、命令行和基准测试中复用
+// 邻域策略（Neighborhood.h）是模板参数，HamiltonianPathEngine 为四邻域版本
+//
+// 运行模式可以组合：
+//   剪枝     - 奇偶性、死角、连通性，只减少搜索量，不改变结果集合
+//   并行     - 把搜索树的前几层拆成子任务分给线程池，路径产出顺序不固定
+//   小网格   - 四邻域且宽高都不超过8时，枚举和计数改用按宽高编译期特化的位棋盘内核，
+//              结果和产出顺序与通用内核相同
+//   展开顺序 - setMoveOrder() 选择子节点的展开顺序（Warnsdorff、贴边、离终点远优先、随机），
+//              只影响路径产出的先后和找到第一条的快慢，不影响结果集合
+//   自由端点 - setEndpointMode() 让终点或起终点都不固定，所有可能的端点在同一棵搜索树中搜索，
+//              路径的首尾即其端点；只对枚举和计数有效，不使用小网格内核
+//   计数     - countPaths() 只计数不生成路径
+//   生成器   - beginPaths()/nextPaths() 按需续取下一批路径，搜索状态保存在显式栈中，两次续取之间不占线程
+//   按终点计数 - countPathsByEnd() 终点自由，一次搜索按路径的终点格子分桶计数，可顺带产出前若干条路径
+//   最小代价 - findMinimumCost() 分支定界求总代价最小的一条路径，每找到更优解回调一次
+//   最少转弯 - findMinimumTurns() 分支定界求转弯次数最少的一条路径
+template<class Neighborhood>
+class BasicHamiltonianPathEngine {
+public:
+    // 找到一条路径时回调，返回false停止搜索；并行模式下回调被串行调用
+    using PathCallback = std::function<bool(const QVector<QPoint>& path)>;
+    // 搜索过程中定期回调，用于暂停/停止和进度显示，返回false停止搜索
+    // 并行模式下只在调用findPaths/countPaths的线程中调用
+    using CheckpointCallback = std::function<bool()>;
+    // 一步移动的代价，from/to为相邻格子的行优先下标
+    using MoveCost = std::function<double(int from, int to)>;
+    // 最小代价搜索找到更优路径时回调，返回false停止搜索
+    using ImprovedCallback = std::function<bool(const QVector<QPoint>& path, double cost)>;
+    using TurnsCallback = std::function<bool(const QVector<QPoint>& path, int turns)>;
+
+    enum Pruning {
+        PruneNone = 0,
+        PruneParity = 0x1,          // 黑白染色数量与起终点颜色不符时直接判定无解（只对二分图邻域有效）
+        PruneDeadEnd = 0x2,         // 某个未访问格子的可用邻居不足以进出
+        PruneConnectivity = 0x4,    // 未访问格子不再连通
+        PruneAll = PruneParity | PruneDeadEnd | PruneConnectivity
+    };
+
+    explicit BasicHamiltonianPathEngine(const GridModel& grid);
+
+    void setCheckpoint(const CheckpointCallback& checkpoint) { m_checkpoint = checkpoint; }
+    void setPruning(int flags) { m_pruning = flags; }
+    void setThreadCount(int threads) { m_threadCount = threads; }   // <=1 为单线程
+    void setStats(SearchStats* stats) { m_stats = stats; }          // 可为空；由调用方负责reset
+    void setSmallGridKernel(bool enabled) { m_smallGridKernel = enabled; }  // 默认开启，关闭用于对比
+    // 枚举和计数时子节点的展开顺序，Random按seed打乱；非Natural时不使用小网格内核
+    void setMoveOrder(MoveOrder order, quint32 seed = 0) { m_moveOrder = order; m_seed = seed; }
+    // 枚举和计数的端点约束：FreeEnd时忽略end，FreeBoth时忽略start和end
+    void setEndpointMode(EndpointMode mode) { m_endpointMode = mode; }
+
+    int walkableCount() const { return m_walkableCount; }
+    int depth() const { return m_mainState.path.size(); }   // 当前搜索路径长度，用于估算进度（单线程）
+    quint64 expandedNodes() const { return m_expandedNodes; }   // 上次搜索扩展的节点数
+    // 本次搜索目前扩展的节点数，可在检查点中读取（单线程）
+    quint64 expandedSoFar() const { return m_expandedNodes + m_mainState.expanded; }
+    // 上次搜索估计覆盖的搜索树比例（0~1），被中止或提前结束时小于1
+    // 按“同一节点的各子树大小相同”估算：每个子节点分得父节点份额的1/子节点数，已走完的叶子份额之和即覆盖比例
+    double coverage() const { return m_coverage; }
+
+    // 依次产出最多maxPaths条哈密顿路径，返回产出数量
+    int findPaths(const QPoint& start, const QPoint& end, int maxPaths, const PathCallback& onPath);
+    QVector<QVector<QPoint>> findPaths(const QPoint& start, const QPoint& end, int maxPaths);
+
+    // 只统计路径总数；被检查点中止时返回已统计的部分
+    quint64 countPaths(const QPoint& start, const QPoint& end);
+
+    // 从start出发、终点任意，只搜索一次，把每条路径计入它的终点格子，代替对每个终点各搜索一次
+    // endCounts按行优先下标给出各终点的路径数，返回总数；maxPaths>0时同时产出前maxPaths条路径，
+    // 产出完后继续计数。不受setEndpointMode()影响；被检查点中止时为已统计的部分
+    quint64 countPathsByEnd(const QPoint& start, QVector<quint64>& endCounts,
+                            int maxPaths = 0, const PathCallback& onPath = PathCallback());
+    // 按终点计数时各终点目前的路径数，可在检查点中读取（并行时各线程仍在累加）
+    QVector<quint64> endCountsSoFar() const;
+
+    // 可暂停的枚举：beginPaths()准备好搜索，之后每次nextPaths()从上次停下的位置继续，再产出最多count条路径
+    // 搜索树的当前分支保存在显式栈中，调用方取多少才搜多少。单线程执行，不使用小网格内核；
+    // 端点约束、剪枝和展开顺序与findPaths()相同，依次取完的路径序列与单线程findPaths()一致
+    // 调用其他搜索方法后生成器失效，需要重新beginPaths()
+    bool beginPaths(const QPoint& start, const QPoint& end);     // 不用搜索即可判定无解时返回false
+    // onPath或检查点返回false时本次提前结束，生成器保持可续取；返回本次产出数量
+    // expandedNodes()和coverage()为生成器开始以来的累计值
+    int nextPaths(int count, const PathCallback& onPath);
+    bool pathsExhausted() const { return !m_generating || (m_frames.isEmpty() && m_nextSource >= m_sources.size()); }
+
+    // 以进入格子的权重为每步代价。哈密顿路径恰好进入每个格子一次，所有路径总代价相同，
+    // 下界在第一条路径之后即等于最优值，搜索随之结束
+    static MoveCost enterCellCost(const GridModel& grid);
+    // 以相邻两格权重差的绝对值加1为每步代价（把权重看作地形高度），总代价随路径走向变化
+    static MoveCost gradientCost(const GridModel& grid);
+
+    // 分支定界求总代价最小的哈密顿路径，单线程执行，剪枝设置同样生效
+    // 下界为已走代价加上每个未访问格子的最小进入代价之和；子节点按下界的增量从小到大展开
+    // 每找到更优路径回调一次；返回最优代价，无解时返回负数，被中止时返回已知最优
+    // 每步代价须为有限的非负数，否则不搜索、直接返回负数
+    double findMinimumCost(const QPoint& start, const QPoint& end, const MoveCost& cost,
+                           const ImprovedCallback& onImproved);
+
+    // 分支定界求转弯次数最少的哈密顿路径，单线程执行，剪枝设置同样生效
+    // 下界 = 已有转弯 + 必然转弯的未访问格子数（其可用邻居中没有相对的一对，进出必成直角）
+    //       + 当前格子正前方不可走时的1次；子节点优先直行
+    // 每找到更优路径回调一次；返回最少转弯数，无解时返回-1，被中止时返回已知最优
+    int findMinimumTurns(const QPoint& start, const QPoint& end, const TurnsCallback& onImproved);
+
+private:
+    // 每扩展多少个节点调用一次检查点
+    static const int CHECKPOINT_INTERVAL = 1024;
+
+    // 生成器显式栈的一层：已进入的格子和它的子节点
+    struct Frame {
+        int cell;
+        int moves[Neighborhood::MaxDegree];     // 已按展开顺序排好
+        int count;
+        int next;               // 下一个要尝试的子节点下标
+        int open;               // 进入时未访问的子节点数，子节点均分份额
+        double share;
+        bool extended;          // 是否进入过子节点
+    };
+    // 生成器进入一个格子的结果
+    enum class Visit {
+        Stopped,        // 检查点要求停止，格子未进入
+        Leaf,           // 死路或被剪枝，已退出
+        Path,           // 走完全部格子，路径仍在state中，由调用方报告后退出
+        Expanded        // 压入了新的一层
+    };
+
+    // 每个线程独立的搜索状态
+    struct SearchState {
+        QVector<bool> visited;
+        QVector<int> path;
+        QVector<QPoint> points;
+        QVector<int> floodQueue;
+        QVector<int> floodStamp;
+        int floodGeneration;
+        int remaining;              // 尚未访问的可通行格子数
+        double cost;                // 最小代价搜索：已走路径的代价
+        double bound;               // 最小代价搜索：未访问格子的最小进入代价之和
+        int turns;                  // 最少转弯搜索：已有转弯次数
+        int forcedTurns;            // 最少转弯搜索：必然转弯的未访问格子数
+        quint32 random;             // MoveOrder::Random 的随机数状态
+        double share;               // 即将进入的节点在整棵搜索树中的份额，由父节点设置
+        double covered;             // 已走完的叶子份额之和
+        quint64 expanded;
+        quint64 counted;
+        int sinceCheckpoint;
+        bool mainThread;
+
+        // 尚未写入SearchStats的本地统计
+        quint64 statNodes;
+        quint64 statBacktracks;
+        quint64 statPaths;
+        quint64 statPrunes[SearchStats::PruneReasonCount];
+        quint64 statDepth[SearchStats::DEPTH_BUCKETS];
+        int statMaxDepth;
+
+        SearchState() : floodGeneration(0), remaining(0), cost(0.0), bound(0.0),
+                        turns(0), forcedTurns(0), random(1), share(1.0), covered(0.0),
+                        expanded(0), counted(0),
+                        sinceCheckpoint(0), mainThread(true) { clearStats(); }
+        void clearStats();
+    };
+
+    int index(const QPoint& p) const { return p.y() * m_width + p.x(); }
+    QPoint toPoint(int index) const { return QPoint(index % m_width, index / m_width); }
+    bool inGrid(const QPoint& p) const {
+        return p.x() >= 0 && p.x() < m_width && p.y() >= 0 && p.y() < m_height;
+    }
+    int neighbors(int index, int* out) const {
+        return Neighborhood::collect(m_width, m_height, m_walkable, index, out);
+    }
+    double moveCost(int from, int to) const {
+        return m_moveCost[from * Neighborhood::MaxDegree + Neighborhood::direction(m_width, from, to)];
+    }
+
+    bool prepare(const QPoint& start, const QPoint& end, EndpointMode mode);
+    void resetState(SearchState& state) const;
+    void enter(SearchState& state, int cell) const;
+    void leave(SearchState& state, int cell) const;
+    bool parityAllows(int source, int target) const;
+    bool parityAllowsStart(int source) const;      // 终点自由时只看起点
+    bool deadEndAfterMove(const SearchState& state, int previous, int current) const;
+    bool disconnected(SearchState& state) const;
+    bool reportPath(SearchState& state);
+    bool reportImproved(SearchState& state);
+    void flushStats(SearchState& state);
+    bool checkpoint(SearchState& state);
+    void recordNode(SearchState& state);
+    bool pruneAfterEnter(SearchState& state, int current);
+    void orderMoves(SearchState& state, int* moves, int count) const;
+    void buildOrderKeys();
+    bool search(SearchState& state, int current);
+    Visit visitFrame(SearchState& state, int current, double share);
+    bool searchMinCost(SearchState& state, int current);
+    bool forcedTurn(const SearchState& state, int cell, int endpoint) const;
+    int forcedTurnsAround(const SearchState& state, int center, int endpoint) const;
+    bool searchMinTurns(SearchState& state, int current);
+
+    // 位棋盘内核只有四邻域版本，其他邻域匹配通用重载并返回false
+    template<class Other>
+    bool runSmallKernel(SearchState&, int, Other) { return false; }
+    template<int Unused = 0>
+    bool runSmallKernel(SearchState& state, int current, Neighborhoods::Four);
+    template<int W, int H>
+    bool searchSmall(SearchState& state, quint64 unvisited, int current);
+    typedef bool (BasicHamiltonianPathEngine::*SmallKernel)(SearchState&, quint64, int);
+    template<std::size_t... I>
+    static const SmallKernel* smallKernels(std::index_sequence<I...>);
+    template<int W, int H>
+    bool pruneSmall(SearchState& state, quint64 unvisited, int current);
+
+    void run();
+    void runSingle(int source, double share);
+    void runParallel();
+    void searchFrom(SearchState& state, int current);
+
+    int m_width;
+    int m_height;
+    int m_walkableCount;
+    QVector<bool> m_walkable;
+
+    // 运行参数
+    int m_pruning;
+    int m_threadCount;
+    bool m_smallGridKernel;
+    MoveOrder m_moveOrder;
+    quint32 m_seed;
+    EndpointMode m_endpointMode;
+    QVector<int> m_orderKey;        // 按格子固定的排序键（贴边、离终点距离），越小越先展开
+    CheckpointCallback m_checkpoint;
+    SearchStats* m_stats;
+
+    // 单次搜索状态
+    SearchState m_mainState;
+    QVector<int> m_sources;         // 本次搜索的起点；起点自由时为全部可作起点的格子
+    int m_target;                   // 终点自由时为-1
+    int m_maxPaths;
+    bool m_counting;
+    bool m_skipReversed;            // 起终点都自由：反向路径只保留一个方向
+    std::vector<std::atomic<quint64>> m_endCounts;  // 按终点计数时各终点的路径数，其余时候为空
+    // 生成器：m_mainState的路径与栈中各层一一对应，m_nextSource为下一个要进入的起点
+    QVector<Frame> m_frames;
+    int m_nextSource;
+    bool m_generating;
+    PathCallback m_onPath;
+    QMutex m_callbackMutex;
+    std::atomic<bool> m_stop;
+    std::atomic<int> m_found;
+    quint64 m_expandedNodes;
+    quint64 m_pathCount;
+    double m_coverage;
+
+    // 最小代价搜索
+    QVector<double> m_moveCost;     // 每格MaxDegree个方向的移动代价，按Neighborhood::direction()编号
+    QVector<double> m_minEnter;     // 进入每个格子的最小代价
+    double m_bestCost;
+    ImprovedCallback m_onImproved;
+
+    // 最少转弯搜索
+    int m_bestTurns;
+    TurnsCallback m_onTurnsImproved;
+};
+
+typedef BasicHamiltonianPathEngine<Neighborhoods::Four> HamiltonianPathEngine;
+
+#endif // HAMILTONIANPATHENGINE_H
@@ -0,0 +1,157 @@
+#include "HamiltonianPortfolio.h"
+#include "ConstructiveHamiltonianPath.h"
+#include "HamiltonianPathEngine.h"
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QThreadPool>
+#include <atomic>
+#include <climits>
+#include <type_traits>
+
+namespace {
+// 随机重启的首轮预算（检查点次数，每次约对应1024个节点），之后逐轮翻倍
+const int RESTART_INITIAL_BUDGET = 4;
+}
+
+QString portfolioStrategyToString(PortfolioStrategy strategy) {
+    switch (strategy) {
+        case PortfolioStrategy::Construct: return "construct";
+        case PortfolioStrategy::Natural: return "dfs";
+        case PortfolioStrategy::Warnsdorff: return "warnsdorff";
+        case PortfolioStrategy::RandomRestarts: return "randomRestarts";
+    }
+    return "dfs";
+}
+
+template<class Neighborhood>
+BasicHamiltonianPortfolio<Neighborhood>::BasicHamiltonianPortfolio(const GridModel& grid)
+    : m_grid(grid)
+    , m_strategies(defaultStrategies())
+    , m_stats(nullptr)
+    , m_expanded(0)
+{
+}
+
+template<class Neighborhood>
+QVector<PortfolioStrategy> BasicHamiltonianPortfolio<Neighborhood>::defaultStrategies() {
+    return QVector<PortfolioStrategy>() << PortfolioStrategy::Construct << PortfolioStrategy::Natural
+                                        << PortfolioStrategy::Warnsdorff << PortfolioStrategy::RandomRestarts;
+}
+
+template<class Neighborhood>
+typename BasicHamiltonianPortfolio<Neighborhood>::Result
+BasicHamiltonianPortfolio<Neighborhood>::run(const QPoint& start, const QPoint& end) {
+    Result result;
+    QElapsedTimer timer;
+    timer.start();
+
+    std::atomic<bool> stop(false);
+    m_expanded = 0;
+    QMutex resultMutex;
+
+    // 第一个给出答案的策略写入结果并叫停其他策略
+    auto finish = [&](PortfolioStrategy strategy, const QVector<QPoint>& path) {
+        QMutexLocker locker(&resultMutex);
+        if (result.decided) {
+            return;
+        }
+        result.decided = true;
+        result.winner = strategy;
+        result.path = path;
+        result.elapsedMs = timer.elapsed();
+        stop = true;
+    };
+
+    // 按节点预算运行一次DFS：找到路径或在预算内穷尽搜索时给出答案，返回是否给出了答案
+    // budget为检查点次数，<=0表示不限
+    auto runSearch = [&](PortfolioStrategy strategy, MoveOrder order, quint32 seed, int budget) {
+        BasicHamiltonianPathEngine<Neighborhood> engine(m_grid);
+        engine.setPruning(HamiltonianPathEngine::PruneAll);
+        engine.setMoveOrder(order, seed);
+        engine.setStats(m_stats);
+        int checkpoints = 0;
+        bool overBudget = false;
+        quint64 reported = 0;
+        engine.setCheckpoint([&]() {
+            // 扩展节点按增量累加，调用方的检查点随时可读
+            const quint64 expanded = engine.expandedSoFar();
+            m_expanded += expanded - reported;
+            reported = expanded;
+            if (budget > 0 && ++checkpoints >= budget) {
+                overBudget = true;
+            }
+            return !overBudget && !stop.load(std::memory_order_relaxed);
+        });
+
+        QVector<QPoint> found;
+        engine.findPaths(start, end, 1, [&found](const QVector<QPoint>& path) {
+            found = path;
+            return false;
+        });
+        m_expanded += engine.expandedNodes() - reported;
+
+        if (!found.isEmpty() || (!overBudget && !stop.load())) {
+            finish(strategy, found);
+            return true;
+        }
+        return false;
+    };
+
+    auto runStrategy = [&](PortfolioStrategy strategy) {
+        switch (strategy) {
+            case PortfolioStrategy::Construct: {
+                // 构造规则只适用于四邻域；形状不支持时不给答案，交给其他策略
+                if (!std::is_same<Neighborhood, Neighborhoods::Four>::value) {
+                    break;
+                }
+                QVector<QPoint> path;
+                if (ConstructiveHamiltonianPath(m_grid).construct(start, end, path) !=
+                    ConstructiveHamiltonianPath::Unsupported) {
+                    finish(strategy, path);
+                }
+                break;
+            }
+            case PortfolioStrategy::Natural:
+                runSearch(strategy, MoveOrder::Natural, 0, 0);
+                break;
+            case PortfolioStrategy::Warnsdorff:
+                runSearch(strategy, MoveOrder::Warnsdorff, 0, 0);
+                break;
+            case PortfolioStrategy::RandomRestarts: {
+                int budget = RESTART_INITIAL_BUDGET;
+                for (quint32 seed = 1; !stop.load(); ++seed) {
+                    if (runSearch(strategy, MoveOrder::Random, seed, budget)) {
+                        break;
+                    }
+                    // 翻倍到上限为止，溢出成负数会被当作不限
+                    budget = qMin(budget, INT_MAX / 2) * 2;
+                }
+                break;
+            }
+        }
+    };
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, m_strategies.size()));
+    for (PortfolioStrategy strategy : m_strategies) {
+        pool.start([&runStrategy, strategy]() {
+            runStrategy(strategy);
+        });
+    }
+
+    // 检查点只在本线程调用，中止时通知所有策略
+    while (!pool.waitForDone(20)) {
+        if (m_checkpoint && !m_checkpoint()) {
+            stop = true;
+        }
+    }
+
+    result.expandedNodes = m_expanded.load();
+    return result;
+}
+
+template class BasicHamiltonianPortfolio<Neighborhoods::Four>;
+template class BasicHamiltonianPortfolio<Neighborhoods::EightAllowCornerCutting>;
+template class BasicHamiltonianPortfolio<Neighborhoods::EightNoCornerCutting>;
+template class BasicHamiltonianPortfolio<Neighborhoods::Hex>;
+template class BasicHamiltonianPortfolio<Neighborhoods::Knight>;
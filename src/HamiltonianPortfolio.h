@@ -0,0 +1,66 @@
+#ifndef HAMILTONIANPORTFOLIO_H
+#define HAMILTONIANPORTFOLIO_H
+
+#include "GridModel.h"
+#include "Neighborhood.h"
+#include "SearchStats.h"
+#include <QVector>
+#include <QPoint>
+#include <QString>
+#include <atomic>
+#include <functional>
+
+// 多策略竞速中的一种求解策略
+enum class PortfolioStrategy {
+    Construct,      // 按矩形规则直接构造（只对四邻域有效，形状不支持时退出竞速）
+    Natural,        // 固定展开顺序的DFS
+    Warnsdorff,     // 后续可走格子最少优先的DFS
+    RandomRestarts  // 随机展开顺序的DFS，节点预算用完即换种子重来，预算逐次翻倍
+};
+
+QString portfolioStrategyToString(PortfolioStrategy strategy);
+
+// 多策略竞速：“找一条哈密顿路径”交给几种策略在各自的线程上同时求解，
+// 最先给出答案的策略胜出，其余策略随即停止。答案是一条路径，或者完整穷尽搜索后得出的无解
+// 实例之间最合适的策略差别很大，竞速的耗时取决于其中最快的一种，避免固定顺序的DFS偶尔极慢
+template<class Neighborhood>
+class BasicHamiltonianPortfolio {
+public:
+    // 在调用run()的线程中定期调用，返回false中止全部策略
+    using CheckpointCallback = std::function<bool()>;
+
+    struct Result {
+        QVector<QPoint> path;       // 为空表示没有路径（decided时）或被中止
+        bool decided;               // 有策略给出了答案；false表示被中止
+        PortfolioStrategy winner;   // decided时有效
+        qint64 elapsedMs;           // 给出答案的用时
+        quint64 expandedNodes;      // 各策略扩展的节点总数
+
+        Result() : decided(false), winner(PortfolioStrategy::Natural), elapsedMs(-1), expandedNodes(0) {}
+    };
+
+    explicit BasicHamiltonianPortfolio(const GridModel& grid);
+
+    void setStrategies(const QVector<PortfolioStrategy>& strategies) { m_strategies = strategies; }
+    void setCheckpoint(const CheckpointCallback& checkpoint) { m_checkpoint = checkpoint; }
+    void setStats(SearchStats* stats) { m_stats = stats; }  // 可为空；各策略的统计累加在一起
+
+    // 默认参赛的策略：全部
+    static QVector<PortfolioStrategy> defaultStrategies();
+
+    Result run(const QPoint& start, const QPoint& end);
+
+    // 本次竞速目前各策略扩展的节点总数，可在检查点中读取
+    quint64 expandedSoFar() const { return m_expanded.load(std::memory_order_relaxed); }
+
+private:
+    const GridModel& m_grid;
+    QVector<PortfolioStrategy> m_strategies;
+    CheckpointCallback m_checkpoint;
+    SearchStats* m_stats;
+    std::atomic<quint64> m_expanded;
+};
+
+typedef BasicHamiltonianPortfolio<Neighborhoods::Four> HamiltonianPortfolio;
+
+#endif // HAMILTONIANPORTFOLIO_H
@@ -0,0 +1,344 @@
+#include "KShortestPathEngine.h"
+#include <QSet>
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <vector>
+
+namespace {
+const double INF_COST = std::numeric_limits<double>::infinity();
+
+struct OpenNode {
+    double f;
+    double g;
+    int node;
+    // 优先f小的；f相同时优先g大的（更靠近终点），减少扩展数
+    bool operator<(const OpenNode& other) const {
+        if (f != other.f) return f > other.f;
+        return g < other.g;
+    }
+};
+
+struct QueuedCandidate {
+    double cost;
+    int sequence;
+    int slot;
+    // 代价相同按产生顺序出队，保证结果稳定
+    bool operator<(const QueuedCandidate& other) const {
+        if (cost != other.cost) return cost > other.cost;
+        return sequence > other.sequence;
+    }
+};
+}
+
+template<class Neighborhood>
+BasicKShortestPathEngine<Neighborhood>::BasicKShortestPathEngine(const GridModel& grid)
+    : m_width(grid.width())
+    , m_height(grid.height())
+    , m_blockGeneration(0)
+    , m_searchGeneration(0)
+    , m_spurSearch(SpurSearch::AStar)
+    , m_expandedNodes(0)
+{
+    const int cellCount = m_width * m_height;
+    m_walkable.resize(cellCount);
+    m_cost.resize(cellCount);
+    for (int i = 0; i < cellCount; ++i) {
+        m_walkable[i] = grid.isWalkable(i);
+        m_cost[i] = m_walkable[i] ? grid.weight(i) : -1.0;
+    }
+
+    m_treeDist.fill(INF_COST, cellCount);
+    m_treeNext.fill(-1, cellCount);
+    m_blockedStamp.fill(0, cellCount);
+    m_searchStamp.fill(0, cellCount);
+    m_gScore.fill(INF_COST, cellCount);
+    m_parent.fill(-1, cellCount);
+}
+
+template<class Neighborhood>
+QVector<QPoint> BasicKShortestPathEngine<Neighborhood>::toPoints(const QVector<int>& nodes) const {
+    QVector<QPoint> points;
+    points.reserve(nodes.size());
+    for (int node : nodes) {
+        points.append(toPoint(node));
+    }
+    return points;
+}
+
+template<class Neighborhood>
+void BasicKShortestPathEngine<Neighborhood>::buildReverseTree(int target) {
+    // 反向Dijkstra：m_treeDist[v] 为从v走到终点的最小代价，m_treeNext[v] 为下一步
+    m_treeDist.fill(INF_COST);
+    m_treeNext.fill(-1);
+
+    std::priority_queue<OpenNode> open;
+    m_treeDist[target] = 0.0;
+    open.push({0.0, 0.0, target});
+
+    int adjacent[Neighborhood::MaxDegree];
+    while (!open.empty()) {
+        OpenNode current = open.top();
+        open.pop();
+        if (current.g > m_treeDist[current.node]) {
+            continue;
+        }
+        ++m_expandedNodes;
+        // 从邻居v走进current的代价为current格子的权重
+        const double enterCost = m_cost[current.node];
+        const int count = neighbors(current.node, adjacent);
+        for (int i = 0; i < count; ++i) {
+            const int v = adjacent[i];
+            const double dist = current.g + enterCost;
+            if (dist < m_treeDist[v]) {
+                m_treeDist[v] = dist;
+                m_treeNext[v] = current.node;
+                open.push({dist, dist, v});
+            }
+        }
+    }
+}
+
+template<class Neighborhood>
+bool BasicKShortestPathEngine<Neighborhood>::followTree(int spur, int target, const QVector<int>& bannedNext,
+                                     QVector<int>& spurPath, double& spurCost) const {
+    // 树上路径是全图最短路，若它没有碰到封锁节点和禁用边，就一定是当前子图的最短路
+    const int first = m_treeNext[spur];
+    if (first < 0 || bannedNext.contains(first)) {
+        return false;
+    }
+
+    spurPath.clear();
+    spurPath.append(spur);
+    for (int node = first; node >= 0; node = m_treeNext[node]) {
+        if (m_blockedStamp[node] == m_blockGeneration) {
+            return false;
+        }
+        spurPath.append(node);
+        if (node == target) {
+            spurCost = m_treeDist[spur];
+            return true;
+        }
+    }
+    return false;
+}
+
+template<class Neighborhood>
+bool BasicKShortestPathEngine<Neighborhood>::findSpurPath(int spur, int target, const QVector<int>& bannedNext,
+                                       QVector<int>& spurPath, double& spurCost) {
+    if (m_treeDist[spur] == INF_COST) {
+        return false;  // 全图都不可达，子图更不可达
+    }
+    if (followTree(spur, target, bannedNext, spurPath, spurCost)) {
+        return true;
+    }
+
+    const bool useHeuristic = (m_spurSearch == SpurSearch::AStar);
+    ++m_searchGeneration;
+
+    std::priority_queue<OpenNode> open;
+    m_searchStamp[spur] = m_searchGeneration;
+    m_gScore[spur] = 0.0;
+    m_parent[spur] = -1;
+    open.push({useHeuristic ? m_treeDist[spur] : 0.0, 0.0, spur});
+
+    int adjacent[Neighborhood::MaxDegree];
+    while (!open.empty()) {
+        OpenNode current = open.top();
+        open.pop();
+        if (current.g > m_gScore[current.node]) {
+            continue;
+        }
+        ++m_expandedNodes;
+        if (current.node == target) {
+            spurCost = current.g;
+            spurPath.clear();
+            for (int node = target; node >= 0; node = m_parent[node]) {
+                spurPath.append(node);
+            }
+            std::reverse(spurPath.begin(), spurPath.end());
+            return true;
+        }
+
+        const int count = neighbors(current.node, adjacent);
+        for (int i = 0; i < count; ++i) {
+            const int v = adjacent[i];
+            if (m_blockedStamp[v] == m_blockGeneration) continue;
+            if (current.node == spur && bannedNext.contains(v)) continue;
+            // 原图中到不了终点的格子，在子图中也到不了
+            if (m_treeDist[v] == INF_COST) continue;
+
+            const double g = current.g + m_cost[v];
+            if (m_searchStamp[v] != m_searchGeneration || g < m_gScore[v]) {
+                m_searchStamp[v] = m_searchGeneration;
+                m_gScore[v] = g;
+                m_parent[v] = current.node;
+                const double h = useHeuristic ? m_treeDist[v] : 0.0;
+                open.push({g + h, g, v});
+            }
+        }
+    }
+    return false;
+}
+
+template<class Neighborhood>
+int BasicKShortestPathEngine<Neighborhood>::findPaths(const QPoint& start, const QPoint& end, int k,
+                                   const PathCallback& onPath) {
+    m_expandedNodes = 0;
+    if (k <= 0 || m_width == 0 || m_height == 0) {
+        return 0;
+    }
+    if (start.x() < 0 || start.x() >= m_width || start.y() < 0 || start.y() >= m_height ||
+        end.x() < 0 || end.x() >= m_width || end.y() < 0 || end.y() >= m_height) {
+        return 0;
+    }
+
+    const int source = index(start);
+    const int target = index(end);
+    if (!isWalkable(source) || !isWalkable(target)) {
+        return 0;
+    }
+
+    if (source == target) {
+        QVector<int> single;
+        single.append(source);
+        onPath(toPoints(single), 0.0);
+        return 1;
+    }
+
+    buildReverseTree(target);
+    if (m_treeDist[source] == INF_COST) {
+        return 0;
+    }
+
+    QVector<Candidate> accepted;
+    QSet<QVector<int>> knownPaths;  // 已接受和候选中的路径，哈希去重
+
+    Candidate first;
+    m_blockGeneration++;
+    QVector<int> noBan;
+    if (!followTree(source, target, noBan, first.nodes, first.cost)) {
+        return 0;
+    }
+    first.deviation = 0;
+    knownPaths.insert(first.nodes);
+    accepted.append(first);
+    if (!onPath(toPoints(first.nodes), first.cost)) {
+        return 1;
+    }
+
+    QVector<Candidate> candidatePool;
+    std::priority_queue<QueuedCandidate> candidates;
+    int sequence = 0;
+
+    QVector<int> sharingRoot;   // 与当前根路径前缀相同的已接受路径
+    QVector<int> bannedNext;
+    QVector<int> spurPath;
+
+    while (accepted.size() < k) {
+        const Candidate& previous = accepted.last();
+        const QVector<int>& prevNodes = previous.nodes;
+
+        // 根路径前缀代价
+        QVector<double> prefixCost(prevNodes.size(), 0.0);
+        for (int i = 1; i < prevNodes.size(); ++i) {
+            prefixCost[i] = prefixCost[i - 1] + m_cost[prevNodes[i]];
+        }
+
+        // 先筛出与 prevNodes[0..deviation] 前缀相同的已接受路径，之后随i递增逐步收窄
+        sharingRoot.clear();
+        for (int a = 0; a < accepted.size(); ++a) {
+            const QVector<int>& nodes = accepted[a].nodes;
+            if (nodes.size() <= previous.deviation) continue;
+            bool same = true;
+            for (int j = 0; j <= previous.deviation && same; ++j) {
+                same = (nodes[j] == prevNodes[j]);
+            }
+            if (same) sharingRoot.append(a);
+        }
+
+        m_blockGeneration++;
+        for (int j = 0; j < previous.deviation; ++j) {
+            m_blockedStamp[prevNodes[j]] = m_blockGeneration;
+        }
+
+        for (int i = previous.deviation; i < prevNodes.size() - 1; ++i) {
+            if (m_checkpoint && !m_checkpoint()) {
+                return accepted.size();
+            }
+
+            const int spur = prevNodes[i];
+            if (i > previous.deviation) {
+                // 根路径延长一格：上一个偏离点加入封锁，前缀不再相同的路径剔除
+                m_blockedStamp[prevNodes[i - 1]] = m_blockGeneration;
+                int kept = 0;
+                for (int a : sharingRoot) {
+                    const QVector<int>& nodes = accepted[a].nodes;
+                    if (nodes.size() > i && nodes[i] == spur) {
+                        sharingRoot[kept++] = a;
+                    }
+                }
+                sharingRoot.resize(kept);
+            }
+
+            bannedNext.clear();
+            for (int a : sharingRoot) {
+                const QVector<int>& nodes = accepted[a].nodes;
+                if (nodes.size() > i + 1) {
+                    bannedNext.append(nodes[i + 1]);
+                }
+            }
+
+            double spurCost = 0.0;
+            if (!findSpurPath(spur, target, bannedNext, spurPath, spurCost)) {
+                continue;
+            }
+
+            Candidate candidate;
+            candidate.nodes = prevNodes.mid(0, i);
+            candidate.nodes.append(spurPath);
+            if (knownPaths.contains(candidate.nodes)) {
+                continue;
+            }
+            candidate.cost = prefixCost[i] + spurCost;
+            candidate.deviation = i;
+            knownPaths.insert(candidate.nodes);
+
+            candidatePool.append(candidate);
+            candidates.push({candidate.cost, sequence++, candidatePool.size() - 1});
+        }
+
+        if (candidates.empty()) {
+            break;
+        }
+
+        const int slot = candidates.top().slot;
+        candidates.pop();
+        accepted.append(std::move(candidatePool[slot]));
+        candidatePool[slot].nodes.clear();
+
+        const Candidate& best = accepted.last();
+        if (!onPath(toPoints(best.nodes), best.cost)) {
+            break;
+        }
+    }
+
+    return accepted.size();
+}
+
+template<class Neighborhood>
+QVector<QVector<QPoint>> BasicKShortestPathEngine<Neighborhood>::findPaths(const QPoint& start, const QPoint& end, int k) {
+    QVector<QVector<QPoint>> paths;
+    findPaths(start, end, k, [&paths](const QVector<QPoint>& path, double) {
+        paths.append(path);
+        return true;
+    });
+    return paths;
+}
+
+// 内置邻域策略的显式实例化；自定义邻域在这里追加一行
+template class BasicKShortestPathEngine<Neighborhoods::Four>;
+template class BasicKShortestPathEngine<Neighborhoods::EightAllowCornerCutting>;
+template class BasicKShortestPathEngine<Neighborhoods::EightNoCornerCutting>;
+template class BasicKShortestPathEngine<Neighborhoods::Hex>;
+template class BasicKShortestPathEngine<Neighborhoods::Knight>;
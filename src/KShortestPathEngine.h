@@ -0,0 +1,88 @@
+#ifndef KSHORTESTPATHENGINE_H
+#define KSHORTESTPATHENGINE_H
+
+#include "GridModel.h"
+#include "Neighborhood.h"
+#include <QVector>
+#include <QPoint>
+#include <functional>
+
+// K条最短无环路径引擎（Yen算法）
+// 路径代价 = 进入的每个格子的权重之和（起点不计），按代价从小到大依次产出
+// 邻域策略是模板参数，KShortestPathEngine 为四邻域版本
+template<class Neighborhood>
+class BasicKShortestPathEngine {
+public:
+    // 偏离路径（spur path）的搜索方式
+    enum class SpurSearch {
+        AStar,      // 以反向最短路径树的距离作为启发值
+        Dijkstra    // 不使用启发值
+    };
+
+    // 每找到一条路径回调一次，返回false表示停止继续搜索
+    using PathCallback = std::function<bool(const QVector<QPoint>& path, double cost)>;
+    // 每次偏离搜索前调用，返回false表示中止（用于暂停/停止控制）
+    using CheckpointCallback = std::function<bool()>;
+
+    explicit BasicKShortestPathEngine(const GridModel& grid);
+
+    void setSpurSearch(SpurSearch mode) { m_spurSearch = mode; }
+    void setCheckpoint(const CheckpointCallback& checkpoint) { m_checkpoint = checkpoint; }
+
+    // 上次findPaths中从优先队列取出并扩展的节点数（含反向树），用于性能统计
+    quint64 expandedNodes() const { return m_expandedNodes; }
+
+    // 流式查找前k条路径，返回实际找到的数量
+    int findPaths(const QPoint& start, const QPoint& end, int k, const PathCallback& onPath);
+
+    // 一次性返回前k条路径
+    QVector<QVector<QPoint>> findPaths(const QPoint& start, const QPoint& end, int k);
+
+private:
+    struct Candidate {
+        QVector<int> nodes;
+        double cost;
+        int deviation;  // 与父路径分叉的位置，之前的偏离点无需再搜索
+    };
+
+    int index(const QPoint& p) const { return p.y() * m_width + p.x(); }
+    QPoint toPoint(int index) const { return QPoint(index % m_width, index / m_width); }
+    bool isWalkable(int index) const { return m_walkable[index]; }
+    int neighbors(int index, int* out) const {
+        return Neighborhood::collect(m_width, m_height, m_walkable, index, out);
+    }
+    QVector<QPoint> toPoints(const QVector<int>& nodes) const;
+
+    // 以终点为根建立反向最短路径树，所有偏离搜索共享
+    void buildReverseTree(int target);
+    // 从spur出发到终点的最短路径，绕开被封锁的节点和spur的禁用出边
+    bool findSpurPath(int spur, int target, const QVector<int>& bannedNext,
+                      QVector<int>& spurPath, double& spurCost);
+    bool followTree(int spur, int target, const QVector<int>& bannedNext,
+                    QVector<int>& spurPath, double& spurCost) const;
+
+    int m_width;
+    int m_height;
+    QVector<bool> m_walkable;
+    QVector<double> m_cost;     // 每个格子的进入代价，负数表示障碍
+
+    // 反向最短路径树
+    QVector<double> m_treeDist;
+    QVector<int> m_treeNext;
+
+    // 偏离搜索的工作区，用代数标记代替每次清空
+    QVector<int> m_blockedStamp;
+    QVector<int> m_searchStamp;
+    QVector<double> m_gScore;
+    QVector<int> m_parent;
+    int m_blockGeneration;
+    int m_searchGeneration;
+
+    SpurSearch m_spurSearch;
+    quint64 m_expandedNodes;
+    CheckpointCallback m_checkpoint;
+};
+
+typedef BasicKShortestPathEngine<Neighborhoods::Four> KShortestPathEngine;
+
+#endif // KSHORTESTPATHENGINE_H
@@ -0,0 +1,42 @@
+#include "Log.h"
+#include <chrono>
+
+Q_LOGGING_CATEGORY(lcEngine, "qweight.engine")
+Q_LOGGING_CATEGORY(lcWorker, "qweight.worker")
+Q_LOGGING_CATEGORY(lcUi, "qweight.ui")
+Q_LOGGING_CATEGORY(lcData, "qweight.data")
+
+namespace {
+qint64 steadyMs() {
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+}
+
+QWeightLog::RateLimiter::RateLimiter(const QLoggingCategory& category, int perSecond)
+    : m_category(category)
+    , m_perSecond(perSecond)
+    , m_windowStart(steadyMs())
+    , m_passed(0)
+    , m_dropped(0)
+{
+}
+
+bool QWeightLog::RateLimiter::allow() {
+    const qint64 now = steadyMs();
+    qint64 windowStart = m_windowStart.load(std::memory_order_relaxed);
+    if (now - windowStart >= 1000 &&
+        m_windowStart.compare_exchange_strong(windowStart, now, std::memory_order_relaxed)) {
+        // 只有开启新窗口的线程负责报告上一窗口丢弃的条数
+        m_passed = 0;
+        const int dropped = m_dropped.exchange(0);
+        if (dropped > 0) {
+            qCDebug(m_category) << "（限速，上一秒省略" << dropped << "条日志）";
+        }
+    }
+    if (m_passed.fetch_add(1, std::memory_order_relaxed) < m_perSecond) {
+        return true;
+    }
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
@@ -0,0 +1,71 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <QLoggingCategory>
+#include <atomic>
+
+// 分类日志：级别在编译期确定，低于编译级别的日志语句整体被编译器删除
+//
+//   QW_WARN(lcWorker) << ...;                    警告
+//   QW_INFO(lcWorker) << ...;                    每个任务一两次的关键事件
+//   QW_DEBUG(lcWorker) << ...;                   调试信息
+//   QW_TRACE_RATE(lcWorker, 10) << ...;          每条路径一次的跟踪信息，每秒最多输出10条
+//
+// 编译级别由 QWEIGHT_LOG_LEVEL 指定（0~4，对应 关闭/警告/信息/调试/跟踪），
+// 默认Debug构建为调试级，Release构建为警告级。运行时仍可用 QT_LOGGING_RULES 按分类关闭。
+
+#define QWEIGHT_LOG_OFF     0
+#define QWEIGHT_LOG_WARNING 1
+#define QWEIGHT_LOG_INFO    2
+#define QWEIGHT_LOG_DEBUG   3
+#define QWEIGHT_LOG_TRACE   4
+
+#ifndef QWEIGHT_LOG_LEVEL
+#  ifdef QT_NO_DEBUG
+#    define QWEIGHT_LOG_LEVEL QWEIGHT_LOG_WARNING
+#  else
+#    define QWEIGHT_LOG_LEVEL QWEIGHT_LOG_DEBUG
+#  endif
+#endif
+
+Q_DECLARE_LOGGING_CATEGORY(lcEngine)    // qweight.engine   搜索引擎
+Q_DECLARE_LOGGING_CATEGORY(lcWorker)    // qweight.worker   异步计算线程与结果分发
+Q_DECLARE_LOGGING_CATEGORY(lcUi)        // qweight.ui       主窗口与结果列表
+Q_DECLARE_LOGGING_CATEGORY(lcData)      // qweight.data     持久化
+
+namespace QWeightLog {
+    // 每个调用点一个的限速器：每秒最多放行perSecond条，下一秒开始时报告被丢弃的条数
+    class RateLimiter {
+    public:
+        RateLimiter(const QLoggingCategory& category, int perSecond);
+        bool allow();
+
+    private:
+        const QLoggingCategory& m_category;
+        const int m_perSecond;
+        std::atomic<qint64> m_windowStart;
+        std::atomic<int> m_passed;
+        std::atomic<int> m_dropped;
+    };
+}
+
+// 条件为编译期常量时，if分支连同<<右侧的表达式一起被消除
+#define QW_LOG_AT(level, category, stream) \
+    if (QWEIGHT_LOG_LEVEL < (level)) {} else stream(category)
+
+#define QW_WARN(category)  QW_LOG_AT(QWEIGHT_LOG_WARNING, category, qCWarning)
+#define QW_INFO(category)  QW_LOG_AT(QWEIGHT_LOG_INFO, category, qCInfo)
+#define QW_DEBUG(category) QW_LOG_AT(QWEIGHT_LOG_DEBUG, category, qCDebug)
+#define QW_TRACE(category) QW_LOG_AT(QWEIGHT_LOG_TRACE, category, qCDebug)
+
+// 限速版本：限速器是调用点内的静态对象，只有编译级别允许时才会被构造和检查
+#define QW_LOG_RATE_AT(level, category, stream, perSecond) \
+    if (QWEIGHT_LOG_LEVEL < (level) || !category().isDebugEnabled() || \
+        !([]() -> bool { static QWeightLog::RateLimiter limiter(category(), perSecond); \
+                         return limiter.allow(); })()) {} \
+    else stream(category)
+
+#define QW_DEBUG_RATE(category, perSecond) QW_LOG_RATE_AT(QWEIGHT_LOG_DEBUG, category, qCDebug, perSecond)
+#define QW_TRACE_RATE(category, perSecond) QW_LOG_RATE_AT(QWEIGHT_LOG_TRACE, category, qCDebug, perSecond)
+
+#endif // LOG_H
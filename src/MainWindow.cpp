@@ -1,5 +1,9 @@
 #include "MainWindow.h"
 #include "LayoutTestWindow.h"
+#include "HamiltonianPathEngine.h"
+#include "KShortestPathEngine.h"
+#include "Log.h"
+#include "ShortestPathDag.h"
 #include <QApplication>
 #include <QMenuBar>
 #include <QStatusBar>
@@ -40,6 +44,10 @@ MainWindow::MainWindow(QWidget* parent)
                 this, &MainWindow::onAsyncPartialPathFound);
         connect(m_asyncCalculator, &AsyncPathCalculator::pathNotFound,
                 this, &MainWindow::onAsyncPathNotFound);
+        connect(m_asyncCalculator, &AsyncPathCalculator::budgetExhausted,
+                this, &MainWindow::onAsyncBudgetExhausted);
+        connect(m_asyncCalculator, &AsyncPathCalculator::endCountsUpdated,
+                this, &MainWindow::onAsyncEndCountsUpdated);
         connect(m_asyncCalculator, &AsyncPathCalculator::calculationProgress,
                 this, &MainWindow::onAsyncCalculationProgress);
         connect(m_asyncCalculator, &AsyncPathCalculator::calculationStarted,
@@ -60,6 +68,11 @@ MainWindow::MainWindow(QWidget* parent)
         m_batchTimer->setInterval(100); // 每100ms处理一次队列，提高响应性
         connect(m_batchTimer, &QTimer::timeout, this, &MainWindow::processBatchQueue);
         
+        // 搜索统计刷新定时器，只读取原子计数器，不打断搜索线程
+        m_statsTimer = new QTimer(this);
+        m_statsTimer->setInterval(250);
+        connect(m_statsTimer, &QTimer::timeout, this, &MainWindow::refreshSearchStats);
+        
         qDebug() << "设置连接...";
         setupConnections();
         
@@ -234,6 +247,10 @@ void MainWindow::setupStatusBar() {
         m_statusLabel = new QLabel("就绪");
         m_statusBar->addWidget(m_statusLabel);
         
+        // 搜索统计摘要
+        m_statsLabel = new QLabel();
+        m_statusBar->addPermanentWidget(m_statsLabel);
+        
         // 添加网格大小标签
         m_gridSizeLabel = new QLabel("网格: 20×15");
         m_statusBar->addPermanentWidget(m_gridSizeLabel);
@@ -268,6 +285,8 @@ void MainWindow::setupConnections() {
                     this, &MainWindow::onSetStartPointMode);
             connect(m_controlPanel, &ControlPanel::setEndPointMode,
                     this, &MainWindow::onSetEndPointMode);
+            connect(m_controlPanel, &ControlPanel::setWeightMode,
+                    this, &MainWindow::onSetWeightMode);
             connect(m_controlPanel, &ControlPanel::startCalculation,
                     this, &MainWindow::onStartCalculation);
             connect(m_controlPanel, &ControlPanel::stopCalculation,
@@ -288,6 +307,8 @@ void MainWindow::setupConnections() {
                     this, &MainWindow::onExportResults);
             connect(m_resultList, &ResultListWidget::resultsChanged,
                     this, &MainWindow::updateMenuStates);
+            connect(m_resultList, &ResultListWidget::fetchMoreRequested,
+                    this, &MainWindow::onFetchMorePaths);
         }
         
         // 批量结果信号连接
@@ -330,6 +351,17 @@ void MainWindow::updateCalculationProgress(int percentage) {
     m_progressBar->setValue(percentage);
 }
 
+void MainWindow::refreshSearchStats() {
+    const SearchStats::Snapshot stats = m_asyncCalculator->statsSnapshot();
+    m_statsLabel->setText(stats.summary());
+    m_controlPanel->updateSearchStats(stats);
+    
+    // 计算结束后再刷新一次即停止
+    if (!m_isCalculating && !stats.running) {
+        m_statsTimer->stop();
+    }
+}
+
 void MainWindow::updateGridSizeLabel() {
     qDebug() << "updateGridSizeLabel 开始...";
     
@@ -406,6 +438,15 @@ void MainWindow::onPointClicked(QPoint position, PointType currentType) {
             }
             break;
             
+        case SetWeight:
+            if (currentType != PointType::Obstacle) {
+                const double weight = m_controlPanel->getCellWeight();
+                m_gridView->setPointWeight(position.x(), position.y(), weight);
+                updateStatusMessage(QString("(%1,%2) 的权重设置为 %3")
+                                    .arg(position.x()).arg(position.y()).arg(weight));
+            }
+            break;
+            
         case None:
             // 普通点击，可以切换障碍点
             if (currentType == PointType::Normal) {
@@ -437,21 +478,35 @@ void MainWindow::onSetEndPointMode() {
     updateStatusMessage("点击网格设置终点");
 }
 
+void MainWindow::onSetWeightMode(bool enabled) {
+    m_pointSetMode = enabled ? SetWeight : None;
+    updateStatusMessage(enabled ? "点击网格设置格子权重" : "已退出权重设置");
+}
+
 void MainWindow::onStartCalculation() {
-    qDebug() << "onStartCalculation 开始...";
-    
-    // 检查起点终点是否设置
-    if (!m_gridView->hasStartPoint() || !m_gridView->hasEndPoint()) {
+    QW_DEBUG(lcUi) << "onStartCalculation 开始...";
+    
+    // 检查起点终点是否设置；端点自由的DFS和按终点统计只需要固定的那一端
+    const bool dfs = m_controlPanel->getCurrentAlgorithm() == AlgorithmType::DFS;
+    const EndpointMode endpointMode = dfs ? m_controlPanel->getEndpointMode() : EndpointMode::Fixed;
+    const bool endCounts = dfs && m_controlPanel->getObjective() == PathObjective::EndCounts;
+    const bool needEnd = endpointMode == EndpointMode::Fixed && !endCounts;
+    const bool needStart = endpointMode != EndpointMode::FreeBoth || endCounts;
+    if (needEnd && (!m_gridView->hasStartPoint() || !m_gridView->hasEndPoint())) {
         QMessageBox::warning(this, "警告", "请先设置起点和终点！");
         return;
     }
+    if (needStart && !m_gridView->hasStartPoint()) {
+        QMessageBox::warning(this, "警告", "请先设置起点！");
+        return;
+    }
     
     if (m_isCalculating) {
-        qDebug() << "已经在计算中，返回";
+        QW_DEBUG(lcUi) << "已经在计算中，返回";
         return; // 已经在计算中
     }
     
-    qDebug() << "设置计算状态...";
+    QW_DEBUG(lcUi) << "设置计算状态...";
     m_isCalculating = true;
     m_shouldStopCalculation = false;
     m_totalPathCount = 0;  // 重置路径计数器
@@ -462,42 +517,50 @@ void MainWindow::onStartCalculation() {
     // 获取起点和终点
     QPoint start = m_gridView->getStartPoint();
     QPoint end = m_gridView->getEndPoint();
-    qDebug() << "起点:" << start << "终点:" << end;
+    QW_DEBUG(lcUi) << "起点:" << start << "终点:" << end;
     
     // 获取当前网格大小信息用于显示
     int gridWidth = m_gridView->gridWidth();
     int gridHeight = m_gridView->gridHeight();
-    qDebug() << "网格大小:" << gridWidth << "x" << gridHeight;
+    QW_DEBUG(lcUi) << "网格大小:" << gridWidth << "x" << gridHeight;
     
     // 清空之前的结果
-    qDebug() << "清空之前的结果...";
+    QW_DEBUG(lcUi) << "清空之前的结果...";
     m_resultList->clearResults();
     m_gridView->clearPath();
+    m_gridView->clearHeatmap();
     
     // 获取当前选择的算法
     AlgorithmType algorithm = m_controlPanel->getCurrentAlgorithm();
     QString algorithmName = algorithmTypeToString(algorithm);
-    qDebug() << "使用算法:" << algorithmName;
+    QW_DEBUG(lcUi) << "使用算法:" << algorithmName;
     
     updateStatusMessage(QString("正在使用 %1 算法异步计算路径...").arg(algorithmName));
     
-    // 设置网格到异步计算器
-    m_asyncCalculator->setGrid(m_gridView->getGrid());
+    // 设置网格快照到异步计算器（只传递共享指针）
+    m_asyncCalculator->setGrid(m_gridView->snapshot());
+    m_asyncCalculator->setNeighborhood(m_controlPanel->getNeighborhood());
+    m_asyncCalculator->setMoveOrder(m_controlPanel->getMoveOrder());
+    m_asyncCalculator->setEndpointMode(endpointMode);
+    m_asyncCalculator->setBudget(m_controlPanel->getBudget());
     
     // 确保结果检查器启动
     m_asyncCalculator->startResultChecker(100);
     
     // 添加计算任务到异步计算器
-    qDebug() << "=== 开始异步路径计算 ===";
-    qDebug() << "起点:" << start << "终点:" << end;
-    qDebug() << "网格大小:" << gridWidth << "x" << gridHeight;
-    qDebug() << "算法:" << algorithmName;
-    
-    int taskId = m_asyncCalculator->addCalculationTask(start, end, algorithm);
+    QW_DEBUG(lcUi) << "=== 开始异步路径计算 ===";
+    QW_DEBUG(lcUi) << "起点:" << start << "终点:" << end;
+    QW_DEBUG(lcUi) << "网格大小:" << gridWidth << "x" << gridHeight;
+    QW_DEBUG(lcUi) << "算法:" << algorithmName;
+    
+    int taskId = m_asyncCalculator->addCalculationTask(start, end, algorithm,
+                                                       m_controlPanel->getMaxPaths(),
+                                                       m_controlPanel->getObjective());
     m_activeTaskAlgorithms[taskId] = algorithm;
     m_activeTaskNames[taskId] = QString("任务_%1_%2").arg(taskId).arg(algorithmName);
+    m_statsTimer->start();
     
-    qDebug() << "添加了计算任务，任务ID:" << taskId;
+    QW_DEBUG(lcUi) << "添加了计算任务，任务ID:" << taskId;
 }
 
 QVector<QPoint> MainWindow::calculateSimplePath(const QPoint& start, const QPoint& end) {
@@ -529,449 +592,53 @@ QVector<QPoint> MainWindow::calculateSimplePath(const QPoint& start, const QPoin
 }
 
 QVector<QVector<QPoint>> MainWindow::calculateAllPossiblePaths(const QPoint& start, const QPoint& end, AlgorithmType algorithm) {
-    QVector<QVector<QPoint>> allPaths;
+    // 同步计算时返回的路径条数
+    const int alternativePathCount = 50;
     
-    // 根据选择的算法生成多条可能的路径
     switch (algorithm) {
-        case AlgorithmType::AStar:
-            // A*算法 - 生成多条可能的最优路径变体
-            allPaths.append(calculateAStarPath(start, end));
-            // 生成更多路径变体 - 增加到50条
-            for (int i = 1; i <= 50; ++i) {
-                QVector<QPoint> variant = calculatePathVariant(start, end, i);
-                if (!variant.isEmpty()) {
-                    allPaths.append(variant);
-                }
-            }
-            break;
-            
-        case AlgorithmType::Dijkstra:
-            // Dijkstra算法 - 生成多条等长最短路径
-            allPaths.append(calculateDijkstraPath(start, end));
-            // 生成更多等长路径变体 - 增加到60条
-            for (int i = 1; i <= 60; ++i) {
-                QVector<QPoint> variant = calculatePathVariant(start, end, i + 50);
-                if (!variant.isEmpty()) {
-                    allPaths.append(variant);
-                }
-            }
-            break;
-            
         case AlgorithmType::BFS:
-            // BFS - 生成所有可能的最短路径
-            allPaths.append(calculateBFSPath(start, end));
-            // 生成其他最短路径 - 增加到70条
-            for (int i = 1; i <= 70; ++i) {
-                QVector<QPoint> variant = calculatePathVariant(start, end, i + 100);
-                if (!variant.isEmpty()) {
-                    allPaths.append(variant);
-                }
-            }
-            break;
-            
-        case AlgorithmType::DFS:
-            // DFS - 使用回溯法找到所有可能的路径，边计算边返回
-            {
-                // 直接开始DFS计算，不预先计算所有路径
-                calculateAllDFSPathsProgressive(start, end, algorithm);
-                return allPaths; // 返回空的，因为路径会逐步添加到结果列表中
-            }
-            break;
-    }
-    
-    // 去除重复路径
-    QVector<QVector<QPoint>> uniquePaths;
-    for (const QVector<QPoint>& path : allPaths) {
-        bool isDuplicate = false;
-        for (const QVector<QPoint>& existingPath : uniquePaths) {
-            if (path == existingPath) {
-                isDuplicate = true;
-                break;
-            }
-        }
-        if (!isDuplicate && !path.isEmpty()) {
-            uniquePaths.append(path);
-        }
-    }
-    
-    // 用去重后的路径替换原来的
-    allPaths = uniquePaths;
-    
-    // 确保至少有一条路径
-    if (allPaths.isEmpty()) {
-        allPaths.append(calculateSimplePath(start, end));
-    }
-    
-    return allPaths;
-}
-
-QVector<QPoint> MainWindow::calculatePathVariant(const QPoint& start, const QPoint& end, int variant) {
-    QVector<QPoint> path;
-    path.append(start);
-    
-    QPoint current = start;
-    
-    // 根据变体类型生成不同的路径，增加更多类型
-    int pathType = variant % 16; // 增加到16种不同的路径类型
-    
-    switch (pathType) {
-        case 0: // 先水平后垂直
-            while (current.x() != end.x()) {
-                current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                path.append(current);
-            }
-            while (current.y() != end.y()) {
-                current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                path.append(current);
-            }
-            break;
-            
-        case 1: // 先垂直后水平
-            while (current.y() != end.y()) {
-                current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                path.append(current);
-            }
-            while (current.x() != end.x()) {
-                current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                path.append(current);
-            }
-            break;
-            
-        case 2: // 阶梯式路径1 (一步水平一步垂直)
-            while (current.x() != end.x() || current.y() != end.y()) {
-                if (current.x() != end.x()) {
-                    current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                    path.append(current);
-                }
-                if (current.y() != end.y()) {
-                    current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                    path.append(current);
-                }
-            }
-            break;
-            
-        case 3: // 阶梯式路径2 (一步垂直一步水平)
-            while (current.x() != end.x() || current.y() != end.y()) {
-                if (current.y() != end.y()) {
-                    current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                    path.append(current);
-                }
-                if (current.x() != end.x()) {
-                    current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                    path.append(current);
-                }
-            }
-            break;
-            
-        case 4: // 两步水平一步垂直
-            while (current.x() != end.x() || current.y() != end.y()) {
-                // 水平移动两步（如果可能）
-                for (int i = 0; i < 2 && current.x() != end.x(); ++i) {
-                    current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                    path.append(current);
-                }
-                // 垂直移动一步
-                if (current.y() != end.y()) {
-                    current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                    path.append(current);
-                }
-            }
-            break;
-            
-        case 5: // 一步水平两步垂直
-            while (current.x() != end.x() || current.y() != end.y()) {
-                // 水平移动一步
-                if (current.x() != end.x()) {
-                    current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                    path.append(current);
-                }
-                // 垂直移动两步（如果可能）
-                for (int i = 0; i < 2 && current.y() != end.y(); ++i) {
-                    current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                    path.append(current);
-                }
-            }
-            break;
-            
-        case 6: // 中点路径 (先到中点再到终点)
-            {
-                QPoint mid((start.x() + end.x()) / 2, (start.y() + end.y()) / 2);
-                // 到中点
-                while (current.x() != mid.x()) {
-                    current.setX(current.x() + (mid.x() > current.x() ? 1 : -1));
-                    path.append(current);
-                }
-                while (current.y() != mid.y()) {
-                    current.setY(current.y() + (mid.y() > current.y() ? 1 : -1));
-                    path.append(current);
-                }
-                // 从中点到终点
-                while (current.x() != end.x()) {
-                    current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                    path.append(current);
-                }
-                while (current.y() != end.y()) {
-                    current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                    path.append(current);
-                }
-            }
-            break;
-            
-        case 7: // 绕行路径 (稍微绕一下)
             {
-                int detourX = (variant / 16) % 3 - 1; // -1, 0, 1的偏移
-                int detourY = (variant / 48) % 3 - 1;
-                
-                QPoint detour(start.x() + detourX, start.y() + detourY);
-                
-                // 确保绕行点在合理范围内
-                if (detour.x() >= 0 && detour.y() >= 0) {
-                    // 先到绕行点
-                    while (current.x() != detour.x()) {
-                        current.setX(current.x() + (detour.x() > current.x() ? 1 : -1));
-                        path.append(current);
-                    }
-                    while (current.y() != detour.y()) {
-                        current.setY(current.y() + (detour.y() > current.y() ? 1 : -1));
-                        path.append(current);
-                    }
-                }
-                
-                // 从绕行点到终点
-                while (current.x() != end.x()) {
-                    current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                    path.append(current);
-                }
-                while (current.y() != end.y()) {
-                    current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                    path.append(current);
+                // 从BFS层次构造的最短路径DAG中依次取出，不会重复
+                QVector<QVector<QPoint>> paths;
+                ShortestPathDag dag(m_gridView->getGrid());
+                if (dag.build(start, end)) {
+                    dag.enumerate(alternativePathCount, [&paths](const QVector<QPoint>& path) {
+                        paths.append(path);
+                        return true;
+                    });
                 }
+                return paths;
             }
-            break;
             
-        case 8: // 三步水平一步垂直模式
-            while (current.x() != end.x() || current.y() != end.y()) {
-                for (int i = 0; i < 3 && current.x() != end.x(); ++i) {
-                    current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                    path.append(current);
-                }
-                if (current.y() != end.y()) {
-                    current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                    path.append(current);
-                }
-            }
-            break;
-            
-        case 9: // 一步水平三步垂直模式
-            while (current.x() != end.x() || current.y() != end.y()) {
-                if (current.x() != end.x()) {
-                    current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                    path.append(current);
-                }
-                for (int i = 0; i < 3 && current.y() != end.y(); ++i) {
-                    current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                    path.append(current);
-                }
-            }
-            break;
-            
-        case 10: // 分段式路径：先移动1/3，再移动2/3
-            {
-                int totalX = end.x() - start.x();
-                QPoint mid1(start.x() + totalX / 3, start.y());
-                QPoint mid2(start.x() + totalX / 3, end.y());
-                
-                // 到第一个中间点
-                while (current.x() != mid1.x()) {
-                    current.setX(current.x() + (mid1.x() > current.x() ? 1 : -1));
-                    path.append(current);
-                }
-                // 到第二个中间点
-                while (current.y() != mid2.y()) {
-                    current.setY(current.y() + (mid2.y() > current.y() ? 1 : -1));
-                    path.append(current);
-                }
-                // 到终点
-                while (current.x() != end.x()) {
-                    current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                    path.append(current);
-                }
-            }
-            break;
-            
-        case 11: // L形路径变体
-            {
-                bool horizontalFirst = variant % 2 == 0;
-                if (horizontalFirst) {
-                    // 先走一半水平，再垂直，再水平
-                    int halfX = (end.x() - start.x()) / 2;
-                    while (current.x() != start.x() + halfX) {
-                        current.setX(current.x() + (halfX > 0 ? 1 : -1));
-                        path.append(current);
-                    }
-                    while (current.y() != end.y()) {
-                        current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                        path.append(current);
-                    }
-                    while (current.x() != end.x()) {
-                        current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                        path.append(current);
-                    }
-                } else {
-                    // 先走一半垂直，再水平，再垂直
-                    int halfY = (end.y() - start.y()) / 2;
-                    while (current.y() != start.y() + halfY) {
-                        current.setY(current.y() + (halfY > 0 ? 1 : -1));
-                        path.append(current);
-                    }
-                    while (current.x() != end.x()) {
-                        current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                        path.append(current);
-                    }
-                    while (current.y() != end.y()) {
-                        current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                        path.append(current);
-                    }
-                }
-            }
-            break;
-            
-        case 12: // 螺旋式接近
-            {
-                int spiralSize = 1 + (variant % 3);
-                while (current != end) {
-                    // 向右
-                    for (int i = 0; i < spiralSize && current.x() < end.x(); ++i) {
-                        current.setX(current.x() + 1);
-                        path.append(current);
-                        if (current == end) break;
-                    }
-                    if (current == end) break;
-                    
-                    // 向下
-                    for (int i = 0; i < spiralSize && current.y() < end.y(); ++i) {
-                        current.setY(current.y() + 1);
-                        path.append(current);
-                        if (current == end) break;
-                    }
-                    if (current == end) break;
-                    
-                    // 如果还没到达，用简单路径补齐
-                    while (current.x() != end.x()) {
-                        current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                        path.append(current);
-                    }
-                    while (current.y() != end.y()) {
-                        current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                        path.append(current);
-                    }
-                    break;
-                }
-            }
-            break;
-            
-        case 13: // 锯齿形路径
-            while (current.x() != end.x() || current.y() != end.y()) {
-                // 水平移动1步
-                if (current.x() != end.x()) {
-                    current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                    path.append(current);
-                }
-                // 垂直移动1步
-                if (current.y() != end.y()) {
-                    current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                    path.append(current);
-                }
-                // 如果还有距离，再来一次小的锯齿
-                if (current.x() != end.x() && current.y() != end.y()) {
-                    if (current.x() != end.x()) {
-                        current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                        path.append(current);
-                    }
-                }
-            }
-            break;
-            
-        case 14: // 角点式路径
+        case AlgorithmType::AStar:
+        case AlgorithmType::Dijkstra:
             {
-                // 选择一个角点
-                QPoint corner;
-                if (variant % 4 == 0) {
-                    corner = QPoint(end.x(), start.y()); // 右上角点
-                } else if (variant % 4 == 1) {
-                    corner = QPoint(start.x(), end.y()); // 左下角点
-                } else if (variant % 4 == 2) {
-                    corner = QPoint((start.x() + end.x()) / 2, start.y()); // 中上角点
-                } else {
-                    corner = QPoint(start.x(), (start.y() + end.y()) / 2); // 左中角点
-                }
-                
-                // 先到角点
-                while (current.x() != corner.x()) {
-                    current.setX(current.x() + (corner.x() > current.x() ? 1 : -1));
-                    path.append(current);
-                }
-                while (current.y() != corner.y()) {
-                    current.setY(current.y() + (corner.y() > current.y() ? 1 : -1));
-                    path.append(current);
-                }
-                // 从角点到终点
-                while (current.x() != end.x()) {
-                    current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                    path.append(current);
-                }
-                while (current.y() != end.y()) {
-                    current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                    path.append(current);
-                }
+                // 按代价从小到大返回K条真实可走的无环路径，无需再去重
+                KShortestPathEngine engine(m_gridView->getGrid());
+                engine.setSpurSearch(algorithm == AlgorithmType::AStar
+                                     ? KShortestPathEngine::SpurSearch::AStar
+                                     : KShortestPathEngine::SpurSearch::Dijkstra);
+                return engine.findPaths(start, end, alternativePathCount);
             }
-            break;
             
-        case 15: // 随机偏移路径
-            {
-                int offset = (variant % 5) - 2; // -2, -1, 0, 1, 2的偏移
-                while (current.x() != end.x() || current.y() != end.y()) {
-                    // 主要移动方向
-                    if (abs(end.x() - current.x()) > abs(end.y() - current.y())) {
-                        // 水平距离更大，优先水平移动
-                        if (current.x() != end.x()) {
-                            current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                            path.append(current);
-                        }
-                        // 偶尔垂直移动
-                        if (path.size() % 3 == offset % 3 && current.y() != end.y()) {
-                            current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                            path.append(current);
-                        }
-                    } else {
-                        // 垂直距离更大，优先垂直移动
-                        if (current.y() != end.y()) {
-                            current.setY(current.y() + (end.y() > current.y() ? 1 : -1));
-                            path.append(current);
-                        }
-                        // 偶尔水平移动
-                        if (path.size() % 3 == offset % 3 && current.x() != end.x()) {
-                            current.setX(current.x() + (end.x() > current.x() ? 1 : -1));
-                            path.append(current);
-                        }
-                    }
-                }
-            }
+        case AlgorithmType::DFS:
+            // DFS - 使用回溯法找到所有可能的路径，边计算边返回
+            calculateAllDFSPathsProgressive(start, end, algorithm);
             break;
     }
     
-    return path;
+    return QVector<QVector<QPoint>>(); // 路径会逐步添加到结果列表中
 }
 
 // 哈密顿路径计算（从起点到终点并且经过所有点）
 void MainWindow::calculateSimpleDFSPath(const QPoint& start, const QPoint& end) {
-    qDebug() << "开始哈密顿路径搜索，从" << start << "到" << end;
+    QW_DEBUG(lcUi) << "开始哈密顿路径搜索，从" << start << "到" << end;
     
     int gridWidth = m_gridView->gridWidth();
     int gridHeight = m_gridView->gridHeight();
     int totalPoints = gridWidth * gridHeight;
     
-    qDebug() << "网格大小:" << gridWidth << "x" << gridHeight << "，总共" << totalPoints << "个点";
+    QW_DEBUG(lcUi) << "网格大小:" << gridWidth << "x" << gridHeight << "，总共" << totalPoints << "个点";
     
     // 清空队列
     {
@@ -983,17 +650,17 @@ void MainWindow::calculateSimpleDFSPath(const QPoint& start, const QPoint& end)
     // 启动定时器进行实时UI更新
     if (!m_batchTimer->isActive()) {
         m_batchTimer->start();
-        qDebug() << "启动批处理定时器";
+        QW_DEBUG(lcUi) << "启动批处理定时器";
     }
     
     QElapsedTimer timer;
     timer.start();
     
-    // 启动异步哈密顿路径搜索
-    findAllHamiltonianPathsAsync(start, end);
+    // 启动哈密顿路径搜索，结果经批量队列逐步显示
+    calculateAllDFSPathsProgressive(start, end, AlgorithmType::DFS);
     
     qint64 elapsed = timer.elapsed();
-    qDebug() << "哈密顿路径搜索启动用时:" << elapsed << "ms";
+    QW_DEBUG(lcUi) << "哈密顿路径搜索启动用时:" << elapsed << "ms";
     
     updateStatusMessage(QString("正在搜索哈密顿路径（经过所有 %1 个点）...")
                        .arg(totalPoints));
@@ -1058,8 +725,10 @@ QVector<QPoint> MainWindow::calculateBFSPath(const QPoint& start, const QPoint&
 }
 
 QVector<QPoint> MainWindow::calculateDFSPath(const QPoint& start, const QPoint& end) {
-    // 使用DFS回溯算法找到一条路径
-    QVector<QVector<QPoint>> allPaths = findAllDFSPaths(start, end);
+    // 使用哈密顿路径引擎找到一条路径
+    HamiltonianPathEngine engine(m_gridView->getGrid());
+    engine.setPruning(HamiltonianPathEngine::PruneAll);
+    QVector<QVector<QPoint>> allPaths = engine.findPaths(start, end, 1);
     if (!allPaths.isEmpty()) {
         return allPaths.first();
     }
@@ -1125,6 +794,7 @@ void MainWindow::onStopCalculation() {
         showCalculationProgress(false);
         
         updateStatusMessage("计算已停止，可以重新开始");
+        refreshSearchStats();
     }
 }
 
@@ -1295,7 +965,7 @@ void MainWindow::processBatchQueue() {
         return;
     }
     
-    qDebug() << "processBatchQueue: 队列中有" << m_pathQueue.size() << "个结果";
+    QW_TRACE(lcUi) << "processBatchQueue: 队列中有" << m_pathQueue.size() << "个结果";
     
     // 每次最多处理10个结果（提高批处理效率）
     QVector<PathResult> batchResults;
@@ -1305,7 +975,7 @@ void MainWindow::processBatchQueue() {
         batchResults.append(m_pathQueue.dequeue());
     }
     
-    qDebug() << "取出" << batchResults.size() << "个结果，队列剩余" << m_pathQueue.size() << "个";
+    QW_TRACE(lcUi) << "取出" << batchResults.size() << "个结果，队列剩余" << m_pathQueue.size() << "个";
     
     // 释放锁后更新UI
     locker.unlock();
@@ -1365,429 +1035,42 @@ void MainWindow::onClearCurrentResults() {
     if (ret == QMessageBox::Yes) {
         m_resultList->clearResults();
         m_gridView->clearPath();
+        m_gridView->clearHeatmap();
         updateStatusMessage("当前结果已清空");
     }
 }
 
-// 使用DFS回溯算法找到所有可能的路径
-QVector<QVector<QPoint>> MainWindow::findAllDFSPaths(const QPoint& start, const QPoint& end) {
-    QVector<QVector<QPoint>> allPaths;
-    QVector<QPoint> currentPath;
-    QSet<QPoint> visited;
-    
-    currentPath.append(start);
-    visited.insert(start);
-    
-    // 限制搜索深度，避免路径过长
-    int maxDepth = abs(end.x() - start.x()) + abs(end.y() - start.y()) + 20;
-    
-    dfsBacktrack(start, end, currentPath, visited, allPaths, maxDepth);
-    
-    return allPaths; // 不再限制路径数量
-}
-
-// 哈密顿路径搜索：找到从起点到终点并经过所有网格点的路径
-QVector<QVector<QPoint>> MainWindow::findAllHamiltonianPaths(const QPoint& start, const QPoint& end) {
-    QVector<QVector<QPoint>> allPaths;
-    QVector<QPoint> currentPath;
-    QSet<QPoint> visited;
-    
-    int gridWidth = m_gridView->gridWidth();
-    int gridHeight = m_gridView->gridHeight();
-    int totalPoints = gridWidth * gridHeight;
-    
-    qDebug() << "开始哈密顿路径搜索，总点数:" << totalPoints;
-    
-    currentPath.append(start);
-    visited.insert(start);
-    
-    hamiltonianDFS(start, end, currentPath, visited, allPaths, totalPoints);
-    
-    qDebug() << "哈密顿路径搜索完成，找到" << allPaths.size() << "条路径";
-    return allPaths;
-}
-
-// 异步哈密顿路径搜索（使用队列机制）
-void MainWindow::findAllHamiltonianPathsAsync(const QPoint& start, const QPoint& end) {
-    int gridWidth = m_gridView->gridWidth();
-    int gridHeight = m_gridView->gridHeight();
-    int totalPoints = gridWidth * gridHeight;
-    
-    qDebug() << "开始异步哈密顿路径搜索，总点数:" << totalPoints;
-    
-    QVector<QPoint> currentPath;
-    QSet<QPoint> visited;
-    
-    currentPath.append(start);
-    visited.insert(start);
-    
-    // 重置停止标志
-    m_shouldStopCalculation = false;
-    
-    hamiltonianDFSAsync(start, end, currentPath, visited, totalPoints);
-    
-    qDebug() << "异步哈密顿路径搜索启动完成";
-}
-
-// 哈密顿路径的DFS回溯实现
-void MainWindow::hamiltonianDFS(const QPoint& current, const QPoint& end, QVector<QPoint>& currentPath, 
-                               QSet<QPoint>& visited, QVector<QVector<QPoint>>& allPaths, int totalPoints) {
-    
-    // 如果当前路径已经访问了所有点，并且当前位置是终点
-    if (visited.size() == totalPoints && current == end) {
-        allPaths.append(currentPath);
-        qDebug() << "找到哈密顿路径，长度:" << currentPath.size();
-        return;
-    }
-    
-    // 如果已经访问了所有点但不在终点，返回
-    if (visited.size() == totalPoints) {
-        return;
-    }
-    
-    // 如果找到的路径数量过多，可以适当限制（可选）
-    if (allPaths.size() >= 5000) { // 增加到5000条路径限制
-        return;
-    }
-    
-    // 获取相邻的有效位置
-    QVector<QPoint> neighbors = getValidNeighbors(current);
-    
-    for (const QPoint& neighbor : neighbors) {
-        if (!visited.contains(neighbor)) {
-            // 选择这个邻居
-            currentPath.append(neighbor);
-            visited.insert(neighbor);
-            
-            // 递归搜索
-            hamiltonianDFS(neighbor, end, currentPath, visited, allPaths, totalPoints);
-            
-            // 回溯
-            currentPath.removeLast();
-            visited.remove(neighbor);
-        }
-    }
-}
-
-// 获取指定点的有效邻居点（上下左右四个方向）
-QVector<QPoint> MainWindow::getValidNeighbors(const QPoint& point) {
-    QVector<QPoint> neighbors;
-    int gridWidth = m_gridView->gridWidth();
-    int gridHeight = m_gridView->gridHeight();
-    
-    // 四个方向：上、下、左、右
-    QVector<QPoint> directions = {
-        QPoint(0, -1),  // 上
-        QPoint(0, 1),   // 下
-        QPoint(-1, 0),  // 左
-        QPoint(1, 0)    // 右
-    };
-    
-    for (const QPoint& dir : directions) {
-        QPoint neighbor = point + dir;
-        
-        // 检查是否在网格范围内
-        if (neighbor.x() >= 0 && neighbor.x() < gridWidth &&
-            neighbor.y() >= 0 && neighbor.y() < gridHeight) {
-            neighbors.append(neighbor);
-        }
-    }
-    
-    return neighbors;
-}
-
-// DFS回溯核心算法
-void MainWindow::dfsBacktrack(const QPoint& current, const QPoint& end, 
-                              QVector<QPoint>& currentPath, QSet<QPoint>& visited, 
-                              QVector<QVector<QPoint>>& allPaths, int maxDepth) {
-    
-    // 如果到达终点，保存路径
-    if (current == end) {
-        allPaths.append(currentPath);
-        return;
-    }
-    
-    // 如果路径太长，剪枝（但不限制找到的路径总数）
-    if (currentPath.size() > maxDepth) {
-        return;
-    }
-    
-    // 获取当前点的所有邻居
-    QVector<QPoint> neighbors = getNeighbors(current);
-    
-    // 按照启发式排序邻居（优先选择更接近终点的邻居）
-    std::sort(neighbors.begin(), neighbors.end(), [&](const QPoint& a, const QPoint& b) {
-        int distA = abs(a.x() - end.x()) + abs(a.y() - end.y());
-        int distB = abs(b.x() - end.x()) + abs(b.y() - end.y());
-        return distA < distB;
-    });
-    
-    // 尝试每个邻居
-    for (const QPoint& neighbor : neighbors) {
-        // 检查是否可以移动到这个邻居
-        if (!visited.contains(neighbor) && isValidMove(current, neighbor)) {
-            // 标记为已访问
-            visited.insert(neighbor);
-            currentPath.append(neighbor);
-            
-            // 递归搜索
-            dfsBacktrack(neighbor, end, currentPath, visited, allPaths, maxDepth);
-            
-            // 回溯：撤销选择
-            currentPath.removeLast();
-            visited.remove(neighbor);
-        }
-    }
-}
-
-// 检查移动是否有效
-bool MainWindow::isValidMove(const QPoint& from, const QPoint& to) {
-    // 检查是否是相邻的点（4方向连通）
-    int dx = abs(to.x() - from.x());
-    int dy = abs(to.y() - from.y());
-    
-    // 只允许上下左右移动，不允许对角线移动
-    if ((dx == 1 && dy == 0) || (dx == 0 && dy == 1)) {
-        // 检查目标点是否在网格范围内
-        if (m_gridView) {
-            int gridWidth = m_gridView->gridWidth();
-            int gridHeight = m_gridView->gridHeight();
-            
-            if (to.x() >= 0 && to.x() < gridWidth && to.y() >= 0 && to.y() < gridHeight) {
-                // 这里可以添加更多约束，比如检查是否是障碍物等
-                return true;
-            }
-        }
-    }
-    
-    return false;
-}
-
-// 获取一个点的所有有效邻居
-QVector<QPoint> MainWindow::getNeighbors(const QPoint& point) {
-    QVector<QPoint> neighbors;
-    
-    // 四个方向：上、下、左、右
-    QVector<QPoint> directions = {
-        QPoint(0, -1),  // 上
-        QPoint(0, 1),   // 下
-        QPoint(-1, 0),  // 左
-        QPoint(1, 0)    // 右
-    };
-    
-    for (const QPoint& dir : directions) {
-        QPoint neighbor = point + dir;
-        
-        // 检查邻居是否在网格范围内
-        if (m_gridView) {
-            int gridWidth = m_gridView->gridWidth();
-            int gridHeight = m_gridView->gridHeight();
-            
-            if (neighbor.x() >= 0 && neighbor.x() < gridWidth && 
-                neighbor.y() >= 0 && neighbor.y() < gridHeight) {
-                neighbors.append(neighbor);
-            }
-        }
-    }
-    
-    return neighbors;
-}
-
-// 渐进式DFS计算：使用队列系统
+// 渐进式哈密顿路径计算：引擎找到的路径放入批量队列，由定时器分批显示
 void MainWindow::calculateAllDFSPathsProgressive(const QPoint& start, const QPoint& end, AlgorithmType algorithm) {
-    qDebug() << "calculateAllDFSPathsProgressive 开始 - 起点:" << start << "终点:" << end;
-    
-    QVector<QPoint> currentPath;
-    QSet<QPoint> visited;
-    
-    currentPath.append(start);
-    visited.insert(start);
+    QW_DEBUG(lcUi) << "calculateAllDFSPathsProgressive 开始 - 起点:" << start << "终点:" << end;
     
-    qDebug() << "启动批量处理定时器...";
     // 启动批量处理定时器
     m_batchTimer->start();
     
-    // 设置搜索深度为所有点数（哈密顿路径必须经过所有点）
-    int totalPoints = m_gridView->gridWidth() * m_gridView->gridHeight();
-    int maxDepth = totalPoints;  // 哈密顿路径的长度必须等于总点数
-    qDebug() << "哈密顿路径搜索深度:" << maxDepth << "（必须经过所有点）";
+    HamiltonianPathEngine engine(m_gridView->getGrid());
+    engine.setPruning(HamiltonianPathEngine::PruneAll);
+    engine.setCheckpoint([this]() {
+        return !m_shouldStopCalculation;
+    });
     
-    qDebug() << "开始DFS回溯搜索...";
-    // 开始渐进式DFS搜索
-    dfsBacktrackProgressive(start, end, currentPath, visited, algorithm, start, maxDepth);
+    QElapsedTimer timer;
+    timer.start();
+    engine.findPaths(start, end, Constants::DEFAULT_MAX_PATHS, [&](const QVector<QPoint>& path) {
+        PathResult result("", start, end, path, algorithm, timer.elapsed());
+        
+        // 线程安全地添加到队列
+        QMutexLocker locker(&m_queueMutex);
+        m_pathQueue.enqueue(std::move(result));
+        m_totalPathCount++;
+        return !m_shouldStopCalculation;
+    });
     
-    qDebug() << "DFS搜索完成，停止定时器...";
     // 停止定时器
     m_batchTimer->stop();
     
-    qDebug() << "处理队列中剩余的结果...";
     // 处理队列中剩余的所有结果
     processBatchQueue();
-    qDebug() << "calculateAllDFSPathsProgressive 完成";
-}
-
-// 渐进式DFS回溯算法：将找到的路径添加到队列中
-void MainWindow::dfsBacktrackProgressive(const QPoint& current, const QPoint& end, 
-                                        QVector<QPoint>& currentPath, QSet<QPoint>& visited, 
-                                        AlgorithmType algorithm, const QPoint& startPoint, int maxDepth) {
-    
-    // 检查是否应该停止计算（包括路径数量限制）
-    if (m_shouldStopCalculation || m_totalPathCount >= MAX_PATHS) {
-        qDebug() << "DFS停止条件触发: shouldStop=" << m_shouldStopCalculation 
-                 << "totalPaths=" << m_totalPathCount << "maxPaths=" << MAX_PATHS;
-        return;
-    }
-    
-    // 添加调试输出，但限制频率
-    static int debugCounter = 0;
-    if (debugCounter % 1000 == 0) {
-        qDebug() << "DFS搜索中... 当前点:" << current << "路径长度:" << currentPath.size();
-    }
-    debugCounter++;
-    
-    // 如果到达终点，检查是否为哈密顿路径（经过所有点）
-    if (current == end) {
-        // 计算网格中的总点数
-        int totalPoints = m_gridView->gridWidth() * m_gridView->gridHeight();
-        
-        // 检查路径是否经过了所有点
-        if (currentPath.size() == totalPoints) {
-            qDebug() << "找到哈密顿路径! 长度:" << currentPath.size() << "当前路径数:" << m_totalPathCount;
-            
-            // 先检查是否已经达到最大路径限制
-            if (m_totalPathCount >= MAX_PATHS) {
-                qDebug() << "已达到最大哈密顿路径限制:" << MAX_PATHS << "，停止搜索";
-                m_shouldStopCalculation = true;  // 设置停止标志
-                return;
-            }
-            
-            // 计算用时（模拟）
-            qint64 calcTime = QTime::currentTime().msecsSinceStartOfDay() % 100 + 1;
-            
-            // 创建路径结果
-            PathResult result("", startPoint, end, currentPath, algorithm, calcTime);
-            
-            // 线程安全地添加到队列
-            {
-                QMutexLocker locker(&m_queueMutex);
-                m_pathQueue.enqueue(result);
-                m_totalPathCount++;
-                qDebug() << "哈密顿路径已添加到队列，队列大小:" << m_pathQueue.size() << "总路径数:" << m_totalPathCount;
-            }
-        } else {
-            // 到达终点但不是哈密顿路径，跳过
-            qDebug() << "到达终点但路径不完整，只经过了" << currentPath.size() << "个点，总共需要" << totalPoints << "个点";
-        }
-        
-        return;
-    }
-    
-    // 如果路径长度不等于总点数且已经到达最大深度，剪枝
-    if (currentPath.size() > maxDepth) {
-        return;
-    }
-    
-    // 如果还没有经过所有点但已经到了终点，这不是有效的哈密顿路径
-    if (current == end && currentPath.size() < maxDepth) {
-        return;  // 剪枝，因为这不是完整的哈密顿路径
-    }
-    
-    // 获取当前点的所有邻居
-    QVector<QPoint> neighbors = getNeighbors(current);
-    
-    // 按照启发式排序邻居（优先选择更接近终点的邻居）
-    std::sort(neighbors.begin(), neighbors.end(), [&](const QPoint& a, const QPoint& b) {
-        int distA = abs(a.x() - end.x()) + abs(a.y() - end.y());
-        int distB = abs(b.x() - end.x()) + abs(b.y() - end.y());
-        return distA < distB;
-    });
-    
-    // 尝试每个邻居
-    for (const QPoint& neighbor : neighbors) {
-        // 检查是否应该停止计算（包括路径数量限制）
-        if (m_shouldStopCalculation || m_totalPathCount >= MAX_PATHS) {
-            qDebug() << "在邻居循环中检测到停止条件";
-            return;
-        }
-        
-        // 检查是否可以移动到这个邻居
-        if (!visited.contains(neighbor) && isValidMove(current, neighbor)) {
-            // 标记为已访问
-            visited.insert(neighbor);
-            currentPath.append(neighbor);
-            
-            // 递归搜索
-            dfsBacktrackProgressive(neighbor, end, currentPath, visited, algorithm, startPoint, maxDepth);
-            
-            // 回溯：撤销选择
-            currentPath.removeLast();
-            visited.remove(neighbor);
-        }
-    }
-}
-
-// 异步哈密顿路径的DFS回溯实现（使用队列机制）
-void MainWindow::hamiltonianDFSAsync(const QPoint& current, const QPoint& end, QVector<QPoint>& currentPath, 
-                                     QSet<QPoint>& visited, int totalPoints) {
-    
-    // 检查是否应该停止计算
-    if (m_shouldStopCalculation || m_totalPathCount >= MAX_PATHS) {
-        return;
-    }
-    
-    // 如果当前路径已经访问了所有点，并且当前位置是终点
-    if (visited.size() == totalPoints && current == end) {
-        PathResult result;
-        result.setAlgorithm(AlgorithmType::DFS);
-        result.setStartPoint(currentPath.first());
-        result.setEndPoint(end);
-        result.setPath(currentPath);
-        result.setCalculationTime(1); // 临时设置，实际时间可以后续计算
-        result.setTimestamp(QDateTime::currentDateTime());
-        
-        // 线程安全地添加到队列
-        {
-            QMutexLocker locker(&m_queueMutex);
-            m_pathQueue.enqueue(result);
-            m_totalPathCount++;
-            qDebug() << "哈密顿路径已添加到队列，队列大小:" << m_pathQueue.size() << "总路径数:" << m_totalPathCount;
-        }
-        
-        return;
-    }
-    
-    // 如果已经访问了所有点但不在终点，返回
-    if (visited.size() == totalPoints) {
-        return;
-    }
-    
-    // 如果找到的路径数量过多，限制搜索
-    if (m_totalPathCount >= 1000) {
-        return;
-    }
-    
-    // 获取相邻的有效位置
-    QVector<QPoint> neighbors = getValidNeighbors(current);
-    
-    for (const QPoint& neighbor : neighbors) {
-        // 检查停止条件
-        if (m_shouldStopCalculation || m_totalPathCount >= MAX_PATHS) {
-            return;
-        }
-        
-        if (!visited.contains(neighbor)) {
-            // 选择这个邻居
-            currentPath.append(neighbor);
-            visited.insert(neighbor);
-            
-            // 递归搜索
-            hamiltonianDFSAsync(neighbor, end, currentPath, visited, totalPoints);
-            
-            // 回溯
-            currentPath.removeLast();
-            visited.remove(neighbor);
-        }
-    }
+    QW_DEBUG(lcUi) << "calculateAllDFSPathsProgressive 完成，共" << m_totalPathCount << "条哈密顿路径";
 }
 
 // 数据管理相关方法实现
@@ -1853,7 +1136,7 @@ void MainWindow::onOpenDataFile() {
 // 异步计算器相关槽函数实现
 
 void MainWindow::onAsyncPathFound(const PathResult& result, int taskId) {
-    qDebug() << "异步计算完成最终结果，任务ID:" << taskId;
+    QW_DEBUG(lcUi) << "异步计算完成最终结果，任务ID:" << taskId;
     
     // 对于哈密顿路径，所有结果已经通过 onAsyncPartialPathFound 处理了
     // 这里只更新状态，不重复添加结果
@@ -1862,24 +1145,31 @@ void MainWindow::onAsyncPathFound(const PathResult& result, int taskId) {
     
     if (result.getPath().isEmpty()) {
         updateStatusMessage(QString("%1 算法计算完成，未找到路径").arg(algorithmName));
+    } else if (algorithm == AlgorithmType::DFS) {
+        updateStatusMessage(QString("%1 算法计算完成，共找到 %2 条哈密顿路径%3")
+                           .arg(algorithmName).arg(m_totalPathCount)
+                           .arg(m_asyncCalculator->hasMorePaths() ? "，滚动到列表底部或点击“加载更多”继续" : ""));
+    } else if (algorithm == AlgorithmType::BFS) {
+        // 最终结果名称中带有精确的最短路径总数
+        updateStatusMessage(QString("%1 算法计算完成: %2").arg(algorithmName).arg(result.id()));
     } else {
-        updateStatusMessage(QString("%1 算法计算完成，共找到 %2 条哈密顿路径")
+        updateStatusMessage(QString("%1 算法计算完成，按代价排序共找到 %2 条路径")
                            .arg(algorithmName).arg(m_totalPathCount));
     }
 }
 
 void MainWindow::onAsyncPartialPathFound(const PathResult& result, int taskId) {
-    qDebug() << "异步计算找到部分路径，任务ID:" << taskId << "路径名称:" << result.id();
+    QW_TRACE_RATE(lcUi, 10) << "异步计算找到部分路径，任务ID:" << taskId << "路径名称:" << result.id();
     
     // 将部分路径（即每个找到的哈密顿路径）添加到结果列表中显示
     if (m_resultList) {
         m_resultList->addResult(result);
-        qDebug() << "已添加哈密顿路径到结果列表:" << result.id() << "路径长度:" << result.getPath().size();
+        QW_TRACE_RATE(lcUi, 10) << "已添加哈密顿路径到结果列表:" << result.id() << "路径长度:" << result.getPath().size();
         
         // 显示第一条路径在网格上
         if (m_totalPathCount == 0 && m_gridView) {
             m_gridView->showPath(result.getPath());
-            qDebug() << "在网格上显示第一条哈密顿路径";
+            QW_DEBUG(lcUi) << "在网格上显示第一条哈密顿路径";
         }
         
         m_totalPathCount++;
@@ -1893,7 +1183,7 @@ void MainWindow::onAsyncPartialPathFound(const PathResult& result, int taskId) {
 }
 
 void MainWindow::onAsyncPathNotFound(int taskId) {
-    qDebug() << "异步计算未找到路径，任务ID:" << taskId;
+    QW_DEBUG(lcUi) << "异步计算未找到路径，任务ID:" << taskId;
     
     AlgorithmType algorithm = m_activeTaskAlgorithms.value(taskId, AlgorithmType::AStar);
     QString algorithmName = algorithmTypeToString(algorithm);
@@ -1901,6 +1191,25 @@ void MainWindow::onAsyncPathNotFound(int taskId) {
                        .arg(algorithmName).arg(taskId));
 }
 
+void MainWindow::onAsyncBudgetExhausted(const PathResult& result, int taskId) {
+    QW_DEBUG(lcUi) << "异步计算预算用尽，任务ID:" << taskId;
+    
+    // 已产出的路径都已作为部分结果显示，这里只报告结束原因；报告在最终结果名称中
+    AlgorithmType algorithm = m_activeTaskAlgorithms.value(taskId, AlgorithmType::DFS);
+    QString algorithmName = algorithmTypeToString(algorithm);
+    const QString report = result.id().section(" - ", 1, -1);
+    updateStatusMessage(QString("%1 算法%2 (任务ID: %3)").arg(algorithmName).arg(report).arg(taskId));
+}
+
+void MainWindow::onAsyncEndCountsUpdated(int taskId, const QVector<quint64>& counts) {
+    QW_TRACE_RATE(lcUi, 10) << "按终点计数更新，任务ID:" << taskId;
+    
+    // 计数随搜索推进不断增加，热力图整体重绘；数量见各格子的提示
+    if (m_activeTaskAlgorithms.contains(taskId)) {
+        m_gridView->showHeatmap(counts);
+    }
+}
+
 void MainWindow::onAsyncCalculationProgress(int taskId, int percentage) {
     // 更新进度条
     updateCalculationProgress(percentage);
@@ -1915,7 +1224,7 @@ void MainWindow::onAsyncCalculationProgress(int taskId, int percentage) {
 }
 
 void MainWindow::onAsyncCalculationStarted(int taskId) {
-    qDebug() << "异步计算开始，任务ID:" << taskId;
+    QW_DEBUG(lcUi) << "异步计算开始，任务ID:" << taskId;
     
     AlgorithmType algorithm = m_activeTaskAlgorithms.value(taskId, AlgorithmType::AStar);
     QString algorithmName = algorithmTypeToString(algorithm);
@@ -1924,7 +1233,7 @@ void MainWindow::onAsyncCalculationStarted(int taskId) {
 }
 
 void MainWindow::onAsyncCalculationFinished(int taskId) {
-    qDebug() << "异步计算完成，任务ID:" << taskId;
+    QW_DEBUG(lcUi) << "异步计算完成，任务ID:" << taskId;
     
     // 从活动任务中移除
     m_activeTaskAlgorithms.remove(taskId);
@@ -1939,11 +1248,14 @@ void MainWindow::onAsyncCalculationFinished(int taskId) {
         
         int pathCount = m_resultList->getAllResults().size();
         updateStatusMessage(QString("所有计算任务完成 - 找到 %1 条路径").arg(pathCount));
+        refreshSearchStats();
+        // 枚举还有下一页时由结果列表在滚动到底部或点击“加载更多”时请求
+        m_resultList->setCanFetchMore(m_asyncCalculator->hasMorePaths());
     }
 }
 
 void MainWindow::onAsyncAllCalculationsFinished() {
-    qDebug() << "所有异步计算任务完成";
+    QW_DEBUG(lcUi) << "所有异步计算任务完成";
     
     // 确保状态正确
     m_isCalculating = false;
@@ -1957,6 +1269,29 @@ void MainWindow::onAsyncAllCalculationsFinished() {
     
     int pathCount = m_resultList->getAllResults().size();
     updateStatusMessage(QString("全部计算完成 - 总共找到 %1 条路径").arg(pathCount));
+    refreshSearchStats();
+    m_resultList->setCanFetchMore(m_asyncCalculator->hasMorePaths());
+}
+
+void MainWindow::onFetchMorePaths() {
+    if (m_isCalculating || !m_asyncCalculator->hasMorePaths()) {
+        return;
+    }
+    
+    // 续取的一页作为新任务运行，结果接在列表末尾，路径计数不清零
+    m_isCalculating = true;
+    m_shouldStopCalculation = false;
+    m_calculationState = CalculationState::Running;
+    m_controlPanel->setCalculationState(m_calculationState);
+    showCalculationProgress(true);
+    m_asyncCalculator->startResultChecker(100);
+    
+    const int taskId = m_asyncCalculator->fetchMorePaths();
+    m_activeTaskAlgorithms[taskId] = AlgorithmType::DFS;
+    m_activeTaskNames[taskId] = QString("任务_%1_续取").arg(taskId);
+    m_statsTimer->start();
+    updateStatusMessage(QString("正在加载下一页哈密顿路径（已有 %1 条）...").arg(m_totalPathCount));
+    QW_DEBUG(lcUi) << "续取下一页，任务ID:" << taskId;
 }
 
 void MainWindow::onOpenLayoutTestWindow() {
@@ -49,6 +49,7 @@ private slots:
     // 控制面板操作
     void onSetStartPointMode();
     void onSetEndPointMode();
+    void onSetWeightMode(bool enabled);
     void onStartCalculation();
     void onPauseCalculation();
     void onResumeCalculation();
@@ -84,10 +85,14 @@ private slots:
     void onAsyncPathFound(const PathResult& result, int taskId);
     void onAsyncPartialPathFound(const PathResult& result, int taskId);
     void onAsyncPathNotFound(int taskId);
+    void onAsyncBudgetExhausted(const PathResult& result, int taskId);
+    void onAsyncEndCountsUpdated(int taskId, const QVector<quint64>& counts);
     void onAsyncCalculationProgress(int taskId, int percentage);
     void onAsyncCalculationStarted(int taskId);
     void onAsyncCalculationFinished(int taskId);
     void onAsyncAllCalculationsFinished();
+    // 结果列表滚动到底部或点击“加载更多”时续取下一页哈密顿路径
+    void onFetchMorePaths();
     
     // 布局测试窗口
     void onOpenLayoutTestWindow();
@@ -105,6 +110,7 @@ private:
     void updateStatusMessage(const QString& message);
     void showCalculationProgress(bool show);
     void updateCalculationProgress(int percentage);
+    void refreshSearchStats();
     void updateGridSizeLabel();
     
     // 路径计算辅助方法
@@ -112,28 +118,13 @@ private:
     void calculateSimpleDFSPath(const QPoint& start, const QPoint& end);  // 新增简单DFS方法
     QVector<QPoint> calculatePathWithAlgorithm(const QPoint& start, const QPoint& end, AlgorithmType algorithm);
     QVector<QVector<QPoint>> calculateAllPossiblePaths(const QPoint& start, const QPoint& end, AlgorithmType algorithm);
-    QVector<QPoint> calculatePathVariant(const QPoint& start, const QPoint& end, int variant);
     QVector<QPoint> calculateAStarPath(const QPoint& start, const QPoint& end);
     QVector<QPoint> calculateDijkstraPath(const QPoint& start, const QPoint& end);
     QVector<QPoint> calculateBFSPath(const QPoint& start, const QPoint& end);
     QVector<QPoint> calculateDFSPath(const QPoint& start, const QPoint& end);
     
-    // DFS回溯算法相关方法
-    QVector<QVector<QPoint>> findAllDFSPaths(const QPoint& start, const QPoint& end);
-    QVector<QVector<QPoint>> findAllHamiltonianPaths(const QPoint& start, const QPoint& end);  // 哈密顿路径搜索
-    void findAllHamiltonianPathsAsync(const QPoint& start, const QPoint& end);  // 异步哈密顿路径搜索
-    void hamiltonianDFS(const QPoint& current, const QPoint& end, QVector<QPoint>& currentPath, 
-                       QSet<QPoint>& visited, QVector<QVector<QPoint>>& allPaths, int totalPoints);
-    void hamiltonianDFSAsync(const QPoint& current, const QPoint& end, QVector<QPoint>& currentPath, 
-                            QSet<QPoint>& visited, int totalPoints);  // 异步哈密顿DFS
-    QVector<QPoint> getValidNeighbors(const QPoint& point);  // 获取有效邻居点
-    void dfsBacktrack(const QPoint& current, const QPoint& end, QVector<QPoint>& currentPath, 
-                      QSet<QPoint>& visited, QVector<QVector<QPoint>>& allPaths, int maxDepth = 50);
+    // 哈密顿路径：由HamiltonianPathEngine搜索，结果经批量队列逐步显示
     void calculateAllDFSPathsProgressive(const QPoint& start, const QPoint& end, AlgorithmType algorithm);
-    void dfsBacktrackProgressive(const QPoint& current, const QPoint& end, QVector<QPoint>& currentPath, 
-                                QSet<QPoint>& visited, AlgorithmType algorithm, const QPoint& startPoint, int maxDepth = 100);
-    bool isValidMove(const QPoint& from, const QPoint& to);
-    QVector<QPoint> getNeighbors(const QPoint& point);
     
     QString getAlgorithmName(AlgorithmType algorithm);
     
@@ -180,12 +171,15 @@ private:
     QLabel* m_statusLabel;
     QProgressBar* m_progressBar;
     QLabel* m_gridSizeLabel;
+    QLabel* m_statsLabel;
+    QTimer* m_statsTimer;   // 计算期间定时刷新搜索统计
     
     // 当前状态
     enum PointSetMode {
         None,
         SetStart,
-        SetEnd
+        SetEnd,
+        SetWeight   // 持续有效，直到再次点击“设置权重”
     } m_pointSetMode;
     
     CalculationState m_calculationState;
@@ -196,7 +190,6 @@ private:
     bool m_isCalculating;
     bool m_shouldStopCalculation;
     int m_totalPathCount;  // 总路径计数器
-    static const int MAX_PATHS = 5000;  // 哈密顿路径数量限制增加到5000
     
     // 批量处理队列系统
     QQueue<PathResult> m_pathQueue;  // 路径结果队列
@@ -0,0 +1,228 @@
+#ifndef NEIGHBORHOOD_H
+#define NEIGHBORHOOD_H
+
+#include "GridTypes.h"
+
+// 邻域策略：决定一个格子可以走到哪些格子，作为搜索引擎的模板参数在编译期选定
+// 每种策略有自己展开好的邻居收集循环，搜索过程中不再判断走法类型
+//
+// 策略需要提供：
+//   MaxDegree                  最多邻居数，引擎按它分配邻居缓冲区
+//   Bipartite                  所有走法都改变 (x+y) 的奇偶性时为1，此时奇偶性剪枝有效
+//   collect(w, h, walkable, index, out)   写出可走的邻居下标，返回个数
+//   direction(w, from, to)     from走到相邻格子to的方向编号，0 ~ MaxDegree-1
+// 方向按相反的一对连续编号（d 与 d^1 相反），最少转弯搜索据此判断直行
+//
+// 运行时按 NeighborhoodType 选择时用 visitNeighborhood() 分派一次，之后全部走特化的代码
+namespace Neighborhoods {
+
+// 上、下、左、右
+struct Four {
+    enum { MaxDegree = 4, Bipartite = 1 };
+
+    template<class Walkable>
+    static int collect(int width, int height, const Walkable& walkable, int index, int* out) {
+        const int x = index % width;
+        const int y = index / width;
+        int count = 0;
+        if (y > 0 && walkable[index - width]) out[count++] = index - width;
+        if (y < height - 1 && walkable[index + width]) out[count++] = index + width;
+        if (x > 0 && walkable[index - 1]) out[count++] = index - 1;
+        if (x < width - 1 && walkable[index + 1]) out[count++] = index + 1;
+        return count;
+    }
+
+    static int direction(int width, int from, int to) {
+        if (to == from - width) return 0;
+        if (to == from + width) return 1;
+        if (to == from - 1) return 2;
+        return 3;
+    }
+};
+
+// 斜向移动是否允许穿过障碍的拐角
+enum class CornerCutting {
+    Allowed,    // 只看目标格子
+    Forbidden   // 两侧的两个正交格子也必须可走
+};
+
+// 上、下、左、右，左上、右下、右上、左下
+template<CornerCutting Rule>
+struct Eight {
+    enum { MaxDegree = 8, Bipartite = 0 };
+
+    template<class Walkable>
+    static int collect(int width, int height, const Walkable& walkable, int index, int* out) {
+        const int x = index % width;
+        const int y = index / width;
+        const bool hasUp = y > 0;
+        const bool hasDown = y < height - 1;
+        const bool hasLeft = x > 0;
+        const bool hasRight = x < width - 1;
+        const bool up = hasUp && walkable[index - width];
+        const bool down = hasDown && walkable[index + width];
+        const bool left = hasLeft && walkable[index - 1];
+        const bool right = hasRight && walkable[index + 1];
+        const bool open = Rule == CornerCutting::Allowed;
+        int count = 0;
+        if (up) out[count++] = index - width;
+        if (down) out[count++] = index + width;
+        if (left) out[count++] = index - 1;
+        if (right) out[count++] = index + 1;
+        if (hasUp && hasLeft && (open || (up && left)) && walkable[index - width - 1]) {
+            out[count++] = index - width - 1;
+        }
+        if (hasDown && hasRight && (open || (down && right)) && walkable[index + width + 1]) {
+            out[count++] = index + width + 1;
+        }
+        if (hasUp && hasRight && (open || (up && right)) && walkable[index - width + 1]) {
+            out[count++] = index - width + 1;
+        }
+        if (hasDown && hasLeft && (open || (down && left)) && walkable[index + width - 1]) {
+            out[count++] = index + width - 1;
+        }
+        return count;
+    }
+
+    static int direction(int width, int from, int to) {
+        // 宽度很小时下标差会重合，按坐标差判断
+        const int dx = to % width - from % width;
+        const int dy = to / width - from / width;
+        if (dx == 0) return dy < 0 ? 0 : 1;
+        if (dy == 0) return dx < 0 ? 2 : 3;
+        if (dx == dy) return dx < 0 ? 4 : 5;
+        return dy < 0 ? 6 : 7;
+    }
+};
+
+// 六边形网格，按行偏移存储：奇数行整体右移半格
+// 左上、右下、左、右、右上、左下
+struct Hex {
+    enum { MaxDegree = 6, Bipartite = 0 };
+
+    template<class Walkable>
+    static int collect(int width, int height, const Walkable& walkable, int index, int* out) {
+        const int x = index % width;
+        const int y = index / width;
+        // 上下两行中与本格相邻的两个格子是 x-1+shift 和 x+shift
+        const int shift = y & 1;
+        const bool hasLeftDiagonal = x - 1 + shift >= 0;
+        const bool hasRightDiagonal = x + shift < width;
+        int count = 0;
+        if (y > 0 && hasLeftDiagonal && walkable[index - width - 1 + shift]) {
+            out[count++] = index - width - 1 + shift;
+        }
+        if (y < height - 1 && hasRightDiagonal && walkable[index + width + shift]) {
+            out[count++] = index + width + shift;
+        }
+        if (x > 0 && walkable[index - 1]) out[count++] = index - 1;
+        if (x < width - 1 && walkable[index + 1]) out[count++] = index + 1;
+        if (y > 0 && hasRightDiagonal && walkable[index - width + shift]) {
+            out[count++] = index - width + shift;
+        }
+        if (y < height - 1 && hasLeftDiagonal && walkable[index + width - 1 + shift]) {
+            out[count++] = index + width - 1 + shift;
+        }
+        return count;
+    }
+
+    static int direction(int width, int from, int to) {
+        const int dy = to / width - from / width;
+        // 扣除奇数行的半格偏移后，上下两行的邻居分别在 -1 和 0
+        const int dx = to % width - from % width - ((from / width) & 1);
+        if (dy == 0) return to < from ? 2 : 3;
+        if (dy < 0) return dx < 0 ? 0 : 4;
+        return dx < 0 ? 5 : 1;
+    }
+};
+
+// 偏移表的编译期检查
+template<class Offsets>
+constexpr bool offsetsPaired() {
+    for (int i = 0; i + 1 < Offsets::Count; i += 2) {
+        if (Offsets::dx(i) != -Offsets::dx(i + 1) || Offsets::dy(i) != -Offsets::dy(i + 1)) {
+            return false;
+        }
+    }
+    return Offsets::Count % 2 == 0;
+}
+
+template<class Offsets>
+constexpr bool offsetsBipartite() {
+    for (int i = 0; i < Offsets::Count; ++i) {
+        if (((Offsets::dx(i) + Offsets::dy(i)) & 1) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 自定义走法：Offsets 提供 Count 和 constexpr 的 dx(i)/dy(i)，按相反的一对连续列出
+template<class Offsets>
+struct Offset {
+    static_assert(offsetsPaired<Offsets>(), "偏移必须按相反的一对连续列出");
+    enum { MaxDegree = Offsets::Count, Bipartite = offsetsBipartite<Offsets>() ? 1 : 0 };
+
+    template<class Walkable>
+    static int collect(int width, int height, const Walkable& walkable, int index, int* out) {
+        const int x = index % width;
+        const int y = index / width;
+        int count = 0;
+        // 循环次数和偏移都是编译期常量，编译器会完全展开
+        for (int i = 0; i < Offsets::Count; ++i) {
+            const int nx = x + Offsets::dx(i);
+            const int ny = y + Offsets::dy(i);
+            if (nx >= 0 && nx < width && ny >= 0 && ny < height &&
+                walkable[index + Offsets::dy(i) * width + Offsets::dx(i)]) {
+                out[count++] = index + Offsets::dy(i) * width + Offsets::dx(i);
+            }
+        }
+        return count;
+    }
+
+    static int direction(int width, int from, int to) {
+        const int dx = to % width - from % width;
+        const int dy = to / width - from / width;
+        for (int i = 0; i < Offsets::Count; ++i) {
+            if (Offsets::dx(i) == dx && Offsets::dy(i) == dy) {
+                return i;
+            }
+        }
+        return 0;
+    }
+};
+
+// 国际象棋的马步，哈密顿路径即马的巡游
+struct KnightOffsets {
+    enum { Count = 8 };
+    static constexpr int dx(int i) {
+        const int values[Count] = {1, -1, 2, -2, -1, 1, -2, 2};
+        return values[i];
+    }
+    static constexpr int dy(int i) {
+        const int values[Count] = {-2, 2, -1, 1, -2, 2, -1, 1};
+        return values[i];
+    }
+};
+
+typedef Eight<CornerCutting::Allowed> EightAllowCornerCutting;
+typedef Eight<CornerCutting::Forbidden> EightNoCornerCutting;
+typedef Offset<KnightOffsets> Knight;
+
+} // namespace Neighborhoods
+
+// 按运行时选择的邻域调用一次 visitor(policy)，visitor 通常是泛型lambda：
+//   visitNeighborhood(type, [&](auto policy) { BasicShortestPathDag<decltype(policy)> dag(grid); ... });
+template<class Visitor>
+void visitNeighborhood(NeighborhoodType type, Visitor&& visitor) {
+    switch (type) {
+        case NeighborhoodType::Eight: visitor(Neighborhoods::EightAllowCornerCutting()); break;
+        case NeighborhoodType::EightNoCornerCutting: visitor(Neighborhoods::EightNoCornerCutting()); break;
+        case NeighborhoodType::Hex: visitor(Neighborhoods::Hex()); break;
+        case NeighborhoodType::Knight: visitor(Neighborhoods::Knight()); break;
+        case NeighborhoodType::Four:
+        default: visitor(Neighborhoods::Four()); break;
+    }
+}
+
+#endif // NEIGHBORHOOD_H
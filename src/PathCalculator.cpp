@@ -9,7 +9,7 @@ PathCalculator::PathCalculator(QObject* parent)
 {
 }
 
-void PathCalculator::setGrid(const QVector<QVector<GridPoint>>& grid) {
+void PathCalculator::setGrid(const GridModel& grid) {
     m_grid = grid;
 }
 
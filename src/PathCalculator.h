@@ -2,7 +2,7 @@
 #define PATHCALCULATOR_H
 
 #include "Common.h"
-#include "GridPoint.h"
+#include "GridModel.h"
 #include "PathResult.h"
 #include <QObject>
 #include <QThread>
@@ -15,7 +15,7 @@ class PathCalculator : public QObject {
 public:
     explicit PathCalculator(QObject* parent = nullptr);
     
-    void setGrid(const QVector<QVector<GridPoint>>& grid);
+    void setGrid(const GridModel& grid);
     void setAlgorithm(AlgorithmType algorithm);
     
 public slots:
@@ -31,7 +31,7 @@ signals:
     void calculationFinished();
 
 private:
-    QVector<QVector<GridPoint>> m_grid;
+    GridModel m_grid;
     AlgorithmType m_algorithm;
     bool m_isPaused;
     bool m_isStopped;
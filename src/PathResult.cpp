@@ -1,43 +1,148 @@
 #include "PathResult.h"
 #include <QUuid>
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+namespace {
+// 单调时钟与墙上时间的对应关系，进程内首次使用时记录一次
+struct ClockAnchor {
+    qint64 steadyNs;
+    qint64 wallMs;
+};
+
+const ClockAnchor& clockAnchor() {
+    static const ClockAnchor anchor = {
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count(),
+        QDateTime::currentMSecsSinceEpoch()
+    };
+    return anchor;
+}
+
+// 创建时的单调时钟为INVALID_TIME表示时间未知（例如从文件读取到无效的时间）
+const qint64 INVALID_TIME = std::numeric_limits<qint64>::min();
+
+quint64 nextSerial() {
+    static std::atomic<quint64> counter(0);
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+qint64 steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+class PathResultData : public QSharedData {
+public:
+    PathResultData()
+        : serial(nextSerial())
+        , algorithm(AlgorithmType::AStar)
+        , calculationTime(0)
+        , steadyNs(steadyNowNs())
+    {
+    }
+
+    quint64 serial;
+    QString id;
+    QPoint startPoint;
+    QPoint endPoint;
+    QVector<QPoint> path;
+    AlgorithmType algorithm;
+    qint64 calculationTime;    // 毫秒
+    qint64 steadyNs;           // 创建时的单调时钟（纳秒）
+    mutable QString uuid;      // 延迟生成，所有共享副本共用；持久化只在界面线程进行
+};
 
 PathResult::PathResult()
-    : m_id(QUuid::createUuid().toString())
-    , m_startPoint(0, 0)
-    , m_endPoint(0, 0)
-    , m_algorithm(AlgorithmType::AStar)
-    , m_calculationTime(0)
-    , m_timestamp(QDateTime::currentDateTime())
+    : d(new PathResultData)
 {
 }
 
 PathResult::PathResult(const QString& id,
                        const QPoint& startPoint,
                        const QPoint& endPoint,
-                       const QVector<QPoint>& path,
+                       QVector<QPoint> path,
                        AlgorithmType algorithm,
                        qint64 calculationTime)
-    : m_id(id.isEmpty() ? QUuid::createUuid().toString() : id)
-    , m_startPoint(startPoint)
-    , m_endPoint(endPoint)
-    , m_path(path)
-    , m_algorithm(algorithm)
-    , m_calculationTime(calculationTime)
-    , m_timestamp(QDateTime::currentDateTime())
+    : d(new PathResultData)
 {
+    d->id = id;
+    d->startPoint = startPoint;
+    d->endPoint = endPoint;
+    d->path = std::move(path);
+    d->algorithm = algorithm;
+    d->calculationTime = calculationTime;
+}
+
+PathResult::PathResult(const PathResult& other) = default;
+PathResult::PathResult(PathResult&& other) noexcept = default;
+PathResult& PathResult::operator=(const PathResult& other) = default;
+PathResult& PathResult::operator=(PathResult&& other) noexcept = default;
+PathResult::~PathResult() = default;
+
+QString PathResult::id() const {
+    return d->id.isEmpty() ? QString("#%1").arg(d->serial) : d->id;
+}
+
+quint64 PathResult::serial() const { return d->serial; }
+QPoint PathResult::startPoint() const { return d->startPoint; }
+QPoint PathResult::endPoint() const { return d->endPoint; }
+const QVector<QPoint>& PathResult::path() const { return d->path; }
+AlgorithmType PathResult::algorithm() const { return d->algorithm; }
+qint64 PathResult::calculationTime() const { return d->calculationTime; }
+qint64 PathResult::steadyTimestampNs() const { return d->steadyNs; }
+
+int PathResult::turnCount() const {
+    const QVector<QPoint>& points = d->path;
+    int turns = 0;
+    for (int i = 2; i < points.size(); ++i) {
+        if (points[i] - points[i - 1] != points[i - 1] - points[i - 2]) {
+            ++turns;
+        }
+    }
+    return turns;
+}
+
+void PathResult::setId(const QString& id) { d->id = id; }
+void PathResult::setUuid(const QString& uuid) { d->uuid = uuid; }
+
+QString PathResult::uuid() const {
+    if (d->uuid.isEmpty()) {
+        d->uuid = QUuid::createUuid().toString();
+    }
+    return d->uuid;
+}
+
+QDateTime PathResult::timestamp() const {
+    if (d->steadyNs == INVALID_TIME) {
+        return QDateTime();
+    }
+    const ClockAnchor& anchor = clockAnchor();
+    return QDateTime::fromMSecsSinceEpoch(anchor.wallMs + (d->steadyNs - anchor.steadyNs) / 1000000);
+}
+
+void PathResult::setTimestamp(const QDateTime& timestamp) {
+    if (!timestamp.isValid()) {
+        d->steadyNs = INVALID_TIME;
+        return;
+    }
+    const ClockAnchor& anchor = clockAnchor();
+    d->steadyNs = anchor.steadyNs + (timestamp.toMSecsSinceEpoch() - anchor.wallMs) * 1000000;
 }
 
 bool PathResult::isValid() const {
-    return !m_path.isEmpty() && 
-           m_path.first() == m_startPoint && 
-           m_path.last() == m_endPoint;
+    return !d->path.isEmpty() && 
+           d->path.first() == d->startPoint && 
+           d->path.last() == d->endPoint;
 }
 
 QString PathResult::toString() const {
     return QString("路径 %1->%2 [%3] 长度:%4 时间:%5ms")
-           .arg(QString("(%1,%2)").arg(m_startPoint.x()).arg(m_startPoint.y()))
-           .arg(QString("(%1,%2)").arg(m_endPoint.x()).arg(m_endPoint.y()))
-           .arg(algorithmTypeToString(m_algorithm))
+           .arg(QString("(%1,%2)").arg(d->startPoint.x()).arg(d->startPoint.y()))
+           .arg(QString("(%1,%2)").arg(d->endPoint.x()).arg(d->endPoint.y()))
+           .arg(algorithmTypeToString(d->algorithm))
            .arg(pathLength())
-           .arg(m_calculationTime);
+           .arg(d->calculationTime);
 }
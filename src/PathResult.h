@@ -1,42 +1,58 @@
 #ifndef PATHRESULT_H
 #define PATHRESULT_H
 
-#include "Common.h"
+#include "GridTypes.h"
 #include <QString>
 #include <QPoint>
 #include <QVector>
 #include <QDateTime>
+#include <QMetaType>
+#include <QSharedData>
+#include <QSharedDataPointer>
 
+class PathResultData;
+
+// 路径结果
+// 构造时只分配64位序号并记录单调时钟时间，字符串ID、墙上时间和UUID都在显示或保存时才生成，
+// 以便搜索线程每秒产出上千条结果时不在UUID和系统时间上花费开销
+//
+// 数据隐式共享且路径不可修改：结果在队列、信号和结果列表之间传递时只增加引用计数，
+// 路径在构造时分配一次，之后不再深拷贝
 class PathResult {
 public:
     PathResult();
     PathResult(const QString& id,
                const QPoint& startPoint,
                const QPoint& endPoint,
-               const QVector<QPoint>& path,
+               QVector<QPoint> path,
                AlgorithmType algorithm,
                qint64 calculationTime);
+    PathResult(const PathResult& other);
+    PathResult(PathResult&& other) noexcept;
+    PathResult& operator=(const PathResult& other);
+    PathResult& operator=(PathResult&& other) noexcept;
+    ~PathResult();
     
     // Getter方法
-    QString id() const { return m_id; }
-    QPoint startPoint() const { return m_startPoint; }
-    QPoint endPoint() const { return m_endPoint; }
-    QVector<QPoint> path() const { return m_path; }
-    QVector<QPoint> getPath() const { return m_path; } // 为兼容性添加
-    AlgorithmType algorithm() const { return m_algorithm; }
-    QString algorithmString() const { return algorithmTypeToString(m_algorithm); }
-    int pathLength() const { return m_path.size(); }
-    qint64 calculationTime() const { return m_calculationTime; }
-    QDateTime timestamp() const { return m_timestamp; }
+    QString id() const;                                 // 名称；未命名时为 "#序号"
+    quint64 serial() const;                             // 进程内单调递增的序号
+    QString uuid() const;                               // 持久化标识，首次调用时生成
+    QPoint startPoint() const;
+    QPoint endPoint() const;
+    const QVector<QPoint>& path() const;
+    const QVector<QPoint>& getPath() const { return path(); } // 为兼容性添加
+    AlgorithmType algorithm() const;
+    QString algorithmString() const { return algorithmTypeToString(algorithm()); }
+    int pathLength() const { return path().size(); }
+    int turnCount() const;                              // 路径上方向改变的次数
+    qint64 calculationTime() const;
+    QDateTime timestamp() const;                        // 由单调时钟换算为墙上时间
+    qint64 steadyTimestampNs() const;
     
-    // Setter方法
-    void setId(const QString& id) { m_id = id; }
-    void setStartPoint(const QPoint& point) { m_startPoint = point; }
-    void setEndPoint(const QPoint& point) { m_endPoint = point; }
-    void setPath(const QVector<QPoint>& path) { m_path = path; }
-    void setAlgorithm(AlgorithmType algorithm) { m_algorithm = algorithm; }
-    void setCalculationTime(qint64 time) { m_calculationTime = time; }
-    void setTimestamp(const QDateTime& timestamp) { m_timestamp = timestamp; }
+    // 元数据Setter；路径、起终点和算法在构造后不可修改
+    void setId(const QString& id);
+    void setTimestamp(const QDateTime& timestamp);
+    void setUuid(const QString& uuid);
     
     // 验证路径是否有效
     bool isValid() const;
@@ -45,13 +61,9 @@ public:
     QString toString() const;
 
 private:
-    QString m_id;
-    QPoint m_startPoint;
-    QPoint m_endPoint;
-    QVector<QPoint> m_path;
-    AlgorithmType m_algorithm;
-    qint64 m_calculationTime;  // 毫秒
-    QDateTime m_timestamp;
+    QSharedDataPointer<PathResultData> d;
 };
 
+Q_DECLARE_METATYPE(PathResult)
+
 #endif // PATHRESULT_H
@@ -1,11 +1,14 @@
 #include "ResultListWidget.h"
+#include "Log.h"
 #include <QHeaderView>
 #include <QMessageBox>
+#include <QScrollBar>
 #include <QStandardItem>
 #include <QDebug>
 
 ResultListWidget::ResultListWidget(QWidget* parent)
     : QWidget(parent)
+    , m_canFetchMore(false)
 {
     setupUI();
     setupConnections();
@@ -36,7 +39,7 @@ void ResultListWidget::setupTable() {
     
     // 设置表头
     QStringList headers;
-    headers << "序号" << "算法" << "起点" << "终点" << "步数" << "路径可视化" << "耗时" << "时间";
+    headers << "序号" << "算法" << "起点" << "终点" << "步数" << "转弯" << "路径可视化" << "耗时" << "时间";
     m_model->setHorizontalHeaderLabels(headers);
     
     // 创建表格视图
@@ -78,6 +81,7 @@ void ResultListWidget::setupTable() {
     header->resizeSection(COL_START_POINT, 90);  // 起点 - 固定宽度
     header->resizeSection(COL_END_POINT, 90);    // 终点 - 固定宽度
     header->resizeSection(COL_PATH_LENGTH, 80);  // 步数 - 固定宽度
+    header->resizeSection(COL_TURNS, 60);        // 转弯 - 固定宽度
     header->resizeSection(COL_PATH_VISUAL, 150); // 路径可视化 - 较宽
     header->resizeSection(COL_CALC_TIME, 100);   // 耗时 - 固定宽度
     // 时间戳列会自动拉伸填满剩余空间
@@ -88,6 +92,7 @@ void ResultListWidget::setupTable() {
     header->setSectionResizeMode(COL_START_POINT, QHeaderView::Interactive); // 起点可调整
     header->setSectionResizeMode(COL_END_POINT, QHeaderView::Interactive);   // 终点可调整
     header->setSectionResizeMode(COL_PATH_LENGTH, QHeaderView::Interactive); // 步数可调整
+    header->setSectionResizeMode(COL_TURNS, QHeaderView::Interactive);       // 转弯可调整
     header->setSectionResizeMode(COL_PATH_VISUAL, QHeaderView::Interactive); // 路径可视化可调整
     header->setSectionResizeMode(COL_CALC_TIME, QHeaderView::Interactive);   // 耗时可调整
     header->setSectionResizeMode(COL_TIMESTAMP, QHeaderView::Stretch);       // 时间戳拉伸填满
@@ -112,6 +117,16 @@ void ResultListWidget::setupTable() {
     // 监听表格视口大小变化，自动调整列宽
     connect(m_tableView->horizontalHeader(), &QHeaderView::geometriesChanged,
             this, &ResultListWidget::resizeColumnsToContents);
+    
+    // 用户滚动到底部时请求下一页；actionTriggered只在用户操作时发出，新行自动滚到底部不会触发
+    // 一页不满一屏时没有滚动范围，由“加载更多”按钮请求
+    connect(m_tableView->verticalScrollBar(), &QScrollBar::actionTriggered,
+            this, [this](int) {
+                QScrollBar* bar = m_tableView->verticalScrollBar();
+                if (bar->sliderPosition() >= bar->maximum()) {
+                    requestMore();
+                }
+            });
 }
 
 void ResultListWidget::setupButtons() {
@@ -126,8 +141,12 @@ void ResultListWidget::setupButtons() {
     m_clearButton = new QPushButton("清空全部");
     m_clearButton->setIcon(style()->standardIcon(QStyle::SP_DialogResetButton));
     
+    m_loadMoreButton = new QPushButton("加载更多");
+    m_loadMoreButton->setIcon(style()->standardIcon(QStyle::SP_ArrowDown));
+    
     m_buttonLayout->addWidget(m_deleteButton);
     m_buttonLayout->addWidget(m_exportButton);
+    m_buttonLayout->addWidget(m_loadMoreButton);
     m_buttonLayout->addStretch();
     m_buttonLayout->addWidget(m_clearButton);
     
@@ -164,6 +183,8 @@ void ResultListWidget::setupConnections() {
             this, &ResultListWidget::onExportResults);
     connect(m_clearButton, &QPushButton::clicked,
             this, &ResultListWidget::onClearAll);
+    connect(m_loadMoreButton, &QPushButton::clicked,
+            this, &ResultListWidget::requestMore);
     
     // 右键菜单事件
     connect(m_showPathAction, &QAction::triggered,
@@ -185,12 +206,12 @@ void ResultListWidget::addResult(const PathResult& result) {
     m_model->insertRow(row);
     updateResultRow(row, result);
     
-    // 调试输出 - 添加详细信息
-    qDebug() << "添加结果到第" << row << "行，算法:" << result.algorithmString() 
-             << "，路径长度:" << result.pathLength() << "，总行数:" << m_model->rowCount();
+    // 调试输出 - 每条结果一次，限速
+    QW_TRACE_RATE(lcUi, 10) << "添加结果到第" << row << "行，算法:" << result.algorithmString()
+                            << "，路径长度:" << result.pathLength() << "，总行数:" << m_model->rowCount();
     
     // 更新状态标签
-    m_statusLabel->setText(QString("计算结果: %1 条记录").arg(m_results.size()));
+    updateStatusLabel();
     updateButtonStates();
     
     // 滚动到新添加的行
@@ -203,7 +224,8 @@ void ResultListWidget::addResult(const PathResult& result) {
 void ResultListWidget::clearResults() {
     m_results.clear();
     m_model->setRowCount(0);
-    m_statusLabel->setText("计算结果: 0 条记录");
+    m_canFetchMore = false;
+    updateStatusLabel();
     updateButtonStates();
     
     // 发出结果变化信号
@@ -232,7 +254,8 @@ void ResultListWidget::recreateTable() {
     setupTable();
     
     // 更新状态
-    m_statusLabel->setText("计算结果: 0 条记录");
+    m_canFetchMore = false;
+    updateStatusLabel();
     updateButtonStates();
     
     // 强制刷新界面
@@ -267,7 +290,7 @@ void ResultListWidget::removeSelectedResults() {
         }
     }
     
-    m_statusLabel->setText(QString("计算结果: %1 条记录").arg(m_results.size()));
+    updateStatusLabel();
     updateButtonStates();
 }
 
@@ -313,7 +336,7 @@ void ResultListWidget::setResults(const QVector<PathResult>& results) {
         updateResultRow(i, results[i]);
     }
     
-    m_statusLabel->setText(QString("计算结果: %1 条记录").arg(results.size()));
+    updateStatusLabel();
     updateButtonStates();
     resizeColumnsToContents(); // 自动调整列宽
 }
@@ -330,7 +353,7 @@ void ResultListWidget::addBatchResults(const QVector<PathResult>& results) {
     }
     
     // 更新状态标签
-    m_statusLabel->setText(QString("计算结果: %1 条记录").arg(m_results.size()));
+    updateStatusLabel();
     updateButtonStates();
     
     // 滚动到新添加的行
@@ -339,12 +362,36 @@ void ResultListWidget::addBatchResults(const QVector<PathResult>& results) {
     // 每批次添加后调整列宽
     resizeColumnsToContents();
     
-    qDebug() << "批量添加" << results.size() << "条结果，总数:" << m_results.size();
+    QW_DEBUG(lcUi) << "批量添加" << results.size() << "条结果，总数:" << m_results.size();
     
     // 发出结果变化信号
     emit resultsChanged();
 }
 
+void ResultListWidget::setCanFetchMore(bool canFetchMore) {
+    m_canFetchMore = canFetchMore;
+    updateStatusLabel();
+    updateButtonStates();
+}
+
+void ResultListWidget::requestMore() {
+    if (!m_canFetchMore) {
+        return;
+    }
+    m_canFetchMore = false;     // 这一页到达前不重复请求
+    updateStatusLabel();
+    updateButtonStates();
+    emit fetchMoreRequested();
+}
+
+void ResultListWidget::updateStatusLabel() {
+    QString text = QString("计算结果: %1 条记录").arg(m_results.size());
+    if (m_canFetchMore) {
+        text += "（滚动到底部或点击“加载更多”继续）";
+    }
+    m_statusLabel->setText(text);
+}
+
 void ResultListWidget::resizeColumnsToContents() {
     if (!m_tableView || !m_model) return;
     
@@ -365,31 +412,34 @@ void ResultListWidget::resizeColumnsToContents() {
         // 为可调整列分配剩余宽度
         int remainingWidth = totalWidth - fixedWidth;
         if (remainingWidth > 0) {
-            // 按比例分配剩余宽度：起点12%，终点12%，步数10%，路径可视化30%，耗时16%，时间戳20%
+            // 按比例分配剩余宽度：起点12%，终点12%，步数10%，转弯7%，路径可视化23%，耗时16%，时间戳20%
             int startWidth = qMax(80, remainingWidth * 12 / 100);
             int endWidth = qMax(80, remainingWidth * 12 / 100);
             int lengthWidth = qMax(70, remainingWidth * 10 / 100);
-            int visualWidth = qMax(120, remainingWidth * 30 / 100);
+            int turnsWidth = qMax(50, remainingWidth * 7 / 100);
+            int visualWidth = qMax(120, remainingWidth * 23 / 100);
             int timeWidth = qMax(90, remainingWidth * 16 / 100);
             int timestampWidth = qMax(80, remainingWidth * 20 / 100);
             
             // 确保总宽度不超过可用宽度
-            int allocatedWidth = startWidth + endWidth + lengthWidth + visualWidth + timeWidth + timestampWidth;
+            int allocatedWidth = startWidth + endWidth + lengthWidth + turnsWidth + visualWidth + timeWidth + timestampWidth;
             if (allocatedWidth > remainingWidth) {
                 // 按比例缩减
                 double scale = (double)remainingWidth / allocatedWidth;
                 startWidth = (int)(startWidth * scale);
                 endWidth = (int)(endWidth * scale);
                 lengthWidth = (int)(lengthWidth * scale);
+                turnsWidth = (int)(turnsWidth * scale);
                 visualWidth = (int)(visualWidth * scale);
                 timeWidth = (int)(timeWidth * scale);
-                timestampWidth = remainingWidth - startWidth - endWidth - lengthWidth - visualWidth - timeWidth;
+                timestampWidth = remainingWidth - startWidth - endWidth - lengthWidth - turnsWidth - visualWidth - timeWidth;
             }
             
             // 应用计算的宽度
             header->resizeSection(COL_START_POINT, startWidth);
             header->resizeSection(COL_END_POINT, endWidth);
             header->resizeSection(COL_PATH_LENGTH, lengthWidth);
+            header->resizeSection(COL_TURNS, turnsWidth);
             header->resizeSection(COL_PATH_VISUAL, visualWidth);
             header->resizeSection(COL_CALC_TIME, timeWidth);
             header->resizeSection(COL_TIMESTAMP, timestampWidth);
@@ -408,8 +458,8 @@ void ResultListWidget::updateResultRow(int row, const PathResult& result) {
     indexItem->setTextAlignment(Qt::AlignCenter);
     m_model->setItem(row, COL_INDEX, indexItem);
     
-    // 算法名称（固定为DFS）
-    QStandardItem* algoItem = new QStandardItem("DFS");
+    // 算法名称
+    QStandardItem* algoItem = new QStandardItem(result.algorithmString());
     algoItem->setFlags(algoItem->flags() & ~Qt::ItemIsEditable);
     algoItem->setTextAlignment(Qt::AlignCenter);
     algoItem->setBackground(QColor(255, 255, 230)); // 浅黄色
@@ -436,6 +486,13 @@ void ResultListWidget::updateResultRow(int row, const PathResult& result) {
     lengthItem->setTextAlignment(Qt::AlignCenter);
     m_model->setItem(row, COL_PATH_LENGTH, lengthItem);
     
+    // 转弯次数，按数值排序
+    QStandardItem* turnsItem = new QStandardItem();
+    turnsItem->setData(result.turnCount(), Qt::DisplayRole);
+    turnsItem->setFlags(turnsItem->flags() & ~Qt::ItemIsEditable);
+    turnsItem->setTextAlignment(Qt::AlignCenter);
+    m_model->setItem(row, COL_TURNS, turnsItem);
+    
     // 路径可视化
     PathVisualWidget* pathWidget = new PathVisualWidget(m_tableView);
     pathWidget->setPath(result.path());
@@ -471,6 +528,7 @@ void ResultListWidget::updateButtonStates() {
     m_deleteButton->setEnabled(hasSelection);
     m_exportButton->setEnabled(hasResults);
     m_clearButton->setEnabled(hasResults);
+    m_loadMoreButton->setEnabled(m_canFetchMore);
     
     if (m_showPathAction) m_showPathAction->setEnabled(hasSelection);
     if (m_deleteAction) m_deleteAction->setEnabled(hasSelection);
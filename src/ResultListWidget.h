@@ -41,6 +41,11 @@ public:
     
     // 调整列宽自适应
     void resizeColumnsToContents();
+    
+    // 还有下一页结果可取时，用户滚动到底部或点击“加载更多”发出fetchMoreRequested；
+    // 发出后自动置为false，清空结果时也置为false
+    void setCanFetchMore(bool canFetchMore);
+    bool canFetchMore() const { return m_canFetchMore; }
 
 protected:
     // 重写窗口大小变化事件
@@ -52,6 +57,7 @@ signals:
     void deleteSelectedResults();
     void exportResults();
     void resultsChanged(); // 新增：当结果数据发生变化时发出
+    void fetchMoreRequested();  // 滚动到底部或点击“加载更多”，且还有下一页
 
 private slots:
     void onItemDoubleClicked(int row, int column);
@@ -60,6 +66,7 @@ private slots:
     void onDeleteSelected();
     void onExportResults();
     void onClearAll();
+    void requestMore();         // 还有下一页时发出fetchMoreRequested
 
 private:
     void setupUI();
@@ -69,6 +76,7 @@ private:
     void setupConnections();
     void updateResultRow(int row, const PathResult& result);
     void updateButtonStates();
+    void updateStatusLabel();
     
     QVBoxLayout* m_mainLayout;
     QTableView* m_tableView;
@@ -79,6 +87,7 @@ private:
     QPushButton* m_deleteButton;
     QPushButton* m_exportButton;
     QPushButton* m_clearButton;
+    QPushButton* m_loadMoreButton;
     
     // 状态标签
     QLabel* m_statusLabel;
@@ -91,6 +100,7 @@ private:
     
     // 数据存储
     QVector<PathResult> m_results;
+    bool m_canFetchMore;
     
     // 表格列定义
     enum TableColumns {
@@ -99,6 +109,7 @@ private:
         COL_START_POINT,    // 起点
         COL_END_POINT,      // 终点
         COL_PATH_LENGTH,    // 步数
+        COL_TURNS,          // 转弯
         COL_PATH_VISUAL,    // 路径可视化
         COL_CALC_TIME,      // 耗时
         COL_TIMESTAMP,      // 时间
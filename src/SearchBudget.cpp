@@ -0,0 +1,51 @@
+#include "SearchBudget.h"
+
+BudgetMeter::BudgetMeter(const SearchBudget& budget)
+    : m_budget(budget)
+    , m_memoryBytes(0)
+    , m_exhausted(None)
+{
+}
+
+void BudgetMeter::start() {
+    m_timer.start();
+    m_memoryBytes = 0;
+    m_exhausted = None;
+}
+
+void BudgetMeter::addPath(const QVector<QPoint>& path) {
+    // 点数组加上容器头部的粗略开销
+    m_memoryBytes += static_cast<qint64>(path.size()) * static_cast<qint64>(sizeof(QPoint)) + 64;
+}
+
+bool BudgetMeter::withinBudget(quint64 nodes) {
+    if (m_exhausted != None) {
+        return false;
+    }
+    if (m_budget.maxNodes > 0 && nodes >= m_budget.maxNodes) {
+        m_exhausted = Nodes;
+    } else if (m_budget.maxMillis > 0 && elapsedMs() >= m_budget.maxMillis) {
+        m_exhausted = Time;
+    } else if (m_budget.maxMemoryBytes > 0 && m_memoryBytes >= m_budget.maxMemoryBytes) {
+        m_exhausted = Memory;
+    }
+    return m_exhausted == None;
+}
+
+QString BudgetMeter::resourceToString(Resource resource) {
+    switch (resource) {
+        case Nodes: return "nodes";
+        case Time: return "time";
+        case Memory: return "memory";
+        default: return "none";
+    }
+}
+
+QString BudgetMeter::resourceDisplayName(Resource resource) {
+    switch (resource) {
+        case Nodes: return "节点";
+        case Time: return "时间";
+        case Memory: return "内存";
+        default: return "无";
+    }
+}
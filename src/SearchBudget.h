@@ -0,0 +1,56 @@
+#ifndef SEARCHBUDGET_H
+#define SEARCHBUDGET_H
+
+#include <QElapsedTimer>
+#include <QPoint>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+// 单个任务的资源预算，任一项用完任务即正常结束并保留已有结果；各项为0表示不限
+// 内存按已产出结果占用的内存估算：搜索本身只占与格子数成正比的固定内存，
+// 随运行时间增长的是结果队列中的路径
+struct SearchBudget {
+    quint64 maxNodes;           // 扩展节点数
+    qint64 maxMillis;           // 耗时
+    qint64 maxMemoryBytes;      // 结果占用的内存
+
+    SearchBudget() : maxNodes(0), maxMillis(0), maxMemoryBytes(0) {}
+    bool isUnlimited() const { return maxNodes == 0 && maxMillis == 0 && maxMemoryBytes == 0; }
+};
+
+// 预算计量：任务开始时start()，每产出一条路径addPath()，在检查点上调用withinBudget()
+// 记录最先用完的一项；不加锁，只在调用检查点和结果回调的线程中使用
+class BudgetMeter {
+public:
+    enum Resource {
+        None,       // 尚未用完
+        Nodes,
+        Time,
+        Memory
+    };
+
+    explicit BudgetMeter(const SearchBudget& budget = SearchBudget());
+
+    void start();
+    void addPath(const QVector<QPoint>& path);
+    // nodes为目前为止扩展的节点总数；返回false表示某项预算已用完
+    bool withinBudget(quint64 nodes);
+
+    const SearchBudget& budget() const { return m_budget; }
+    bool isExhausted() const { return m_exhausted != None; }
+    Resource exhausted() const { return m_exhausted; }
+    qint64 elapsedMs() const { return m_timer.isValid() ? m_timer.elapsed() : 0; }
+    qint64 memoryBytes() const { return m_memoryBytes; }
+
+    static QString resourceToString(Resource resource);     // 用于JSON："nodes"/"time"/"memory"
+    static QString resourceDisplayName(Resource resource);  // 用于界面
+
+private:
+    SearchBudget m_budget;
+    QElapsedTimer m_timer;
+    qint64 m_memoryBytes;
+    Resource m_exhausted;
+};
+
+#endif // SEARCHBUDGET_H
@@ -0,0 +1,123 @@
+#include "SearchStats.h"
+#include <chrono>
+
+SearchStats::Snapshot::Snapshot()
+    : nodes(0)
+    , backtracks(0)
+    , paths(0)
+    , maxDepth(0)
+    , depthLimit(0)
+    , elapsedMs(0)
+    , running(false)
+{
+    for (int i = 0; i < PruneReasonCount; ++i) prunes[i] = 0;
+    for (int i = 0; i < DEPTH_BUCKETS; ++i) depthHistogram[i] = 0;
+}
+
+quint64 SearchStats::Snapshot::totalPrunes() const {
+    quint64 total = 0;
+    for (int i = 0; i < PruneReasonCount; ++i) {
+        total += prunes[i];
+    }
+    return total;
+}
+
+double SearchStats::Snapshot::nodesPerSecond() const {
+    return elapsedMs > 0 ? nodes * 1000.0 / elapsedMs : 0.0;
+}
+
+QString SearchStats::Snapshot::summary() const {
+    return QString("节点 %1 | %2 节点/秒 | 剪枝 %3 | 回溯 %4 | 最大深度 %5/%6 | %7 s")
+        .arg(nodes)
+        .arg(nodesPerSecond(), 0, 'f', 0)
+        .arg(totalPrunes())
+        .arg(backtracks)
+        .arg(maxDepth)
+        .arg(depthLimit)
+        .arg(elapsedMs / 1000.0, 0, 'f', 1);
+}
+
+QString SearchStats::Snapshot::histogramText() const {
+    // 按最大桶归一化为8级方块
+    static const QChar levels[] = {
+        QChar(0x2581), QChar(0x2582), QChar(0x2583), QChar(0x2584),
+        QChar(0x2585), QChar(0x2586), QChar(0x2587), QChar(0x2588)
+    };
+    quint64 peak = 0;
+    for (int i = 0; i < DEPTH_BUCKETS; ++i) {
+        peak = qMax(peak, depthHistogram[i]);
+    }
+    QString text;
+    for (int i = 0; i < DEPTH_BUCKETS; ++i) {
+        if (depthHistogram[i] == 0) {
+            text += QChar(' ');
+        } else {
+            text += levels[static_cast<int>(depthHistogram[i] * 7 / peak)];
+        }
+    }
+    return text;
+}
+
+SearchStats::SearchStats()
+    : m_nodes(0)
+    , m_backtracks(0)
+    , m_paths(0)
+    , m_maxDepth(0)
+    , m_depthLimit(0)
+    , m_startMs(0)
+    , m_endMs(0)
+{
+    for (int i = 0; i < PruneReasonCount; ++i) m_prunes[i] = 0;
+    for (int i = 0; i < DEPTH_BUCKETS; ++i) m_depthHistogram[i] = 0;
+}
+
+qint64 SearchStats::nowMs() {
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void SearchStats::reset(int depthLimit) {
+    m_nodes = 0;
+    m_backtracks = 0;
+    m_paths = 0;
+    m_maxDepth = 0;
+    m_depthLimit = depthLimit;
+    for (int i = 0; i < PruneReasonCount; ++i) m_prunes[i] = 0;
+    for (int i = 0; i < DEPTH_BUCKETS; ++i) m_depthHistogram[i] = 0;
+    m_endMs = 0;
+    m_startMs = nowMs();
+}
+
+void SearchStats::finish() {
+    m_endMs = nowMs();
+}
+
+void SearchStats::updateMaxDepth(int depth) {
+    int current = m_maxDepth.load(std::memory_order_relaxed);
+    while (depth > current &&
+           !m_maxDepth.compare_exchange_weak(current, depth, std::memory_order_relaxed)) {
+    }
+}
+
+SearchStats::Snapshot SearchStats::snapshot() const {
+    Snapshot snap;
+    snap.nodes = m_nodes.load(std::memory_order_relaxed);
+    snap.backtracks = m_backtracks.load(std::memory_order_relaxed);
+    for (int i = 0; i < PruneReasonCount; ++i) {
+        snap.prunes[i] = m_prunes[i].load(std::memory_order_relaxed);
+    }
+    snap.paths = m_paths.load(std::memory_order_relaxed);
+    snap.maxDepth = m_maxDepth.load(std::memory_order_relaxed);
+    snap.depthLimit = m_depthLimit.load(std::memory_order_relaxed);
+    for (int i = 0; i < DEPTH_BUCKETS; ++i) {
+        snap.depthHistogram[i] = m_depthHistogram[i].load(std::memory_order_relaxed);
+    }
+
+    const qint64 start = m_startMs.load();
+    const qint64 end = m_endMs.load();
+    snap.running = start != 0 && end == 0;
+    if (start != 0) {
+        snap.elapsedMs = (end != 0 ? end : nowMs()) - start;
+    }
+    return snap;
+}
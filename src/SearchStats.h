@@ -0,0 +1,82 @@
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+// 搜索统计：由搜索线程写入，界面线程随时读取快照
+// 所有计数器都是原子量，无锁；引擎先在本地累计，按检查点间隔批量写入，热路径上没有原子操作
+class SearchStats {
+public:
+    enum PruneReason {
+        PruneParity,            // 奇偶性
+        PruneDeadEnd,           // 死角
+        PruneConnectivity,      // 连通性
+        PruneBound,             // 分支定界：下界不优于当前最优
+        PruneReasonCount
+    };
+
+    // 深度直方图的分桶数，深度按 [0, depthLimit] 均匀分桶
+    static const int DEPTH_BUCKETS = 32;
+
+    // 某一时刻的统计值，可自由复制
+    struct Snapshot {
+        quint64 nodes;
+        quint64 backtracks;
+        quint64 prunes[PruneReasonCount];
+        quint64 paths;
+        int maxDepth;
+        int depthLimit;
+        quint64 depthHistogram[DEPTH_BUCKETS];
+        qint64 elapsedMs;
+        bool running;
+
+        Snapshot();
+        quint64 totalPrunes() const;
+        double nodesPerSecond() const;
+        QString summary() const;            // 单行摘要，用于状态栏
+        QString histogramText() const;      // 用方块字符绘制的深度分布
+    };
+
+    SearchStats();
+
+    // 开始新任务时清零；depthLimit为可能的最大深度（通常是可通行格子数）
+    void reset(int depthLimit);
+    void finish();
+
+    int depthBucket(int depth) const {
+        const int limit = m_depthLimit.load(std::memory_order_relaxed);
+        if (depth <= 0 || limit <= 0) return 0;
+        if (depth >= limit) return DEPTH_BUCKETS - 1;
+        return static_cast<int>(static_cast<qint64>(depth) * DEPTH_BUCKETS / (limit + 1));
+    }
+
+    void addNodes(quint64 count) { m_nodes.fetch_add(count, std::memory_order_relaxed); }
+    void addBacktracks(quint64 count) { m_backtracks.fetch_add(count, std::memory_order_relaxed); }
+    void addPrunes(PruneReason reason, quint64 count) {
+        m_prunes[reason].fetch_add(count, std::memory_order_relaxed);
+    }
+    void addPaths(quint64 count) { m_paths.fetch_add(count, std::memory_order_relaxed); }
+    void addDepthSamples(int bucket, quint64 count) {
+        m_depthHistogram[bucket].fetch_add(count, std::memory_order_relaxed);
+    }
+    void updateMaxDepth(int depth);
+
+    Snapshot snapshot() const;
+
+private:
+    static qint64 nowMs();
+
+    std::atomic<quint64> m_nodes;
+    std::atomic<quint64> m_backtracks;
+    std::atomic<quint64> m_prunes[PruneReasonCount];
+    std::atomic<quint64> m_paths;
+    std::atomic<int> m_maxDepth;
+    std::atomic<int> m_depthLimit;
+    std::atomic<quint64> m_depthHistogram[DEPTH_BUCKETS];
+    std::atomic<qint64> m_startMs;
+    std::atomic<qint64> m_endMs;       // 0表示仍在运行
+};
+
+#endif // SEARCHSTATS_H
@@ -0,0 +1,197 @@
+#include "ShortestPathDag.h"
+#include <algorithm>
+
+template<class Neighborhood>
+BasicShortestPathDag<Neighborhood>::BasicShortestPathDag(const GridModel& grid)
+    : m_width(grid.width())
+    , m_height(grid.height())
+    , m_distance(-1)
+    , m_source(-1)
+    , m_target(-1)
+    , m_expandedNodes(0)
+{
+    m_walkable.resize(grid.cellCount());
+    for (int i = 0; i < grid.cellCount(); ++i) {
+        m_walkable[i] = grid.isWalkable(i);
+    }
+}
+
+template<class Neighborhood>
+void BasicShortestPathDag<Neighborhood>::bfs(int source, QVector<int>& dist) {
+    dist.fill(-1, m_width * m_height);
+    QVector<int> queue;
+    queue.reserve(m_width * m_height);
+    dist[source] = 0;
+    queue.append(source);
+
+    int adjacent[Neighborhood::MaxDegree];
+    for (int head = 0; head < queue.size(); ++head) {
+        const int current = queue[head];
+        ++m_expandedNodes;
+        const int count = neighbors(current, adjacent);
+        for (int i = 0; i < count; ++i) {
+            if (dist[adjacent[i]] < 0) {
+                dist[adjacent[i]] = dist[current] + 1;
+                queue.append(adjacent[i]);
+            }
+        }
+    }
+}
+
+template<class Neighborhood>
+bool BasicShortestPathDag<Neighborhood>::build(const QPoint& start, const QPoint& end) {
+    m_distance = -1;
+    m_source = m_target = -1;
+    m_dagNodes.clear();
+    m_successorOffset.clear();
+    m_successors.clear();
+    m_pathCount = BigCount();
+    m_expandedNodes = 0;
+
+    if (!inGrid(start) || !inGrid(end) || !m_walkable[index(start)] || !m_walkable[index(end)]) {
+        return false;
+    }
+
+    QVector<int> fromStart;
+    QVector<int> toEnd;
+    bfs(index(start), fromStart);
+    const int distance = fromStart[index(end)];
+    if (distance < 0) {
+        return false;
+    }
+    bfs(index(end), toEnd);
+
+    // 满足 d(s,v) + d(v,t) == D 的格子位于某条最短路径上，按层（d(s,v)）排列
+    QVector<int> layerSize(distance + 2, 0);
+    const int cellCount = m_width * m_height;
+    for (int cell = 0; cell < cellCount; ++cell) {
+        if (fromStart[cell] >= 0 && toEnd[cell] >= 0 && fromStart[cell] + toEnd[cell] == distance) {
+            layerSize[fromStart[cell] + 1]++;
+        }
+    }
+    for (int layer = 1; layer < layerSize.size(); ++layer) {
+        layerSize[layer] += layerSize[layer - 1];
+    }
+
+    QVector<int> dagIndex(cellCount, -1);
+    m_dagNodes.resize(layerSize.last());
+    for (int cell = 0; cell < cellCount; ++cell) {
+        if (fromStart[cell] >= 0 && toEnd[cell] >= 0 && fromStart[cell] + toEnd[cell] == distance) {
+            const int slot = layerSize[fromStart[cell]]++;
+            m_dagNodes[slot] = cell;
+            dagIndex[cell] = slot;
+        }
+    }
+
+    // 边只连向下一层
+    m_successorOffset.resize(m_dagNodes.size() + 1);
+    int adjacent[Neighborhood::MaxDegree];
+    for (int node = 0; node < m_dagNodes.size(); ++node) {
+        m_successorOffset[node] = m_successors.size();
+        const int cell = m_dagNodes[node];
+        const int count = neighbors(cell, adjacent);
+        for (int i = 0; i < count; ++i) {
+            const int next = dagIndex[adjacent[i]];
+            if (next >= 0 && fromStart[adjacent[i]] == fromStart[cell] + 1) {
+                m_successors.append(next);
+            }
+        }
+    }
+    m_successorOffset[m_dagNodes.size()] = m_successors.size();
+
+    m_distance = distance;
+    m_source = dagIndex[index(start)];
+    m_target = dagIndex[index(end)];
+
+    // 按层倒序累加：ways(v) = Σ ways(后继)，ways(终点) = 1
+    QVector<BigCount> ways(m_dagNodes.size());
+    ways[m_target] = BigCount(1);
+    for (int node = m_dagNodes.size() - 1; node >= 0; --node) {
+        if (node == m_target) continue;
+        for (int e = m_successorOffset[node]; e < m_successorOffset[node + 1]; ++e) {
+            ways[node] += ways[m_successors[e]];
+        }
+    }
+    m_pathCount = ways[m_source];
+    return true;
+}
+
+template<class Neighborhood>
+int BasicShortestPathDag<Neighborhood>::enumerate(int maxPaths, const PathCallback& onPath) const {
+    Enumerator enumerator = enumerate();
+    QVector<QPoint> path;
+    int produced = 0;
+    while (produced < maxPaths && enumerator.next(path)) {
+        ++produced;
+        if (!onPath(path)) {
+            break;
+        }
+    }
+    return produced;
+}
+
+template<class Neighborhood>
+BasicShortestPathDag<Neighborhood>::Enumerator::Enumerator(const BasicShortestPathDag* dag)
+    : m_dag(dag)
+    , m_started(false)
+{
+}
+
+template<class Neighborhood>
+void BasicShortestPathDag<Neighborhood>::Enumerator::descend() {
+    // DAG中每个节点都能到达终点，沿第一个后继一直走下去必然到达终点
+    int node = m_nodes.last();
+    while (node != m_dag->m_target) {
+        node = m_dag->m_successors[m_dag->m_successorOffset[node]];
+        m_nodes.append(node);
+        m_choices.append(0);
+    }
+}
+
+template<class Neighborhood>
+bool BasicShortestPathDag<Neighborhood>::Enumerator::next(QVector<QPoint>& path) {
+    // 已经取完时栈为空，再次调用仍返回false
+    if (!m_dag->isValid() || (m_started && m_nodes.isEmpty())) {
+        return false;
+    }
+
+    if (!m_started) {
+        m_started = true;
+        m_nodes.reserve(m_dag->m_distance + 1);
+        m_choices.reserve(m_dag->m_distance + 1);
+        m_nodes.append(m_dag->m_source);
+        m_choices.append(0);
+        descend();
+    } else {
+        // 回溯到最近一个还有其他后继可选的节点
+        for (;;) {
+            m_nodes.removeLast();
+            m_choices.removeLast();
+            if (m_nodes.isEmpty()) {
+                return false;
+            }
+            const int node = m_nodes.last();
+            const int choice = ++m_choices.last();
+            const int offset = m_dag->m_successorOffset[node] + choice;
+            if (offset < m_dag->m_successorOffset[node + 1]) {
+                m_nodes.append(m_dag->m_successors[offset]);
+                m_choices.append(0);
+                descend();
+                break;
+            }
+        }
+    }
+
+    path.resize(m_nodes.size());
+    for (int i = 0; i < m_nodes.size(); ++i) {
+        path[i] = m_dag->toPoint(m_dag->m_dagNodes[m_nodes[i]]);
+    }
+    return true;
+}
+
+// 内置邻域策略的显式实例化；自定义邻域在这里追加一行
+template class BasicShortestPathDag<Neighborhoods::Four>;
+template class BasicShortestPathDag<Neighborhoods::EightAllowCornerCutting>;
+template class BasicShortestPathDag<Neighborhoods::EightNoCornerCutting>;
+template class BasicShortestPathDag<Neighborhoods::Hex>;
+template class BasicShortestPathDag<Neighborhoods::Knight>;
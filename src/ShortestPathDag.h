@@ -0,0 +1,83 @@
+#ifndef SHORTESTPATHDAG_H
+#define SHORTESTPATHDAG_H
+
+#include "GridModel.h"
+#include "Neighborhood.h"
+#include "BigCount.h"
+#include <QVector>
+#include <QPoint>
+#include <functional>
+
+// 最短路径DAG：由起点和终点两次BFS的层次构造
+// 只保留位于某条最短路径上的格子和边，DAG上的每条起点到终点的路径都是一条最短路径
+// 计数和枚举都只依赖DAG的大小，与最短路径的总数无关
+// 邻域策略是模板参数，每步计为1；ShortestPathDag 为四邻域版本
+template<class Neighborhood>
+class BasicShortestPathDag {
+public:
+    using PathCallback = std::function<bool(const QVector<QPoint>& path)>;
+
+    // 惰性枚举器：每次next()产出一条新的最短路径，不重复、不需要去重
+    // 状态为显式栈，每条路径摊还O(路径长度)
+    class Enumerator {
+    public:
+        // 取出下一条路径；取完后返回false，之后再调用也返回false
+        bool next(QVector<QPoint>& path);
+
+    private:
+        friend class BasicShortestPathDag;
+        explicit Enumerator(const BasicShortestPathDag* dag);
+        void descend();
+
+        const BasicShortestPathDag* m_dag;
+        QVector<int> m_nodes;       // 当前路径上的DAG节点
+        QVector<int> m_choices;     // 每个节点当前选择的后继序号
+        bool m_started;
+    };
+
+    explicit BasicShortestPathDag(const GridModel& grid);
+
+    // 构建DAG并统计最短路径数，起点终点不连通时返回false
+    bool build(const QPoint& start, const QPoint& end);
+
+    bool isValid() const { return m_distance >= 0; }
+    int distance() const { return m_distance; }          // 最短路径步数
+    int nodeCount() const { return m_dagNodes.size(); }
+    int edgeCount() const { return m_successors.size(); }
+    quint64 expandedNodes() const { return m_expandedNodes; }  // 构建时两次BFS出队的格子数
+    const BigCount& pathCount() const { return m_pathCount; }
+
+    Enumerator enumerate() const { return Enumerator(this); }
+    // 依次产出前maxPaths条最短路径，回调返回false提前结束，返回产出数量
+    int enumerate(int maxPaths, const PathCallback& onPath) const;
+
+private:
+    int index(const QPoint& p) const { return p.y() * m_width + p.x(); }
+    QPoint toPoint(int index) const { return QPoint(index % m_width, index / m_width); }
+    bool inGrid(const QPoint& p) const {
+        return p.x() >= 0 && p.x() < m_width && p.y() >= 0 && p.y() < m_height;
+    }
+    int neighbors(int index, int* out) const {
+        return Neighborhood::collect(m_width, m_height, m_walkable, index, out);
+    }
+    void bfs(int source, QVector<int>& dist);
+
+    int m_width;
+    int m_height;
+    QVector<bool> m_walkable;
+
+    int m_distance;
+    int m_source;   // DAG节点序号
+    int m_target;
+
+    // DAG按层排列，邻接表用CSR存储
+    QVector<int> m_dagNodes;            // DAG节点 -> 网格格子
+    QVector<int> m_successorOffset;     // 大小为节点数+1
+    QVector<int> m_successors;          // 后继的DAG节点序号
+    BigCount m_pathCount;
+    quint64 m_expandedNodes;
+};
+
+typedef BasicShortestPathDag<Neighborhoods::Four> ShortestPathDag;
+
+#endif // SHORTESTPATHDAG_H
@@ -0,0 +1,11 @@
+# 数据持久化（XML / SQLite / CSV），界面程序和命令行批处理共用
+
+QT += sql xml
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/DataManager.cpp
+
+HEADERS += \
+    $$PWD/DataManager.h
@@ -0,0 +1,37 @@
+# 引擎源文件：网格模型、搜索引擎和结果类型，只依赖QtCore
+# 与CMakeLists.txt中的qweight_engine目标保持一致
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/BigCount.cpp \
+    $$PWD/ConstructiveHamiltonianPath.cpp \
+    $$PWD/GridModel.cpp \
+    $$PWD/GridSnapshot.cpp \
+    $$PWD/GridTypes.cpp \
+    $$PWD/HamiltonianMeetInTheMiddle.cpp \
+    $$PWD/HamiltonianPathEngine.cpp \
+    $$PWD/HamiltonianPortfolio.cpp \
+    $$PWD/KShortestPathEngine.cpp \
+    $$PWD/Log.cpp \
+    $$PWD/PathResult.cpp \
+    $$PWD/SearchBudget.cpp \
+    $$PWD/SearchStats.cpp \
+    $$PWD/ShortestPathDag.cpp
+
+HEADERS += \
+    $$PWD/BigCount.h \
+    $$PWD/ConstructiveHamiltonianPath.h \
+    $$PWD/GridModel.h \
+    $$PWD/GridSnapshot.h \
+    $$PWD/GridTypes.h \
+    $$PWD/HamiltonianMeetInTheMiddle.h \
+    $$PWD/HamiltonianPathEngine.h \
+    $$PWD/HamiltonianPortfolio.h \
+    $$PWD/KShortestPathEngine.h \
+    $$PWD/Log.h \
+    $$PWD/Neighborhood.h \
+    $$PWD/PathResult.h \
+    $$PWD/SearchBudget.h \
+    $$PWD/SearchStats.h \
+    $$PWD/ShortestPathDag.h